@@ -0,0 +1,430 @@
+/***************************************************************************
+	LPC8xx.h
+	ホスト(Linux)ビルド用のLPC8xx定義
+
+	マイコン: LPC810(NXP Semiconductors)をホスト上で模擬する
+
+	CMSIS_CORE_LPC8xxのLPC8xx.hの代わりに、ホストビルド(host/Makefile)で
+	取り込まれるヘッダ。
+	ペリフェラルの構造体の型名とメンバ名は本物と同じにしてあるので、
+	src以下のソースはそのままコンパイルできる。
+
+	本物と異なるのは以下の点である。
+
+	・LPC_SYSCONなどのペリフェラルは固定番地ではなく、関数(Sim_syscon
+	　など)の戻り値としている。関数が呼ばれる度に、レジスタモデル(sim.c)
+	　がアクセス回数を数え、時間を進めて、PLLのロックやUENの反映、WDTの
+	　カウントダウンなどを模擬する。
+	・読み出し専用(__I)のレジスタもモデルから書けるよう、すべて__IOとし
+	　ている。
+	・CMSISの組み込み関数(__NOP, __WFI, __disable_irqなど)とNVIC関数、
+	　SysTick_Configもモデルの関数で置き換えている。
+
+	アクセス回数はペリフェラルの参照(LPC_xxx->)1回を1回と数える。
+	|=のような読み書きも1回である。
+	ポインタを取り出して読む場合(Sys_waitRegなど)は数えられない。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: LPC_PIN_INT追加
+	2026.10.16: mits: LPC_USART0追加
+	2026.10.16: mits: LPC_MRT追加
+	2026.10.16: mits: LPC_FLASHCTRL追加
+	2026.10.16: mits: LPC_SCT追加
+	2026.10.16: mits: __BKPT追加
+***************************************************************************/
+#ifndef	LPC8XX_H
+#define	LPC8XX_H
+
+#include	<stdint.h>
+
+/***************************************************************************
+	CMSIS互換の修飾子
+***************************************************************************/
+#define	__I		volatile
+#define	__O		volatile
+#define	__IO	volatile
+#define	__ASM(...)				/* ホストではアセンブラは使わない */
+#define	__INLINE		inline
+#define	__STATIC_INLINE	static inline
+
+/***************************************************************************
+	割り込み番号
+***************************************************************************/
+typedef enum IRQn {
+	NonMaskableInt_IRQn	= -14,
+	HardFault_IRQn		= -13,
+	SVCall_IRQn			= -5,
+	PendSV_IRQn			= -2,
+	SysTick_IRQn		= -1,
+	SPI0_IRQn			= 0,
+	SPI1_IRQn			= 1,
+	UART0_IRQn			= 3,
+	UART1_IRQn			= 4,
+	UART2_IRQn			= 5,
+	I2C_IRQn			= 8,
+	SCT_IRQn			= 9,
+	MRT_IRQn			= 10,
+	CMP_IRQn			= 11,
+	WDT_IRQn			= 12,
+	BOD_IRQn			= 13,
+	WKT_IRQn			= 15,
+	PININT0_IRQn		= 24,
+	PININT1_IRQn		= 25,
+	PININT2_IRQn		= 26,
+	PININT3_IRQn		= 27,
+	PININT4_IRQn		= 28,
+	PININT5_IRQn		= 29,
+	PININT6_IRQn		= 30,
+	PININT7_IRQn		= 31
+} IRQn_Type;
+
+/***************************************************************************
+	ペリフェラルのレジスタ構造体(本物と同じ並び)
+***************************************************************************/
+
+/*** SYSCON ***/
+typedef struct {
+	__IO uint32_t	SYSMEMREMAP;
+	__IO uint32_t	PRESETCTRL;
+	__IO uint32_t	SYSPLLCTRL;
+	__IO uint32_t	SYSPLLSTAT;
+	uint32_t		RESERVED0[4];
+	__IO uint32_t	SYSOSCCTRL;
+	__IO uint32_t	WDTOSCCTRL;
+	uint32_t		RESERVED1[2];
+	__IO uint32_t	SYSRSTSTAT;
+	uint32_t		RESERVED2;
+	__IO uint32_t	SYSPLLCLKSEL;
+	__IO uint32_t	SYSPLLCLKUEN;
+	uint32_t		RESERVED3[10];
+	__IO uint32_t	MAINCLKSEL;
+	__IO uint32_t	MAINCLKUEN;
+	__IO uint32_t	SYSAHBCLKDIV;
+	uint32_t		RESERVED4;
+	__IO uint32_t	SYSAHBCLKCTRL;
+	uint32_t		RESERVED5[4];
+	__IO uint32_t	UARTCLKDIV;
+	uint32_t		RESERVED6[18];
+	__IO uint32_t	CLKOUTSEL;
+	__IO uint32_t	CLKOUTUEN;
+	__IO uint32_t	CLKOUTDIV;
+	uint32_t		RESERVED7;
+	__IO uint32_t	UARTFRGDIV;
+	__IO uint32_t	UARTFRGMULT;
+	uint32_t		RESERVED8;
+	__IO uint32_t	EXTTRACECMD;
+	__IO uint32_t	PIOPORCAP0;
+	uint32_t		RESERVED9[12];
+	__IO uint32_t	IOCONCLKDIV[7];
+	__IO uint32_t	BODCTRL;
+	__IO uint32_t	SYSTCKCAL;
+	uint32_t		RESERVED10[6];
+	__IO uint32_t	IRQLATENCY;
+	__IO uint32_t	NMISRC;
+	__IO uint32_t	PINTSEL[8];
+	uint32_t		RESERVED11[27];
+	__IO uint32_t	STARTERP0;
+	uint32_t		RESERVED12[3];
+	__IO uint32_t	STARTERP1;
+	uint32_t		RESERVED13[6];
+	__IO uint32_t	PDSLEEPCFG;
+	__IO uint32_t	PDAWAKECFG;
+	__IO uint32_t	PDRUNCFG;
+	uint32_t		RESERVED14[111];
+	__IO uint32_t	DEVICE_ID;
+} LPC_SYSCON_TypeDef;
+
+/*** WWDT ***/
+typedef struct {
+	__IO uint32_t	MOD;
+	__IO uint32_t	TC;
+	__IO uint32_t	FEED;
+	__IO uint32_t	TV;
+	uint32_t		RESERVED0;
+	__IO uint32_t	WARNINT;
+	__IO uint32_t	WINDOW;
+} LPC_WWDT_TypeDef;
+
+/*** GPIO ***/
+typedef struct {
+	__IO uint8_t	B0[18];
+	uint16_t		RESERVED0;
+	uint32_t		RESERVED1[1019];
+	__IO uint32_t	W0[18];
+	uint32_t		RESERVED2[1006];
+	__IO uint32_t	DIR0;
+	uint32_t		RESERVED3[31];
+	__IO uint32_t	MASK0;
+	uint32_t		RESERVED4[31];
+	__IO uint32_t	PIN0;
+	uint32_t		RESERVED5[31];
+	__IO uint32_t	MPIN0;
+	uint32_t		RESERVED6[31];
+	__IO uint32_t	SET0;
+	uint32_t		RESERVED7[31];
+	__IO uint32_t	CLR0;
+	uint32_t		RESERVED8[31];
+	__IO uint32_t	NOT0;
+} LPC_GPIO_PORT_TypeDef;
+
+/*** スイッチマトリクス ***/
+typedef struct {
+	__IO uint32_t	PINASSIGN0;
+	__IO uint32_t	PINASSIGN1;
+	__IO uint32_t	PINASSIGN2;
+	__IO uint32_t	PINASSIGN3;
+	__IO uint32_t	PINASSIGN4;
+	__IO uint32_t	PINASSIGN5;
+	__IO uint32_t	PINASSIGN6;
+	__IO uint32_t	PINASSIGN7;
+	__IO uint32_t	PINASSIGN8;
+	uint32_t		RESERVED0[103];
+	__IO uint32_t	PINENABLE0;
+} LPC_SWM_TypeDef;
+
+/*** IOCON ***/
+typedef struct {
+	__IO uint32_t	PIO0_17;
+	__IO uint32_t	PIO0_13;
+	__IO uint32_t	PIO0_12;
+	__IO uint32_t	PIO0_5;
+	__IO uint32_t	PIO0_4;
+	__IO uint32_t	PIO0_3;
+	__IO uint32_t	PIO0_2;
+	__IO uint32_t	PIO0_11;
+	__IO uint32_t	PIO0_10;
+	__IO uint32_t	PIO0_16;
+	__IO uint32_t	PIO0_15;
+	__IO uint32_t	PIO0_1;
+	uint32_t		RESERVED0;
+	__IO uint32_t	PIO0_9;
+	__IO uint32_t	PIO0_8;
+	__IO uint32_t	PIO0_7;
+	__IO uint32_t	PIO0_6;
+	__IO uint32_t	PIO0_0;
+	__IO uint32_t	PIO0_14;
+} LPC_IOCON_TypeDef;
+
+/*** PMU ***/
+typedef struct {
+	__IO uint32_t	PCON;
+	__IO uint32_t	GPREG0;
+	__IO uint32_t	GPREG1;
+	__IO uint32_t	GPREG2;
+	__IO uint32_t	GPREG3;
+	__IO uint32_t	DPDCTRL;
+} LPC_PMU_TypeDef;
+
+/*** ピン割り込み ***/
+typedef struct {
+	__IO uint32_t	ISEL;
+	__IO uint32_t	IENR;
+	__IO uint32_t	SIENR;
+	__IO uint32_t	CIENR;
+	__IO uint32_t	IENF;
+	__IO uint32_t	SIENF;
+	__IO uint32_t	CIENF;
+	__IO uint32_t	RISE;
+	__IO uint32_t	FALL;
+	__IO uint32_t	IST;
+	__IO uint32_t	PMCTRL;
+	__IO uint32_t	PMSRC;
+	__IO uint32_t	PMCFG;
+} LPC_PIN_INT_TypeDef;
+
+/*** USART ***/
+typedef struct {
+	__IO uint32_t	CFG;
+	__IO uint32_t	CTRL;
+	__IO uint32_t	STAT;
+	__IO uint32_t	INTENSET;
+	__IO uint32_t	INTENCLR;
+	__IO uint32_t	RXDATA;
+	__IO uint32_t	RXDATA_STATUS;
+	__IO uint32_t	TXDATA;
+	__IO uint32_t	BRG;
+	__IO uint32_t	INTSTAT;
+} LPC_USART_TypeDef;
+
+/*** マルチレートタイマ ***/
+typedef struct {
+	__IO uint32_t	INTVAL;
+	__IO uint32_t	TIMER;
+	__IO uint32_t	CTRL;
+	__IO uint32_t	STAT;
+} MRT_Channel_cfg_Type;
+
+typedef struct {
+	MRT_Channel_cfg_Type	Channel[4];
+	uint32_t		RESERVED0[45];
+	__IO uint32_t	IDLE_CH;
+	__IO uint32_t	IRQ_FLAG;
+} LPC_MRT_TypeDef;
+
+/*** ステートコンフィギュラブルタイマ(LPC81x: マッチ5本、イベント6個、出力4本) ***/
+typedef union {
+	uint32_t		U;
+	struct {
+		uint16_t	L;
+		uint16_t	H;
+	};
+} SCT_Reg_Type;
+
+typedef struct {
+	__IO uint32_t	CONFIG;
+	union {
+		__IO uint32_t	CTRL_U;
+		struct {
+			__IO uint16_t	CTRL_L;
+			__IO uint16_t	CTRL_H;
+		};
+	};
+	__IO uint16_t	LIMIT_L;
+	__IO uint16_t	LIMIT_H;
+	__IO uint16_t	HALT_L;
+	__IO uint16_t	HALT_H;
+	__IO uint16_t	STOP_L;
+	__IO uint16_t	STOP_H;
+	__IO uint16_t	START_L;
+	__IO uint16_t	START_H;
+	uint32_t		RESERVED1[10];
+	union {
+		__IO uint32_t	COUNT_U;
+		struct {
+			__IO uint16_t	COUNT_L;
+			__IO uint16_t	COUNT_H;
+		};
+	};
+	__IO uint16_t	STATE_L;
+	__IO uint16_t	STATE_H;
+	__IO uint32_t	INPUT;
+	__IO uint16_t	REGMODE_L;
+	__IO uint16_t	REGMODE_H;
+	__IO uint32_t	OUTPUT;
+	__IO uint32_t	OUTPUTDIRCTRL;
+	__IO uint32_t	RES;
+	uint32_t		RESERVED2[37];
+	__IO uint32_t	EVEN;
+	__IO uint32_t	EVFLAG;
+	__IO uint32_t	CONEN;
+	__IO uint32_t	CONFLAG;
+	__IO SCT_Reg_Type	MATCH[5];
+	uint32_t		RESERVED3[59];
+	__IO SCT_Reg_Type	MATCHREL[5];
+	uint32_t		RESERVED4[59];
+	struct {
+		__IO uint32_t	STATE;
+		__IO uint32_t	CTRL;
+	} EVENT[6];
+	uint32_t		RESERVED5[116];
+	struct {
+		__IO uint32_t	SET;
+		__IO uint32_t	CLR;
+	} OUT[4];
+} LPC_SCT_TypeDef;
+
+/*** フラッシュコントローラ ***/
+typedef struct {
+	uint32_t		RESERVED0[4];
+	__IO uint32_t	FLASHCFG;
+} LPC_FLASHCTRL_TypeDef;
+
+/*** セルフウェイクアップタイマ ***/
+typedef struct {
+	__IO uint32_t	CTRL;
+	uint32_t		RESERVED0[2];
+	__IO uint32_t	COUNT;
+} LPC_WKT_TypeDef;
+
+/*** SysTick(コア) ***/
+typedef struct {
+	__IO uint32_t	CTRL;
+	__IO uint32_t	LOAD;
+	__IO uint32_t	VAL;
+	__IO uint32_t	CALIB;
+} SysTick_Type;
+
+/*** SCB(コア) ***/
+typedef struct {
+	__IO uint32_t	CPUID;
+	__IO uint32_t	ICSR;
+	__IO uint32_t	VTOR;
+	__IO uint32_t	AIRCR;
+	__IO uint32_t	SCR;
+	__IO uint32_t	CCR;
+} SCB_Type;
+
+#define	SysTick_CTRL_ENABLE_Msk		(1UL << 0)
+#define	SysTick_CTRL_TICKINT_Msk	(1UL << 1)
+#define	SysTick_CTRL_CLKSOURCE_Msk	(1UL << 2)
+#define	SysTick_CTRL_COUNTFLAG_Msk	(1UL << 16)
+#define	SysTick_LOAD_RELOAD_Msk		(0xFFFFFFUL)
+#define	SCB_SCR_SLEEPDEEP_Msk		(1UL << 2)
+#define	SCB_ICSR_PENDSTSET_Msk		(1UL << 26)
+
+/***************************************************************************
+	ペリフェラルの取得(レジスタモデルへのアクセス)
+***************************************************************************/
+LPC_SYSCON_TypeDef		*Sim_syscon(void);
+LPC_WWDT_TypeDef		*Sim_wwdt(void);
+LPC_GPIO_PORT_TypeDef	*Sim_gpio(void);
+LPC_SWM_TypeDef			*Sim_swm(void);
+LPC_IOCON_TypeDef		*Sim_iocon(void);
+LPC_PMU_TypeDef			*Sim_pmu(void);
+LPC_WKT_TypeDef			*Sim_wkt(void);
+LPC_PIN_INT_TypeDef		*Sim_pint(void);
+LPC_USART_TypeDef		*Sim_usart0(void);
+LPC_MRT_TypeDef			*Sim_mrt(void);
+LPC_SCT_TypeDef			*Sim_sct(void);
+LPC_FLASHCTRL_TypeDef	*Sim_flashctrl(void);
+SysTick_Type			*Sim_systick(void);
+SCB_Type				*Sim_scb(void);
+
+#define	LPC_SYSCON		(Sim_syscon())
+#define	LPC_WWDT		(Sim_wwdt())
+#define	LPC_GPIO_PORT	(Sim_gpio())
+#define	LPC_SWM			(Sim_swm())
+#define	LPC_IOCON		(Sim_iocon())
+#define	LPC_PMU			(Sim_pmu())
+#define	LPC_WKT			(Sim_wkt())
+#define	LPC_PIN_INT		(Sim_pint())
+#define	LPC_USART0		(Sim_usart0())
+#define	LPC_MRT			(Sim_mrt())
+#define	LPC_SCT			(Sim_sct())
+#define	LPC_FLASHCTRL	(Sim_flashctrl())
+#define	SysTick			(Sim_systick())
+#define	SCB				(Sim_scb())
+
+/***************************************************************************
+	CMSIS関数の置き換え
+***************************************************************************/
+void		Sim_nop(void);
+void		Sim_wfi(void);
+void		Sim_bkpt(void);
+void		Sim_setPrimask(uint32_t primask);
+uint32_t	Sim_getPrimask(void);
+void		Sim_enableIrq(IRQn_Type irq, _Bool en);
+void		Sim_setPendIrq(IRQn_Type irq, _Bool pend);
+void		Sim_setPriority(IRQn_Type irq, uint32_t pri);
+uint32_t	Sim_sysTickConfig(uint32_t ticks);
+
+#define	__NOP()					Sim_nop()
+#define	__WFI()					Sim_wfi()
+#define	__BKPT(v)				Sim_bkpt()
+#define	__DSB()					((void)0)
+#define	__ISB()					((void)0)
+#define	__disable_irq()			Sim_setPrimask(1)
+#define	__enable_irq()			Sim_setPrimask(0)
+#define	__get_PRIMASK()			Sim_getPrimask()
+#define	__set_PRIMASK(p)		Sim_setPrimask(p)
+#define	__get_MSP()				0UL
+#define	__get_PSP()				0UL
+#define	NVIC_EnableIRQ(n)		Sim_enableIrq((n), 1)
+#define	NVIC_DisableIRQ(n)		Sim_enableIrq((n), 0)
+#define	NVIC_SetPendingIRQ(n)	Sim_setPendIrq((n), 1)
+#define	NVIC_ClearPendingIRQ(n)	Sim_setPendIrq((n), 0)
+#define	NVIC_SetPriority(n, p)	Sim_setPriority((n), (p))
+#define	SysTick_Config(t)		Sim_sysTickConfig(t)
+
+#endif	/* LPC8XX_H */
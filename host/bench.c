@@ -0,0 +1,1449 @@
+/***************************************************************************
+	bench.c
+	ホスト用ベンチマーク・回帰テスト
+
+	使用方法: host/Makefileでビルドし、out/<構成名>/benchを実行する
+
+	core.hの構成1つについて、レジスタモデル(sim.c)の上でSys_lib, Wdt_lib,
+	Idle_lib, Sup_libを動かし、以下を確認する。
+	・Sys_iniLpc810, Wdt_ini, Sys_setClock, Wdt_clrのレジスタアクセス回数
+	　と所要時間(ベンチマークとして表示)
+	・初期化後のクロックがモデルと一致すること、起動時間の記録の順序
+	・フラッシュのアクセス時間がシステムクロックに対して最小であること
+	　(切り替え中に不足すればモデルが検出する)
+	・Sys_msToTicks, Sys_usToTicks, Wdt_msToCntの換算誤差
+	・Wdt_getRestMsがモデルのWDTカウンタと一致すること
+	・WDT用オシレータに誤差がある場合に、Wdt_calOscの較正でタイムアウト
+	　時間が指定通りになること
+	・WDTクリア間隔の学習(Wdt_learnStart)の記録と、学習結果によるタイム
+	　アウト・ガード時間
+	・WDT満了でリセットされること、Idle_runの待機でリセットされないこと
+	・省電力モード(Sys_enterPowerMode)からの起床後のクロックがモデルと一
+	　致すること、起床時間による省電力モードの選択
+	・PLLがロックしない場合に内蔵オシレータで起動・切り替えすること
+	・リセット要因の記録がリセットをまたいで残ること
+	・クロック供給の参照数(Sys_acqClk, Sys_relClk)と、初期化後にSWM,
+	　IOCON, MRTのクロックが止まっていること(止まっているペリフェラルの
+	　参照はモデルが検出する)
+	・ピン割り込みがエッジ/レベルの指定通りに発生すること
+	・ピン設定(Iocon_lib)のレジスタ値と予約ビットの保持、入力フィルタで
+	　除かれるパルスの長さがクロック変更後も変わらないこと
+	・SCT(Sct_lib)のPWM・点滅出力のH時間と周期がクロック変更後も変わら
+	　ないこと、デューティの変更がMATCHRELの書き込みだけで済むこと、変化
+	　点の数の上限
+	・イベントキュー(Evt_lib)の順序、満杯時の破棄、1回分ずつの処理
+	・USART0(Uart_lib)の伝送速度の誤差、クロック変更時の再設定、割り込み
+	　での送受信
+	・MRTのタイムスタンプ(Mrt_lib)の経過クロック数、処理時間計測(Prof_lib)
+	　の最小・最大・平均
+	・サンプル(main.c)の定常ループを動かし続けても、監視タスク(Sup_lib)
+	　の報告が間に合ってWDTがクリアされ続けること
+
+	失敗があれば終了コード1を返す。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: ピン割り込み(Pint_lib)の確認追加
+	2026.10.16: mits: イベントキュー(Evt_lib)の確認追加
+	2026.10.16: mits: USART0(Uart_lib)の確認追加
+	2026.10.16: mits: MRT(Mrt_lib), 処理時間計測(Prof_lib)の確認追加
+	2026.10.16: mits: WDT用オシレータの較正(Wdt_calOsc)の確認追加
+	2026.10.16: mits: WDTクリア間隔の学習(Wdt_learnStart)の確認追加
+	2026.10.16: mits: 省電力モード(Sys_enterPowerMode)の確認追加
+	2026.10.16: mits: クロック供給の参照数(Sys_acqClk, Sys_relClk)の確認追加
+	2026.10.16: mits: フラッシュのアクセス時間の確認追加
+	2026.10.16: mits: GPIOのインライン関数(Gpio_lib)の確認追加
+	2026.10.16: mits: スイッチマトリクス(Swm_lib)の確認追加
+	2026.10.16: mits: ピン設定(Iocon_lib)の確認追加
+	2026.10.16: mits: SCT(Sct_lib)の確認追加
+	2026.10.16: mits: PLLがロックしない場合のクロック切り替えの確認追加
+	2026.10.16: mits: 省電力モードから起床後にPLLがロックしない場合の確認追加
+	2026.10.16: mits: SysTickを使わない待機がディープスリープになることの確認追加
+	2026.10.16: mits: CLKIN端子の割り当てと解放の確認追加
+	2026.10.16: mits: サンプルの定常ループでのWDT監視(Sup_lib)の確認追加
+	2026.10.16: mits: Sys_acqClkの参照数の上限での停止の確認追加
+	2026.10.16: mits: サンプルのLED_BLINKの点滅の確認追加、SWM_PIN_MAPのCTOUT_0に合わせた
+***************************************************************************/
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+#include	"core.h"
+#include	"sim.h"
+#include	"Sys_lib.h"
+#include	"Wdt_lib.h"
+#include	"Idle_lib.h"
+#include	"Sup_lib.h"
+#include	"Pint_lib.h"
+#include	"Evt_lib.h"
+#include	"Uart_lib.h"
+#include	"Mrt_lib.h"
+#include	"Prof_lib.h"
+#include	"Gpio_lib.h"
+#include	"Swm_lib.h"
+#include	"Iocon_lib.h"
+#include	"Sct_lib.h"
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	IDLE_SIM_MS		= 20000,	/* ms; アイドル待機を続ける時間 */
+	IDLE_NOWDT_MS	= 1000,		/* ms; WDTを使わない構成での待機時間 */
+	IDLE_DEEP_PCT	= 90,		/* %; ディープスリープ以下で待機すべき時間の割合 */
+	RATE_CHK_MS		= 100000,	/* ms; 換算誤差を調べる範囲 */
+	WDT_CHK_STEP_MS	= 7,		/* ms; WDTカウンタを調べる間隔 */
+	RST_WDT_BIT		= 2,		/* Sys_rstInfo.cntでのWDTリセット(SYS_RST_WDT)の位置 */
+	UART_BAUD		= 115200,	/* bps; USART0の確認に使う伝送速度 */
+	UART_STEP_US	= 20,		/* us; USART0の送信を進める間隔 */
+	UART_WAIT_US	= 100000,	/* us; USART0の送信完了を待つ上限 */
+	MRT_LONG_US		= 100000000,	/* us; タイムスタンプの一周を挟ませる待ち時間(2回) */
+	PROF_NOP_MAX	= 100,		/* 計測区間で実行する__NOPの最大数 */
+	WDT_OSC_ERR_PPM	= 300000,	/* ppm; 較正の確認で与えるWDT用オシレータの誤差(±) */
+	WDT_CAL_TOL_PPM	= 5000,		/* ppm; 較正後の周波数の許容誤差 */
+	WDT_LEARN_CHK_MS	= 2,	/* ms; 学習後のタイムアウトを調べる前後の幅 */
+	PMODE_WKT_CNT	= 100,		/* 省電力モードの確認でWKTに設定するカウント(10kHzで10ms) */
+	PMODE_LOCK_US	= 1000,		/* us; Sys_lib.cのPLL_LOCK_US(PLLのロック待ちの上限時間) */
+	BOOT_TAIL_US	= 2000,		/* us; 起動時間の記録(mainSel)からSys_iniLpc810終了までの上限 */
+	SUP_RUN_WDT		= 5			/* サンプルの定常ループを動かす時間(WDTタイムアウト時間の倍数) */
+};
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static const char	*Bench_name;	/* 構成名 */
+static uint32_t		Bench_fail;		/* 失敗数 */
+static uint32_t		Bench_pintCnt[2];	/* Bench_pintFuncの呼び出し回数([0]:L/立ち下がり、[1]:H/立ち上がり) */
+static Evt_que		Bench_que[2];		/* Bench_evtで使うキュー */
+static uint32_t		Bench_evtLog[EVT_QUE_SIZE * 2];	/* Bench_evtFuncが受け取った(番号<<8|引数) */
+static uint32_t		Bench_evtNum;		/* Bench_evtLogの記録数 */
+
+static const char	*Bench_periName[SIM_PERI_NUM] = {
+	"SYSCON", "WWDT", "GPIO", "SWM", "IOCON", "PMU", "WKT", "SysTick", "SCB", "PINT", "USART0", "MRT",
+	"FLASH", "SCT"
+};
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static void Bench_chk(_Bool ok, const char *what);
+static void Bench_report(const char *what);
+static void Bench_feed(void);
+static void Bench_iniPort(void);
+static _Bool Bench_flashTimOk(void);
+static void Bench_boot(void);
+static void Bench_rate(void);
+static void Bench_wdt(void);
+static void Bench_wdtCal(void);
+static void Bench_wdtLearn(void);
+static void Bench_setClock(void);
+static void Bench_idle(void);
+static void Bench_pmode(void);
+static void Bench_pllFail(void);
+static void Bench_rstInfo(void);
+static void Bench_clkGate(void);
+static void Bench_gpio(void);
+static void Bench_swm(void);
+static void Bench_iocon(void);
+static void Bench_sct(void);
+static uint32_t Bench_sctHighUs(uint32_t pin, uint32_t us, uint32_t *rise);
+static void Bench_pint(void);
+static void Bench_pintFunc(uint32_t ch, _Bool rise);
+static void Bench_evt(void);
+static void Bench_evtFunc0(uint32_t arg);
+static void Bench_evtFunc1(uint32_t arg);
+static void Bench_uart(void);
+static _Bool Bench_uartFlush(void);
+static void Bench_prof(void);
+static void Bench_sup(void);
+
+/***************************************************************************
+	サンプル(main.c、main()をApp_mainに改名してリンクしている)
+***************************************************************************/
+int App_main(void);
+
+/***************************************************************************
+	main
+***************************************************************************/
+int main(int argc, char *argv[])
+{
+	Bench_name = (argc > 1)? argv[1]: "default";
+
+	Bench_boot();
+	Bench_rate();
+	Bench_wdt();
+	Bench_wdtCal();
+	Bench_wdtLearn();
+	Bench_setClock();
+	Bench_idle();
+	Bench_pmode();
+	Bench_pllFail();
+	Bench_rstInfo();
+	Bench_clkGate();
+	Bench_gpio();
+	Bench_swm();
+	Bench_iocon();
+	Bench_sct();
+	Bench_pint();
+	Bench_evt();
+	Bench_uart();
+	Bench_prof();
+	Bench_sup();		/* App_mainを途中で抜けるので最後に行う */
+
+	printf("%s: %s (%u failed)\n", Bench_name, (Bench_fail == 0)? "PASS": "FAIL", Bench_fail);
+	return (Bench_fail == 0)? EXIT_SUCCESS: EXIT_FAILURE;
+}
+
+/***************************************************************************
+	Bench_chk
+	確認結果の記録
+
+	[引数]	ok		確認結果
+			what	確認内容
+	[戻値]	なし
+
+	モデルが誤操作を検出していた場合も失敗とする。
+***************************************************************************/
+static void Bench_chk(_Bool ok, const char *what)
+{
+	const char	*fault = Sim_getFault();
+
+	if (fault != NULL) {
+		printf("%s: FAIL %s: model fault: %s\n", Bench_name, what, fault);
+		Bench_fail++;
+	}
+	else if (!ok) {
+		printf("%s: FAIL %s\n", Bench_name, what);
+		Bench_fail++;
+	}
+}
+
+/***************************************************************************
+	Bench_report
+	Sim_clrCnt以降のアクセス回数・所要時間の表示
+***************************************************************************/
+static void Bench_report(const char *what)
+{
+	Sim_cnt		cnt;
+	uint32_t	i;
+
+	Sim_getCnt(&cnt);
+	printf("%s: %-24s %5u acc %8llu cyc %8llu us  [", Bench_name, what, cnt.total,
+		(unsigned long long)cnt.cycles, (unsigned long long)(cnt.ps / 1000000));
+	for (i = 0; i < SIM_PERI_NUM; i++) {
+		if (cnt.acc[i] != 0) {
+			printf(" %s:%u", Bench_periName[i], cnt.acc[i]);
+		}
+	}
+	printf(" ]\n");
+}
+
+/***************************************************************************
+	Bench_feed
+	ガード時間(WWDT_TIM_GUARD)が明けるのを待ってのWDTクリア
+***************************************************************************/
+static void Bench_feed(void)
+{
+	Sim_advanceUs((WWDT_TIM_GUARD + 1) * 1000);
+	Wdt_clr();
+}
+
+/***************************************************************************
+	Bench_iniPort
+	main.cのiniPortと同じGPIOへのクロック供給
+	※WDT警告割り込みでmain.cのWdt_procWarnがLEDを点けるので、警告まで
+	　WDTを進める確認の前に呼び出す
+***************************************************************************/
+static void Bench_iniPort(void)
+{
+	(void)Sys_acqClk(SYS_AHB_CLK_GPIO, SYS_GPIO_RST_N);
+}
+
+/***************************************************************************
+	Bench_flashTimOk
+	フラッシュのアクセス時間が現在のシステムクロックに対して最小か
+***************************************************************************/
+static _Bool Bench_flashTimOk(void)
+{
+	uint32_t	tim = (Sim_getCoreHz() <= FLASH_1CLK_MAX_HZ)? FLASH_TIM_1CLK: FLASH_TIM_2CLK;
+
+	return ((LPC_FLASHCTRL->FLASHCFG & FLASH_TIM) == tim)? true: false;
+}
+
+/***************************************************************************
+	Bench_boot
+	電源投入からの初期化
+***************************************************************************/
+static void Bench_boot(void)
+{
+	const Sys_bootTim	*tim;
+	uint64_t			start, us;
+
+	Sim_reset(SYS_RST_POR);
+	Sim_clrCnt();
+	start = Sim_getTimeUs();
+	Sys_iniLpc810();
+	us = Sim_getTimeUs() - start;
+	Bench_report("Sys_iniLpc810");
+	Bench_iniPort();
+
+	Bench_chk(Sim_getMainHz() == Sys_getMainClk(), "boot: main clock matches model");
+	Bench_chk(Sim_getCoreHz() == Sys_getSysClk(), "boot: system clock matches model");
+	Bench_chk(Bench_flashTimOk(), "boot: minimum flash access time");
+
+	tim = Sys_getBootTim();
+	Bench_chk(tim->wdtIni <= tim->clkin && tim->clkin <= tim->pllSel
+		&& tim->pllSel <= tim->pllLock && tim->pllLock <= tim->mainSel, "boot: timing record is monotonic");
+	Bench_chk(tim->pllOk, "boot: PLL locked");
+	Bench_chk(tim->mainHz == Sys_getMainClk(), "boot: timing record main clock");
+	Bench_chk(tim->mainSel <= us && tim->mainSel + BOOT_TAIL_US >= us, "boot: timing record in us matches model");
+	printf("%s: boot main clock switched at %u us (Sys_iniLpc810 %llu us)\n", Bench_name, tim->mainSel,
+		(unsigned long long)us);
+	if ((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLOUT) {
+		printf("%s: boot PLL lock %u us\n", Bench_name, tim->pllLock - tim->pllSel);
+	}
+
+	/* Wdt_iniもWDTクリアを行うので、ガード時間明けに呼ぶ */
+	Sim_advanceUs((WWDT_TIM_GUARD + 1) * 1000);
+	Sim_clrCnt();
+	Wdt_ini();
+	Bench_report("Wdt_ini");
+	Sim_advanceUs((WWDT_TIM_GUARD + 1) * 1000);
+	Sim_clrCnt();
+	Wdt_clr();
+	Bench_report("Wdt_clr");
+}
+
+/***************************************************************************
+	Bench_rate
+	時間換算の誤差
+	※Sys_msToTicks等は現在のシステムクロックでの換算
+
+	RATE_Q固定小数点での換算は切り捨てなので、64ビット除算による正確な値
+	以下で、その差は1tick＋値の2^-RATE_Q倍以内であること。
+***************************************************************************/
+static void Bench_rate(void)
+{
+	uint32_t	ms, us;
+	uint64_t	exact, got, maxerr = 0;
+	_Bool		ok = true;
+	uint32_t	hz = Sim_getCoreHz();
+
+	for (ms = 0; ms <= RATE_CHK_MS; ms += (ms < 100)? 1: 97) {
+		exact = (uint64_t)ms * hz / 1000;
+		got = Sys_msToTicks(ms);
+		if (got > exact || exact - got > 1 + (exact >> RATE_Q)) {
+			ok = false;
+		}
+		maxerr = (exact - got > maxerr)? exact - got: maxerr;
+	}
+	Bench_chk(ok, "rate: Sys_msToTicks error");
+	for (us = 0; us <= RATE_CHK_MS * 10; us += (us < 1000)? 1: 997) {
+		exact = (uint64_t)us * hz / 1000000;
+		got = Sys_usToTicks(us);
+		if (got > exact || exact - got > 1 + (exact >> RATE_Q)) {
+			ok = false;
+		}
+	}
+	Bench_chk(ok, "rate: Sys_usToTicks error");
+
+	/* Wdt_getOscClk(周波数/分周値)は切り捨てなので、正確な値は周波数から求める */
+	ok = true;
+	for (ms = 0; ms <= WWDT_TIM_OUT; ms++) {
+		exact = (uint64_t)ms * WDTOSC_FREQ_HZ(WWDT_FREQ) / ((uint64_t)WWDT_DIV * 4 * 1000);
+		got = Wdt_msToCnt(ms);
+		if (got > exact || exact - got > 1 + (exact >> RATE_Q)) {
+			ok = false;
+		}
+	}
+	Bench_chk(ok, "rate: Wdt_msToCnt error");
+	printf("%s: Sys_msToTicks max error %llu tick\n", Bench_name, (unsigned long long)maxerr);
+}
+
+/***************************************************************************
+	Bench_wdt
+	WDTの残り時間とタイムアウト
+***************************************************************************/
+static void Bench_wdt(void)
+{
+	uint32_t	t, rest, model;
+	_Bool		ok = true;
+
+	if ((WWDT_MODE & WWDT_WDEN) == 0) {
+		Bench_chk(Wdt_getRestMs() == UINT32_MAX, "wdt: disabled WDT has no deadline");
+		return;
+	}
+
+	/* 残り時間はモデルのTVから求めた時間以下で、差は1ms＋1%以内
+	   (WDTクロックが速いとWdt_msPerCntの丸めが1%近くになる) */
+	Bench_feed();
+	for (t = 0; t + WDT_CHK_STEP_MS < WWDT_TIM_OUT; t += WDT_CHK_STEP_MS) {
+		rest = Wdt_getRestMs();
+		model = (uint32_t)((uint64_t)LPC_WWDT->TV * 4 * 1000 / Wdt_getOscClk());
+		if (rest > model || model - rest > 1 + model / 100) {
+			ok = false;
+		}
+		Sim_advanceUs(WDT_CHK_STEP_MS * 1000);
+	}
+	Bench_chk(ok, "wdt: Wdt_getRestMs matches model");
+
+	/* WWDT_TIM_OUT少し前まではリセットされず、過ぎればリセット */
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Bench_feed();
+	Sim_advanceUs((WWDT_TIM_OUT - 2) * 1000);
+	Bench_chk(!Sim_isWdtReset(), "wdt: no reset before WWDT_TIM_OUT");
+	Sim_advanceUs(4 * 1000);
+	Bench_chk(Sim_isWdtReset() == ((WWDT_MODE & WWDT_WDRESET) != 0), "wdt: reset after WWDT_TIM_OUT");
+	Bench_chk(Sim_getWdtWarn() == 1, "wdt: one warning interrupt");
+}
+
+/***************************************************************************
+	Bench_wdtCal
+	WDT用オシレータの較正
+***************************************************************************/
+static void Bench_wdtCal(void)
+{
+	static const int32_t	ppms[] = { 0, -WDT_OSC_ERR_PPM, WDT_OSC_ERR_PPM };
+	uint32_t	i, real, got, margin;
+	int64_t		err;
+	_Bool		cal;
+
+	for (i = 0; i < sizeof(ppms) / sizeof(ppms[0]); i++) {
+		Sim_setWdtOscPpm(ppms[i]);
+		Sim_reset(SYS_RST_POR);
+		Sys_iniLpc810();
+		Bench_iniPort();
+
+		Sim_clrCnt();
+		cal = Wdt_calOsc();
+		if (ppms[i] == 0) {
+			Bench_report("Wdt_calOsc");
+		}
+		if (((WWDT_MODE & WWDT_WDEN) == 0) || ((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_WDTOSC)) {
+			Bench_chk(!cal, "wdtcal: skipped without a reference");
+			break;
+		}
+		Bench_chk(cal, "wdtcal: calibrated");
+
+		/* 周波数はモデルのオシレータとWDT_CAL_TOL_PPM以内 */
+		real = (uint32_t)((uint64_t)WDTOSC_FREQ_HZ(WWDT_FREQ) * (1000000 + ppms[i]) / 1000000 / WWDT_DIV);
+		got = Wdt_getOscClk();
+		err = ((int64_t)got - real) * 1000000 / real;
+		printf("%s: wdtcal %+7d ppm: %u Hz (model %u Hz, %+lld ppm)\n", Bench_name,
+			ppms[i], got, real, (long long)err);
+		Bench_chk(err >= -WDT_CAL_TOL_PPM && err <= WDT_CAL_TOL_PPM, "wdtcal: frequency matches model");
+
+		/* 較正後はWWDT_TIM_OUTの前後(誤差分＋2ms)で満了(TV=0)の有無が分かれる */
+		margin = 2 + (uint32_t)((uint64_t)WWDT_TIM_OUT * WDT_CAL_TOL_PPM / 1000000);
+		Bench_feed();
+		Sim_advanceUs((WWDT_TIM_OUT - margin) * 1000);
+		Bench_chk(!Sim_isWdtReset() && LPC_WWDT->TV != 0, "wdtcal: no timeout before WWDT_TIM_OUT");
+		Sim_advanceUs(2 * margin * 1000);
+		Bench_chk(LPC_WWDT->TV == 0, "wdtcal: timeout after WWDT_TIM_OUT");
+	}
+	Sim_setWdtOscPpm(0);
+}
+
+/***************************************************************************
+	Bench_wdtLearn
+	WDTクリア間隔の学習
+***************************************************************************/
+static void Bench_wdtLearn(void)
+{
+	/* クリア間隔(WWDT_TIM_GUARDからの追加分、ms) */
+	static const uint32_t	gaps[] = { 300, 200, 250, 400, 220, 260 };
+	enum {
+		GAP_NUM	= sizeof(gaps) / sizeof(gaps[0]),
+		GAP_MIN	= WWDT_TIM_GUARD + 200,
+		GAP_MAX	= WWDT_TIM_GUARD + 400,
+		TC_MS	= GAP_MAX + (GAP_MAX >> WDT_LEARN_MARGIN_SFT)	/* 学習後のタイムアウト時間 */
+				+ WWDT_TIM_WARN + WDT_LEARN_LEAD_MS
+	};
+	Wdt_learn	lrn;
+	uint32_t	i, sum;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Bench_iniPort();
+	if ((WWDT_MODE & WWDT_WDEN) == 0) {
+		Wdt_learnStart(GAP_NUM);
+		Wdt_getLearn(&lrn);
+		Bench_chk(!lrn.run, "wdtlearn: not started without WDT");
+		return;
+	}
+
+	/* 記録 */
+	Bench_feed();
+	Wdt_learnStart(GAP_NUM);
+	for (i = 0; i < GAP_NUM; i++) {
+		Sim_advanceUs((WWDT_TIM_GUARD + gaps[i]) * 1000);
+		Sim_clrCnt();
+		Wdt_clr();
+		if (i == 0) {
+			Bench_report("Wdt_clr (learning)");
+		}
+		else if (i == GAP_NUM - 1) {
+			Bench_report("Wdt_clr (learn apply)");
+		}
+	}
+	Wdt_getLearn(&lrn);
+	for (i = 0, sum = 0; i < WDT_HIST_NUM; i++) {
+		sum += lrn.hist[i];
+	}
+	printf("%s: wdtlearn cnt %u min %u ms max %u ms TC %u ms WINDOW %u ms\n", Bench_name, lrn.cnt,
+		Wdt_cntToMs(lrn.min), Wdt_cntToMs(lrn.max), Wdt_cntToMs(LPC_WWDT->TC), Wdt_cntToMs(LPC_WWDT->WINDOW));
+	Bench_chk(!lrn.run && lrn.applied && lrn.cnt == GAP_NUM && sum == GAP_NUM, "wdtlearn: applied after num feeds");
+	/* 間隔はWdt_clrまでのアクセス分だけずれる(1ms分以内) */
+	Bench_chk(lrn.min <= Wdt_msToCnt(GAP_MIN) && lrn.min + Wdt_msToCnt(1) >= Wdt_msToCnt(GAP_MIN)
+		&& lrn.max <= Wdt_msToCnt(GAP_MAX) && lrn.max + Wdt_msToCnt(1) >= Wdt_msToCnt(GAP_MAX),
+		"wdtlearn: min/max interval");
+	Bench_chk(lrn.hist[(lrn.max >> lrn.sft) % WDT_HIST_NUM] != 0, "wdtlearn: histogram");
+
+	/* ガード時間: 最短間隔の少し前まではクリアできない(暴走の検出) */
+	Bench_chk(!Wdt_isFeedable(), "wdtlearn: guard window after apply");
+	Sim_advanceUs(GAP_MIN * 1000);
+	Bench_chk(Wdt_isFeedable(), "wdtlearn: feedable at the shortest interval");
+	Wdt_clr();
+
+	/* タイムアウト: 最長間隔＋余裕＋警告割り込みまでの時間で満了(ハングの検出) */
+	Sim_advanceUs((TC_MS - WDT_LEARN_CHK_MS) * 1000);
+	Bench_chk(LPC_WWDT->TV != 0, "wdtlearn: no timeout before learned TC");
+	Sim_advanceUs(2 * WDT_LEARN_CHK_MS * 1000);
+	Bench_chk(LPC_WWDT->TV == 0, "wdtlearn: timeout after learned TC");
+
+	/* 学習し直す場合はWWDT_TIM_OUT, WWDT_TIM_GUARDに戻る */
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Bench_feed();
+	Wdt_learnStart(1);
+	Sim_advanceUs(GAP_MIN * 1000);
+	Wdt_clr();
+	Sim_advanceUs(GAP_MIN * 1000);
+	Wdt_learnStart(0);
+	Wdt_getLearn(&lrn);
+	Bench_chk(lrn.run && !lrn.applied && lrn.cnt == 0 && LPC_WWDT->TC == Wdt_msToCnt(WWDT_TIM_OUT)
+		&& LPC_WWDT->WINDOW == Wdt_msToCnt(WWDT_TIM_OUT - WWDT_TIM_GUARD), "wdtlearn: restart restores TC/WINDOW");
+	Bench_chk(!Wdt_learnApply(), "wdtlearn: apply without records");
+}
+
+/***************************************************************************
+	Bench_setClock
+	動作中のクロック切り替え
+
+	CLKIN端子(PIO0_1)は、メインクロックがCLKINを使う間だけ割り当てられ、
+	使わない構成に切り替えると外れて他の機能に使えること。
+***************************************************************************/
+static void Bench_setClock(void)
+{
+	static const struct {
+		const char	*name;
+		Sys_clk		clk;
+		_Bool		ok;
+	} tbl[] = {
+		{ "setClock IRC",			{ SYS_MAIN_CLK_IRC,		SYS_PLL_CLK_IRC,	1, 1 }, true },
+		{ "setClock PLL x2",		{ SYS_MAIN_CLK_PLLOUT,	SYS_PLL_CLK_IRC,	2, 1 }, true },
+		{ "setClock PLL x2 /2",		{ SYS_MAIN_CLK_PLLOUT,	SYS_PLL_CLK_IRC,	2, 2 }, true },
+		{ "setClock PLL x3 (NG)",	{ SYS_MAIN_CLK_PLLOUT,	SYS_PLL_CLK_IRC,	3, 1 }, false },
+		{ "setClock IRC /4",		{ SYS_MAIN_CLK_IRC,		SYS_PLL_CLK_IRC,	1, 4 }, true },
+		{ "setClock WDTOSC",		{ SYS_MAIN_CLK_WDTOSC,	SYS_PLL_CLK_IRC,	1, 1 }, true },
+		{ "setClock IRC, PLL CLKIN",	{ SYS_MAIN_CLK_IRC,		SYS_PLL_CLK_CLKIN,	1, 1 }, true },
+		{ "setClock CLKIN",			{ SYS_MAIN_CLK_PLLIN,	SYS_PLL_CLK_CLKIN,	1, 1 }, true },
+		{ "setClock back to IRC",	{ SYS_MAIN_CLK_IRC,		SYS_PLL_CLK_IRC,	1, 1 }, true }
+	};
+	uint32_t	i;
+	_Bool		ret, clkin;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	for (i = 0; i < sizeof(tbl) / sizeof(tbl[0]); i++) {
+		Sim_clrCnt();
+		ret = Sys_setClock(&tbl[i].clk);
+		Bench_report(tbl[i].name);
+		Bench_chk(ret == tbl[i].ok, tbl[i].name);
+		Bench_chk(Sim_getMainHz() == Sys_getMainClk() && Sim_getCoreHz() == Sys_getSysClk(),
+			"setClock: clocks match model");
+		Bench_chk(Bench_flashTimOk(), "setClock: minimum flash access time");
+		clkin = (tbl[i].clk.pllSel == SYS_PLL_CLK_CLKIN) && (tbl[i].clk.mainSel != SYS_MAIN_CLK_IRC)
+			&& (tbl[i].clk.mainSel != SYS_MAIN_CLK_WDTOSC);
+		Bench_chk(Swm_getPin(SWM_CLKIN) == (clkin? SWM_FIXED_PIN(SWM_CLKIN): SWM_ASSIGN_NONE),
+			"setClock: CLKIN assigned only while the main clock uses it");
+	}
+	Bench_chk(Swm_assign(SWM_U0_TXD, 1), "setClock: PIO0_1 free after leaving CLKIN");
+	Swm_release(SWM_U0_TXD);
+}
+
+/***************************************************************************
+	Bench_idle
+	Idle_runでの待機
+
+	SysTickを止めた状態でIdle_run(IDLE_FOREVER)を繰り返し、WDT満了や警
+	告割り込みが起きないことを確認する。
+	WDTを使わない構成では起床要因が無くなるので、IDLE_NOWDT_MS毎に起床
+	させる。
+	サンプル(main.c)の既定と同じく、SysTick, SCT, USART0を使っていない
+	ので、Sys_selPowerModeがスリープ以外を選ぶ構成(PLLのロック待ちが
+	IDLE_WAKE_USに収まる構成)では、待機時間のIDLE_DEEP_PCT(%)以上をディー
+	プスリープ・パワーダウンで過ごすことも確認する。
+***************************************************************************/
+static void Bench_idle(void)
+{
+	uint64_t	start, end, deep, total;
+	uint32_t	wakes = 0;
+	uint32_t	ms = ((WWDT_MODE & WWDT_WDEN) != 0)? IDLE_FOREVER: IDLE_NOWDT_MS;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Idle_ini();
+	SysTick->CTRL = 0;
+
+	start = Sim_getTimeUs();
+	deep = Sim_getDeepUs();
+	end = start + (uint64_t)IDLE_SIM_MS * 1000;
+	while (Sim_getTimeUs() < end && !Sim_isWdtReset() && Sim_getFault() == NULL) {
+		__disable_irq();
+		Idle_run(ms);
+		wakes++;
+	}
+	total = Sim_getTimeUs() - start;
+	deep = Sim_getDeepUs() - deep;
+	printf("%s: idle %u wake-ups in %u ms (deep-sleep %llu%%)\n", Bench_name, wakes, IDLE_SIM_MS,
+		(unsigned long long)(deep * 100 / total));
+	Bench_chk(!Sim_isWdtReset(), "idle: no WDT reset");
+	Bench_chk(Sim_getWdtWarn() == 0, "idle: no WDT warning");
+	if (Sys_selPowerMode(IDLE_WAKE_US) != SYS_PM_SLEEP) {
+		Bench_chk(deep * 100 >= total * IDLE_DEEP_PCT,
+			"idle: deep-sleep selected without SysTick");
+	}
+}
+
+/***************************************************************************
+	Bench_pmode
+	省電力モード
+
+	WKTで起床させて、ディープスリープ・パワーダウンの後にメインクロック
+	(PLLを使う構成ではロックし直し)がモデルと一致していること。
+	WDTを使う構成では、WDT用オシレータを止めていないこともモデルで確認
+	する。ディープパワーダウンは戻らない(モデルでは記録だけ)。
+	起床後にPLLがロックしない場合は、PLLのロックを1回だけ待って内蔵オシ
+	レータ(分周値はそのまま)に切り替わること(PLLを使わない構成では、先
+	にPLLに切り替えて確認する)。
+***************************************************************************/
+static void Bench_pmode(void)
+{
+	static const Sys_pmode	modes[] = {SYS_PM_DEEPSLEEP, SYS_PM_POWERDOWN};
+	static const Sys_clk	pllClk = { SYS_MAIN_CLK_PLLOUT, SYS_PLL_CLK_IRC, 2, 2 };	/* 24MHz / 2 */
+	uint64_t	start;
+	uint32_t	i;
+	_Bool		ok;
+	Sys_clk		clk;
+
+	Bench_chk(Sys_getWakeUs(SYS_PM_SLEEP) <= Sys_getWakeUs(SYS_PM_DEEPSLEEP)
+		&& Sys_getWakeUs(SYS_PM_DEEPSLEEP) <= Sys_getWakeUs(SYS_PM_POWERDOWN)
+		&& Sys_getWakeUs(SYS_PM_POWERDOWN) <= Sys_getWakeUs(SYS_PM_DPD), "pmode: wake time ordered");
+	Bench_chk(Sys_selPowerMode(0) == SYS_PM_SLEEP, "pmode: no budget selects sleep");
+	Bench_chk(Sys_selPowerMode(Sys_getWakeUs(SYS_PM_DEEPSLEEP)) == SYS_PM_DEEPSLEEP,
+		"pmode: deep-sleep budget selects deep-sleep");
+	Bench_chk(Sys_selPowerMode(UINT32_MAX) == SYS_PM_POWERDOWN, "pmode: never selects deep power-down");
+
+	for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+		Sim_reset(SYS_RST_POR);
+		Sys_iniLpc810();
+		Idle_ini();
+		SysTick->CTRL = 0;
+
+		LPC_WKT->CTRL = WKT_CLKSEL | WKT_CLEARCTR | WKT_ALARMFLAG;
+		LPC_WKT->COUNT = PMODE_WKT_CNT;
+		start = Sim_getTimeUs();
+		ok = Sys_enterPowerMode(modes[i]);
+		Bench_chk(ok && (Sim_getTimeUs() - start) >= (uint64_t)PMODE_WKT_CNT * 100,
+			(i == 0)? "pmode: deep-sleep woken by WKT": "pmode: power-down woken by WKT");
+		Bench_chk(Sim_getMainHz() == Sys_getMainClk() && Sim_getCoreHz() == Sys_getSysClk(),
+			(i == 0)? "pmode: clock restored after deep-sleep": "pmode: clock restored after power-down");
+	}
+
+	/* 起床後にPLLがロックしない */
+	for (i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+		Sim_reset(SYS_RST_POR);
+		Sys_iniLpc810();
+		Idle_ini();
+		SysTick->CTRL = 0;
+		Sys_getClock(&clk);
+		if (clk.mainSel != SYS_MAIN_CLK_PLLOUT) {
+			(void)Sys_setClock(&pllClk);
+			Sys_getClock(&clk);
+		}
+
+		LPC_WKT->CTRL = WKT_CLKSEL | WKT_CLEARCTR | WKT_ALARMFLAG;
+		LPC_WKT->COUNT = PMODE_WKT_CNT;
+		Sim_setPllFail(true);
+		start = Sim_getTimeUs();
+		ok = Sys_enterPowerMode(modes[i]);
+		Sim_setPllFail(false);
+		Bench_chk(!ok && (Sim_getTimeUs() - start) < (uint64_t)PMODE_WKT_CNT * 100 + PMODE_LOCK_US * 2,
+			(i == 0)? "pmode: PLL relock failure after deep-sleep waits once": "pmode: PLL relock failure after power-down waits once");
+		ok = (Sim_getMainHz() == IRC_HZ && Sim_getCoreHz() == Sys_getSysClk() && Sys_getMainClk() == IRC_HZ);
+		Sys_getClock(&clk);
+		Bench_chk(ok && clk.mainSel == SYS_MAIN_CLK_IRC && Sim_getCoreHz() == IRC_HZ / clk.div,
+			(i == 0)? "pmode: falls back to IRC after deep-sleep": "pmode: falls back to IRC after power-down");
+		Bench_chk(Bench_flashTimOk(), "pmode: minimum flash access time after fallback");
+
+		LPC_WKT->CTRL = WKT_CLKSEL | WKT_CLEARCTR | WKT_ALARMFLAG;
+		LPC_WKT->COUNT = PMODE_WKT_CNT;
+		start = Sim_getTimeUs();
+		ok = Sys_enterPowerMode(modes[i]);
+		Bench_chk(ok && (Sim_getTimeUs() - start) < (uint64_t)PMODE_WKT_CNT * 100 + PMODE_LOCK_US,
+			"pmode: no PLL wait after fallback");
+	}
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Bench_chk(!Sys_enterPowerMode(SYS_PM_DPD) && Sim_isDpd(), "pmode: deep power-down entered");
+}
+
+/***************************************************************************
+	Bench_pllFail
+	PLLがロックしない場合の起動とクロック切り替え
+
+	切り替えでは、内蔵オシレータ(分周値は指定通り)に切り替わり、
+	Sys_getClockもそれを返すこと。システムクロックは同じ(6MHz)でもメイ
+	ンクロックは変わるので、通知関数(Iocon_procClk)が呼ばれること。
+***************************************************************************/
+static void Bench_pllFail(void)
+{
+	enum {
+		FILT_US		= 8		/* us; 通知の確認に使う入力フィルタのクロック周期 */
+	};
+	static const Sys_clk	clk[] = {
+		{ SYS_MAIN_CLK_PLLOUT,	SYS_PLL_CLK_IRC,	2, 4 },	/* 24MHz / 4 */
+		{ SYS_MAIN_CLK_PLLOUT,	SYS_PLL_CLK_IRC,	2, 2 }	/* 24MHz / 2(ロックしない) */
+	};
+	const Sys_bootTim	*tim;
+	Sys_clk				cur;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Bench_chk(Sys_setClock(&clk[0]), "pllFail: switch to PLL");
+	(void)Iocon_setSampleUs(0, FILT_US);
+	Sim_setPllFail(true);
+	Bench_chk(!Sys_setClock(&clk[1]), "pllFail: switch fails without lock");
+	Sim_setPllFail(false);
+	Sys_getClock(&cur);
+	Bench_chk(cur.mainSel == SYS_MAIN_CLK_IRC && cur.div == clk[1].div, "pllFail: Sys_getClock reports IRC");
+	Bench_chk(Sim_getMainHz() == IRC_HZ && Sim_getCoreHz() == Sys_getSysClk(), "pllFail: switch falls back to IRC");
+	Bench_chk(Bench_flashTimOk(), "pllFail: minimum flash access time after switch");
+	Bench_chk(LPC_SYSCON->IOCONCLKDIV[IOCON_CLKDIV_NUM - 1] == (FILT_US * IRC_HZ + 999999) / 1000000,
+		"pllFail: clock notified on main clock change");
+	Iocon_setClkDiv(0, 0);
+
+	if ((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) != SYS_MAIN_CLK_PLLOUT) {
+		return;
+	}
+	Sim_reset(SYS_RST_POR);
+	Sim_setPllFail(true);
+	Sys_iniLpc810();
+	Sim_setPllFail(false);
+
+	Bench_chk(Bench_flashTimOk(), "pllFail: minimum flash access time");
+	tim = Sys_getBootTim();
+	Bench_chk(!tim->pllOk, "pllFail: failure recorded");
+	Bench_chk(Sys_getMainClk() == IRC_HZ && Sim_getMainHz() == IRC_HZ, "pllFail: falls back to IRC");
+	Bench_chk(Sim_getCoreHz() == Sys_getSysClk(), "pllFail: system clock matches model");
+}
+
+/***************************************************************************
+	Bench_rstInfo
+	リセット要因の記録
+
+	.noinitの変数はSim_resetで消えないので、続けてWDTリセットを起こせば
+	前回の記録に加算されていること。
+***************************************************************************/
+static void Bench_rstInfo(void)
+{
+	uint32_t	wdt;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	wdt = Sys_getRstInfo()->cnt[RST_WDT_BIT];
+	Sim_reset(SYS_RST_WDT);
+	Sys_iniLpc810();
+	Bench_chk(Sys_getRstInfo()->cause == SYS_RST_WDT, "rstInfo: cause is WDT");
+	Bench_chk(Sys_getRstInfo()->cnt[RST_WDT_BIT] == wdt + 1, "rstInfo: WDT reset counted across reset");
+}
+
+/***************************************************************************
+	Bench_clkGate
+	クロック供給の参照数
+
+	参照数の確認には、どのライブラリも使っていないCRCのクロックを使う。
+	Mrt_libはProf_libがまだ使っていない(Bench_profの前)ので、Wdt_calOsc
+	の後はMRTのクロックが止まっていること。
+***************************************************************************/
+static void Bench_clkGate(void)
+{
+	uint32_t	i;
+	const char	*fault;
+	_Bool		trap;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Bench_chk((LPC_SYSCON->SYSAHBCLKCTRL & (SYS_AHB_CLK_SWM | SYS_AHB_CLK_IOCON)) == 0,
+		"clkGate: SWM, IOCON gated after boot");
+	(void)Wdt_calOsc();
+	Bench_chk((LPC_SYSCON->SYSAHBCLKCTRL & SYS_AHB_CLK_MRT) == 0, "clkGate: MRT gated after Wdt_calOsc");
+
+	Bench_chk(Sys_acqClk(SYS_AHB_CLK_CRC, 0) && (LPC_SYSCON->SYSAHBCLKCTRL & SYS_AHB_CLK_CRC) != 0,
+		"clkGate: first acquire starts clock");
+	Bench_chk(!Sys_acqClk(SYS_AHB_CLK_CRC, 0), "clkGate: second acquire does not restart");
+	Sys_relClk(SYS_AHB_CLK_CRC);
+	Bench_chk((LPC_SYSCON->SYSAHBCLKCTRL & SYS_AHB_CLK_CRC) != 0, "clkGate: clock kept while referenced");
+	Sys_relClk(SYS_AHB_CLK_CRC);
+	Bench_chk((LPC_SYSCON->SYSAHBCLKCTRL & SYS_AHB_CLK_CRC) == 0, "clkGate: last release gates clock");
+	Sys_relClk(SYS_AHB_CLK_CRC);
+	Bench_chk(Sys_acqClk(SYS_AHB_CLK_CRC, 0), "clkGate: extra release does not underflow");
+	Sys_relClk(SYS_AHB_CLK_CRC);
+	Sys_relClk(SYS_AHB_CLK_SYS);
+	Bench_chk((LPC_SYSCON->SYSAHBCLKCTRL & SYS_AHB_CLK_SYS) != 0, "clkGate: fixed clocks never gated");
+
+	/* 参照数の上限: 数えずに続けず停止する(BKPT) */
+	for (i = 0; i < UINT8_MAX; i++) {
+		(void)Sys_acqClk(SYS_AHB_CLK_CRC, 0);
+	}
+	Bench_chk(Sim_getFault() == NULL, "clkGate: acquire up to the reference limit");
+	(void)Sys_acqClk(SYS_AHB_CLK_CRC, 0);
+	fault = Sim_getFault();
+	trap = (fault != NULL) && (strcmp(fault, "BKPT executed") == 0);
+	Sim_reset(SYS_RST_POR);		/* 誤操作の記録を消す */
+	Bench_chk(trap, "clkGate: acquire over the limit traps");
+}
+
+/***************************************************************************
+	Bench_gpio
+	GPIOのインライン関数
+
+	出力ピン(DIR0)だけが変化し、どの操作もGPIOの参照1回で済むこと。
+***************************************************************************/
+static void Bench_gpio(void)
+{
+	enum {
+		OUT_A	= 0,	/* PIO0_0(出力) */
+		OUT_B	= 5,	/* PIO0_5(出力) */
+		OUT_C	= 2,	/* PIO0_2(出力、マスク対象外) */
+		IN_A	= 4		/* PIO0_4(入力) */
+	};
+	const uint32_t	outs = GPIO_BIT(OUT_A) | GPIO_BIT(OUT_B) | GPIO_BIT(OUT_C);
+	Sim_cnt			cnt;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Bench_iniPort();
+	LPC_GPIO_PORT->DIR0 = outs;
+
+	Gpio_clr(outs);
+	Bench_chk(!Gpio_rdPin(OUT_A) && !Gpio_rdPin(OUT_B) && !Gpio_rdPin(OUT_C), "gpio: Gpio_clr");
+	Gpio_set(GPIO_BIT(OUT_A) | GPIO_BIT(OUT_B));
+	Bench_chk(Gpio_rdPin(OUT_A) && Gpio_rdPin(OUT_B) && !Gpio_rdPin(OUT_C), "gpio: Gpio_set");
+
+	Sim_clrCnt();
+	Gpio_tgl(GPIO_BIT(OUT_A));
+	Sim_getCnt(&cnt);
+	Bench_report("Gpio_tgl");
+	Bench_chk(cnt.acc[SIM_GPIO] == 1 && cnt.total == 1, "gpio: toggle is one access");
+	Bench_chk(!Gpio_rdPin(OUT_A) && Gpio_rdPin(OUT_B), "gpio: Gpio_tgl");
+
+	Gpio_wrPin(OUT_C, true);
+	Bench_chk(Gpio_rdPin(OUT_C) && Gpio_rdPinW(OUT_C) == 0xFFFFFFFF, "gpio: Gpio_wrPin high");
+	Gpio_wrPin(OUT_C, false);
+	Bench_chk(!Gpio_rdPin(OUT_C) && Gpio_rdPinW(OUT_C) == 0, "gpio: Gpio_wrPin low");
+
+	Sim_setPin(IN_A, false);
+	Gpio_set(GPIO_BIT(IN_A));
+	Gpio_wrPin(IN_A, true);
+	Bench_chk(!Gpio_rdPin(IN_A), "gpio: input pin not driven");
+	Sim_setPin(IN_A, true);
+	Bench_chk(Gpio_rdPin(IN_A), "gpio: input pin read");
+
+	/* OUT_A, OUT_Bだけを一括出力(OUT_Cは1を書いても変化しない) */
+	Gpio_setMask(GPIO_BIT(OUT_A) | GPIO_BIT(OUT_B));
+	Sim_clrCnt();
+	Gpio_wrMasked(GPIO_BIT(OUT_A) | GPIO_BIT(OUT_C));
+	Sim_getCnt(&cnt);
+	Bench_report("Gpio_wrMasked");
+	Bench_chk(cnt.acc[SIM_GPIO] == 1 && cnt.total == 1, "gpio: masked write is one access");
+	Bench_chk(Gpio_rdPin(OUT_A) && !Gpio_rdPin(OUT_B) && !Gpio_rdPin(OUT_C), "gpio: Gpio_wrMasked");
+	Bench_chk(Gpio_rdMasked() == GPIO_BIT(OUT_A), "gpio: Gpio_rdMasked");
+	Gpio_wrMasked(GPIO_BIT(OUT_B));
+	Bench_chk(!Gpio_rdPin(OUT_A) && Gpio_rdPin(OUT_B) && !Gpio_rdPin(OUT_C), "gpio: Gpio_wrMasked again");
+}
+
+/***************************************************************************
+	Bench_swm
+	スイッチマトリクスのピン配置
+
+	ピン配置表のビルド時チェック(SWM_MAP_*)は、正しい表と誤った表のそれ
+	ぞれで結果を_Static_assertで確かめる(誤った表をcore.hに書くとビルド
+	エラーになる)。
+	Swm_iniは、リセット直後はPINENABLE0とCTOUT_0(LED_BLINK)のPINASSIGN
+	だけを書き、2回目は何も書かないこと(PINASSIGN0～8, PINENABLE0を読む
+	だけ)。
+	CLKINは表に無く、起動時のメインクロックがCLKINを使う構成でだけ
+	Sys_iniLpc810が割り当てること。
+***************************************************************************/
+#define	BENCH_SWM_OK(X)		X(SWM_U0_TXD, 4) X(SWM_U0_RXD, 0) X(SWM_SWCLK, 3) X(SWM_CLKIN, 1)
+#define	BENCH_SWM_PIN2(X)	X(SWM_U0_TXD, 4) X(SWM_CTOUT_0, 4)
+#define	BENCH_SWM_FUNC2(X)	X(SWM_U0_TXD, 4) X(SWM_U0_TXD, 0)
+#define	BENCH_SWM_FIXPIN(X)	X(SWM_CLKIN, 2)
+#define	BENCH_SWM_NOPIN(X)	X(SWM_U0_TXD, 6)
+
+/* 起動時のクロック構成がCLKIN端子を使うか(メインクロックがPLL入力・出力で、PLL入力がCLKIN) */
+#define	BENCH_BOOT_CLKIN	\
+	((((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLIN) || ((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLOUT)) \
+	 && ((SYS_PLL_CLK & SYS_PLL_CLK_SEL) == SYS_PLL_CLK_CLKIN))
+
+_Static_assert(SWM_MAP_PIN_UNIQUE(BENCH_SWM_OK) && SWM_MAP_FUNC_UNIQUE(BENCH_SWM_OK)
+	&& SWM_MAP_PIN_VALID(BENCH_SWM_OK), "swm: valid map accepted");
+_Static_assert(!SWM_MAP_PIN_UNIQUE(BENCH_SWM_PIN2), "swm: pin conflict detected");
+_Static_assert(!SWM_MAP_FUNC_UNIQUE(BENCH_SWM_FUNC2), "swm: duplicate function detected");
+_Static_assert(!SWM_MAP_PIN_VALID(BENCH_SWM_FIXPIN), "swm: misplaced fixed function detected");
+_Static_assert(!SWM_MAP_PIN_VALID(BENCH_SWM_NOPIN), "swm: pin not on LPC810 detected");
+
+static void Bench_swm(void)
+{
+	Sim_cnt		cnt;
+
+	Sim_reset(SYS_RST_POR);
+	Sim_clrCnt();
+	Swm_ini();
+	Sim_getCnt(&cnt);
+	Bench_report("Swm_ini after reset");
+	Bench_chk(cnt.acc[SIM_SWM] == SWM_PINASSIGN_NUM + 3, "swm: only PINENABLE0 and CTOUT_0 written after reset");
+	Sim_clrCnt();
+	Swm_ini();
+	Sim_getCnt(&cnt);
+	Bench_chk(cnt.acc[SIM_SWM] == SWM_PINASSIGN_NUM + 1, "swm: nothing written when unchanged");
+	Sys_iniLpc810();
+
+	Bench_chk(Swm_getPin(SWM_SWCLK) == 3 && Swm_getPin(SWM_SWDIO) == 2 && Swm_getPin(SWM_CTOUT_0) == 0,
+		"swm: SWM_PIN_MAP applied");
+	Bench_chk(Swm_getPin(SWM_CLKIN) == (BENCH_BOOT_CLKIN? SWM_FIXED_PIN(SWM_CLKIN): SWM_ASSIGN_NONE),
+		"swm: CLKIN assigned only when the main clock uses it");
+	Bench_chk(Swm_getPin(SWM_RESET) == SWM_ASSIGN_NONE, "swm: RESET released (not in map)");
+
+	/* USART0を空きピン(PIO0_4)に割り当てて付け替える */
+	Bench_chk(Swm_assign(SWM_U0_TXD, 4) && Swm_getFunc(4) == SWM_U0_TXD, "swm: assign U0_TXD");
+	Bench_chk(!Swm_assign(SWM_U0_RXD, 4), "swm: pin in use rejected");
+	Bench_chk(!Swm_assign(SWM_U0_RXD, 3), "swm: pin of fixed function rejected");
+	Bench_chk(!Swm_assign(SWM_U0_RXD, 0), "swm: pin in map (CTOUT_0) rejected");
+	Bench_chk(Swm_assign(SWM_U0_TXD, 5) && Swm_getFunc(4) == SWM_FUNC_NONE && Swm_getPin(SWM_U0_TXD) == 5,
+		"swm: U0_TXD moved");
+	Swm_release(SWM_U0_TXD);
+	Bench_chk(Swm_getPin(SWM_U0_TXD) == SWM_ASSIGN_NONE && Swm_getFunc(5) == SWM_FUNC_NONE, "swm: U0_TXD released");
+
+	Bench_chk(!Swm_assign(SWM_CLKIN, 2) && !Swm_assign(SWM_U0_TXD, SWM_PIN_NUM), "swm: invalid pin rejected");
+	Bench_chk(Swm_assign(SWM_RESET, 5) && Swm_getFunc(5) == SWM_RESET, "swm: assign fixed RESET");
+	Swm_release(SWM_RESET);
+	Bench_chk(Swm_getPin(SWM_RESET) == SWM_ASSIGN_NONE, "swm: RESET released");
+	Bench_chk((LPC_SYSCON->SYSAHBCLKCTRL & SYS_AHB_CLK_SWM) == 0, "swm: SWM clock gated after use");
+}
+
+/***************************************************************************
+	Bench_iocon
+	ピン設定と入力フィルタ
+
+	IRCとPLL(2逓倍)で、フィルタのクロック周期を指定した入力フィルタが同じ
+	長さのパルスを除くことを確かめる。
+***************************************************************************/
+static void Bench_iocon(void)
+{
+	enum {
+		FILT_PIN	= 4,	/* PIO0_4(IN_PORT) */
+		FREE_PIN	= 0,	/* PIO0_0(フィルタなし) */
+		FILT_US		= 8,	/* us; フィルタのクロック周期 */
+		FILT_CLK	= 3,	/* フィルタのクロック数(IOCON_S_MODE_3CLOCK) */
+		LONG_US		= 100,	/* us; 分周値が範囲外になる周期 */
+		RSV_BIT		= 0x80	/* PIO0_4の予約ビット(リセット値で1) */
+	};
+	static const Sys_clk	clk[] = {
+		{ SYS_MAIN_CLK_IRC,		SYS_PLL_CLK_IRC,	1, 1 },
+		{ SYS_MAIN_CLK_PLLOUT,	SYS_PLL_CLK_IRC,	2, 1 }
+	};
+	const uint32_t	cfg = IOCON_MODE_PULL_UP | IOCON_HYS_ON | IOCON_S_MODE_3CLOCK | IOCON_CLK_DIV0;
+	uint32_t		i, div;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	(void)Sys_setClock(&clk[0]);
+
+	Bench_chk(Iocon_getPin(FILT_PIN) == IOCON_MODE_PULL_UP, "iocon: reset value (pull-up)");
+	Bench_chk(Iocon_setSampleUs(0, FILT_US), "iocon: sample period set");
+	Sim_clrCnt();
+	Iocon_setPin(FILT_PIN, cfg);
+	Bench_report("Iocon_setPin");
+	(void)Sys_acqClk(SYS_AHB_CLK_IOCON, 0);
+	Bench_chk(LPC_IOCON->PIO0_4 == (RSV_BIT | cfg), "iocon: pin config written, reserved bit kept");
+	Sys_relClk(SYS_AHB_CLK_IOCON);
+	Bench_chk(Iocon_getPin(FILT_PIN) == cfg, "iocon: pin config read back");
+	Bench_chk(LPC_SYSCON->IOCONCLKDIV[0] == 0, "iocon: IOCONCLKDIV6 untouched");
+
+	for (i = 0; i < sizeof(clk) / sizeof(clk[0]); i++) {
+		if (i != 0) {
+			(void)Sys_setClock(&clk[i]);
+		}
+		div = (uint32_t)(((uint64_t)FILT_US * Sim_getMainHz() + 999999) / 1000000);
+		Bench_chk(LPC_SYSCON->IOCONCLKDIV[IOCON_CLKDIV_NUM - 1] == div, "iocon: IOCONCLKDIV0 from period");
+		Bench_chk(!Sim_pulsePin(FILT_PIN, false, FILT_US * FILT_CLK - 1), "iocon: short pulse rejected");
+		Bench_chk(Sim_pulsePin(FILT_PIN, false, FILT_US * FILT_CLK), "iocon: long pulse passed");
+		Bench_chk(Gpio_rdPin(FILT_PIN), "iocon: level restored after pulse");
+	}
+	Bench_chk(Sim_pulsePin(FREE_PIN, false, 1), "iocon: unfiltered pin passes any pulse");
+
+	/* 分周値の範囲外(最大値にする) */
+	Bench_chk(!Iocon_setSampleUs(1, LONG_US) && LPC_SYSCON->IOCONCLKDIV[IOCON_CLKDIV_NUM - 2] == IOCON_CLKDIV_MAX,
+		"iocon: period out of range clamped");
+	Iocon_setClkDiv(1, 0);
+	Bench_chk(LPC_SYSCON->IOCONCLKDIV[IOCON_CLKDIV_NUM - 2] == 0, "iocon: divider set directly");
+
+	Iocon_setPin(FILT_PIN, IOCON_MODE_PULL_UP);
+	(void)Sys_acqClk(SYS_AHB_CLK_IOCON, 0);
+	Bench_chk(LPC_IOCON->PIO0_4 == (RSV_BIT | IOCON_MODE_PULL_UP), "iocon: pin config restored");
+	Sys_relClk(SYS_AHB_CLK_IOCON);
+	Bench_chk((LPC_SYSCON->SYSAHBCLKCTRL & SYS_AHB_CLK_IOCON) == 0, "iocon: IOCON clock gated after use");
+}
+
+/***************************************************************************
+	Bench_sct
+	SCTのPWM・点滅出力
+
+	CTOUT_0をPIO0_0、CTOUT_1をPIO0_4に割り当て、1us毎にピンを読んでH時
+	間と周期(立ち上がりの回数)を数える。
+***************************************************************************/
+static void Bench_sct(void)
+{
+	enum {
+		PWM_PIN		= 0,	/* PIO0_0(CTOUT_0) */
+		BLINK_PIN	= 4,	/* PIO0_4(CTOUT_1) */
+		PERIOD_US	= 1000,	/* us; 周期 */
+		HIGH_US		= 250,	/* us; PWMのH時間 */
+		HIGH2_US	= 750,	/* us; 変更後のPWMのH時間 */
+		PERIODS		= 4,	/* 数える周期の数 */
+		TOL_US		= 2		/* us; 1周期当たりの許容誤差(サンプリング間隔) */
+	};
+	static const Sys_clk	clk[] = {
+		{ SYS_MAIN_CLK_IRC,		SYS_PLL_CLK_IRC,	1, 1 },
+		{ SYS_MAIN_CLK_PLLOUT,	SYS_PLL_CLK_IRC,	2, 1 }
+	};
+	static const uint32_t	blink[] = { 100, 200, 300 };	/* us; 2回点滅(計200us) */
+	Sim_cnt		cnt;
+	uint32_t	i, high, rise;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	(void)Sys_setClock(&clk[0]);
+	Bench_iniPort();
+	Bench_chk(Swm_assign(SWM_CTOUT_0, PWM_PIN) && Swm_assign(SWM_CTOUT_1, BLINK_PIN), "sct: assign CTOUT_0, CTOUT_1");
+
+	Sim_clrCnt();
+	Bench_chk(Sct_ini(PERIOD_US) && Sct_setPwm(0, HIGH_US), "sct: start PWM");
+	Bench_report("Sct_ini, Sct_setPwm");
+	for (i = 0; i < sizeof(clk) / sizeof(clk[0]); i++) {
+		if (i != 0) {
+			(void)Sys_setClock(&clk[i]);
+		}
+		high = Bench_sctHighUs(PWM_PIN, PERIOD_US * PERIODS, &rise);
+		Bench_chk(high + TOL_US * PERIODS >= HIGH_US * PERIODS && high <= HIGH_US * PERIODS + TOL_US * PERIODS,
+			"sct: PWM high time");
+		Bench_chk(rise + 1 >= PERIODS && rise <= PERIODS, "sct: PWM period");
+	}
+
+	/* 点滅パターン(変化点3つ、PWMと合わせてSCT_EDGE_MAX) */
+	Bench_chk(Sct_setBlink(1, blink, sizeof(blink) / sizeof(blink[0])), "sct: start blink");
+	high = Bench_sctHighUs(BLINK_PIN, PERIOD_US * PERIODS, &rise);
+	Bench_chk(high + TOL_US * PERIODS >= 200 * PERIODS && high <= 200 * PERIODS + TOL_US * PERIODS,
+		"sct: blink high time");
+	Bench_chk(rise + 2 >= 2 * PERIODS && rise <= 2 * PERIODS, "sct: blink twice per period");
+	Bench_chk(!Sct_setPwm(2, HIGH_US), "sct: edges exhausted rejected");
+	Bench_chk(Sct_setPwm(2, PERIOD_US), "sct: constant high needs no edge");
+
+	/* デューティの変更はMATCHRELの書き込みだけ */
+	Sim_clrCnt();
+	Bench_chk(Sct_setPwm(0, HIGH2_US), "sct: change duty");
+	Sim_getCnt(&cnt);
+	Bench_report("Sct_setPwm (duty)");
+	Bench_chk(cnt.acc[SIM_SCT] == 1, "sct: duty change writes MATCHREL only");
+	high = Bench_sctHighUs(PWM_PIN, PERIOD_US * PERIODS, &rise);
+	Bench_chk(high + TOL_US * PERIODS >= HIGH2_US * PERIODS && high <= HIGH2_US * PERIODS + TOL_US * PERIODS,
+		"sct: PWM high time after duty change");
+	Bench_chk(Sct_setPwm(0, 0) && Bench_sctHighUs(PWM_PIN, PERIOD_US * PERIODS, &rise) == 0, "sct: zero duty is low");
+	Bench_chk(LPC_SCT->EVEN == 0, "sct: no interrupt used");
+
+	Sct_stop();
+	Bench_chk((LPC_SYSCON->SYSAHBCLKCTRL & SYS_AHB_CLK_SCT) == 0, "sct: SCT clock gated after stop");
+	Bench_chk(!Gpio_rdPin(BLINK_PIN), "sct: output low after stop");
+	Swm_release(SWM_CTOUT_0);
+	Swm_release(SWM_CTOUT_1);
+}
+
+/* ピンのH時間(us)と立ち上がりの回数(約1us毎に読み、読み出し時間の分は按分する) */
+static uint32_t Bench_sctHighUs(uint32_t pin, uint32_t us, uint32_t *rise)
+{
+	uint64_t	end = Sim_getTimeUs() + us;
+	uint32_t	num = 0, high = 0;
+	_Bool		lv, prev = Gpio_rdPin(pin);
+
+	*rise = 0;
+	while (Sim_getTimeUs() < end) {
+		Sim_advanceUs(1);
+		lv = Gpio_rdPin(pin);
+		high += lv? 1: 0;
+		*rise += (lv && !prev)? 1: 0;
+		prev = lv;
+		num++;
+	}
+	return (uint32_t)(((uint64_t)high * us + num / 2) / num);
+}
+
+/***************************************************************************
+	Bench_pint
+	ピン割り込み
+
+	Pint_libの登録は取り消せないので、チャネル0(エッジ)と1(レベル)を
+	1回だけ登録して確認する。
+***************************************************************************/
+static void Bench_pint(void)
+{
+	enum {
+		EDGE_PIN	= 4,	/* PIO0_4 */
+		LEVEL_PIN	= 1		/* PIO0_1 */
+	};
+	uint32_t	edge, level;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	Sim_setPin(LEVEL_PIN, false);		/* 登録前からLレベル */
+
+	Sim_clrCnt();
+	edge = Pint_add(EDGE_PIN, PINT_EDGE_FALL, Bench_pintFunc);
+	Bench_report("Pint_add edge");
+	Sim_clrCnt();
+	level = Pint_add(LEVEL_PIN, PINT_LEVEL_LOW, Bench_pintFunc);
+	Bench_report("Pint_add level");
+	Bench_chk(edge == 0 && level == 1, "pint: channels assigned in order");
+
+	/* レベル: 登録時にLレベルなら1回だけ検出して停止 */
+	Sim_advanceUs(1000);
+	Bench_chk(Bench_pintCnt[0] == 1, "pint: level detected once while held");
+	Sim_setPin(LEVEL_PIN, true);
+	Pint_start(level);
+	Sim_advanceUs(1000);
+	Bench_chk(Bench_pintCnt[0] == 1, "pint: level re-armed without detection");
+	Sim_setPin(LEVEL_PIN, false);
+	Bench_chk(Bench_pintCnt[0] == 2, "pint: level detected after re-arm");
+	Sim_setPin(LEVEL_PIN, true);
+
+	/* エッジ: 立ち下がりのみ */
+	Bench_pintCnt[0] = 0;
+	Bench_pintCnt[1] = 0;
+	Sim_setPin(EDGE_PIN, false);
+	Sim_setPin(EDGE_PIN, true);
+	Sim_setPin(EDGE_PIN, false);
+	Bench_chk(Bench_pintCnt[0] == 2 && Bench_pintCnt[1] == 0, "pint: falling edges only");
+	Pint_stop(edge);
+	Sim_setPin(EDGE_PIN, true);
+	Sim_setPin(EDGE_PIN, false);
+	Bench_chk(Bench_pintCnt[0] == 2, "pint: no detection while stopped");
+	Bench_chk((LPC_SYSCON->STARTERP0 & 0x3) == 0x3, "pint: deep-sleep wake-up enabled");
+}
+
+/* ピン割り込みの登録関数 */
+static void Bench_pintFunc(uint32_t ch, _Bool rise)
+{
+	Bench_pintCnt[rise? 1: 0]++;
+}
+
+/***************************************************************************
+	Bench_evt
+	イベントキュー
+
+	Evt_libの登録は取り消せないので、キュー2本とイベント番号0, 1を1回だけ
+	登録して確認する。Evt_postは割り込み処理の代わりに直接呼び出す。
+***************************************************************************/
+static void Bench_evt(void)
+{
+	uint32_t	i;
+	_Bool		ok;
+
+	Bench_chk(Evt_addQue(&Bench_que[0]) && Evt_addQue(&Bench_que[1]), "evt: queues added");
+	Bench_chk(Evt_setFunc(0, Bench_evtFunc0) && Evt_setFunc(1, Bench_evtFunc1), "evt: funcs set");
+	Bench_chk(!Evt_setFunc(EVT_ID_MAX, Bench_evtFunc0), "evt: id out of range rejected");
+	Bench_chk(Evt_isEmpty() && Evt_run() == 0, "evt: empty at start");
+
+	/* 順序と引数: キューの登録順、キュー内は古い順 */
+	Evt_post(&Bench_que[1], 1, 0x22);
+	Evt_post(&Bench_que[0], 0, 0x10);
+	Evt_post(&Bench_que[0], 1, 0x11);
+	Bench_chk(!Evt_isEmpty(), "evt: not empty after post");
+	Bench_evtNum = 0;
+	Bench_chk(Evt_run() == 3, "evt: all events run");
+	Bench_chk(Bench_evtNum == 3 && Bench_evtLog[0] == 0x010 && Bench_evtLog[1] == 0x111
+	 && Bench_evtLog[2] == 0x122, "evt: order and args kept");
+	Bench_chk(Evt_isEmpty(), "evt: empty after run");
+
+	/* 満杯: EVT_QUE_SIZEを超えた分は捨てて数える */
+	ok = true;
+	for (i = 0; i < EVT_QUE_SIZE; i++) {
+		ok = ok && Evt_post(&Bench_que[0], 1, i);
+	}
+	Bench_chk(ok && !Evt_post(&Bench_que[0], 1, 0), "evt: full queue rejects post");
+	Bench_chk(!Evt_post(&Bench_que[1], 1, EVT_ARG_MAX + 1), "evt: arg out of range rejected");
+	Bench_chk(Bench_que[0].lost == 1 && Bench_que[1].lost == 1, "evt: lost counted");
+	Bench_evtNum = 0;
+	Bench_chk(Evt_run() == EVT_QUE_SIZE && Bench_evtLog[EVT_QUE_SIZE - 1] == 0x100 + EVT_QUE_SIZE - 1,
+		"evt: full queue drained in order");
+
+	/* 処理中に積まれたイベントは次回のEvt_runで処理する */
+	Evt_post(&Bench_que[0], 0, 1);
+	Bench_evtNum = 0;
+	Bench_chk(Evt_run() == 1 && !Evt_isEmpty(), "evt: event posted while running deferred");
+	Bench_chk(Evt_run() == 1 && Evt_isEmpty() && Bench_evtNum == 2, "evt: deferred event run next");
+}
+
+/* イベント番号0の処理関数(引数が1なら処理中にもう1つ積む) */
+static void Bench_evtFunc0(uint32_t arg)
+{
+	Bench_evtLog[Bench_evtNum++] = arg;
+	if (arg == 1) {
+		Evt_post(&Bench_que[0], 0, 0);
+	}
+}
+
+/* イベント番号1の処理関数 */
+static void Bench_evtFunc1(uint32_t arg)
+{
+	Bench_evtLog[Bench_evtNum++] = 0x100 | arg;
+}
+
+/***************************************************************************
+	Bench_uart
+	USART0
+
+	クロックを切り替えながら、Uart_libの求めた伝送速度がモデルと一致し、
+	誤差がUART_ERR_MAX_PPM以内であることを確認する。設定できないクロック
+	(WDTOSCなど)ではUSART0が止まっていること。
+	送信はUart_sendがすぐに戻り、割り込みで全バイトが順に送られること、
+	受信は割り込みで受信バッファに入り、溢れた分が数えられることを確認す
+	る。
+***************************************************************************/
+static void Bench_uart(void)
+{
+	static const struct {
+		const char	*name;
+		Sys_clk		clk;
+	} tbl[] = {
+		{ "uart at PLL x2",		{ SYS_MAIN_CLK_PLLOUT,	SYS_PLL_CLK_IRC,	2, 1 } },
+		{ "uart at WDTOSC",		{ SYS_MAIN_CLK_WDTOSC,	SYS_PLL_CLK_IRC,	1, 1 } },
+		{ "uart at IRC",		{ SYS_MAIN_CLK_IRC,		SYS_PLL_CLK_IRC,	1, 1 } }
+	};
+	static const char	msg[] = "0123456789abcdef";
+	uint8_t		buf[UART_TX_SIZE * 2];
+	uint32_t	i, num, baud;
+	uint64_t	err;
+	Sim_cnt		cnt;
+	Uart_stat	stat;
+	_Bool		ok;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+	(void)Sys_setClock(&tbl[sizeof(tbl) / sizeof(tbl[0]) - 1].clk);	/* IRCから始める */
+
+	Sim_clrCnt();
+	ok = Uart_ini(UART_BAUD);
+	Bench_report("Uart_ini");
+	Bench_chk(ok, "uart: ini at IRC");
+
+	/* 伝送速度: 初期化時とクロック変更時 */
+	for (i = 0; i <= sizeof(tbl) / sizeof(tbl[0]); i++) {
+		if (i != 0) {
+			Sim_clrCnt();
+			(void)Sys_setClock(&tbl[i - 1].clk);
+			Bench_report(tbl[i - 1].name);
+		}
+		baud = Uart_getBaud();
+		Bench_chk(baud == Sim_getUartBaud(), "uart: baud matches model");
+		if (baud != 0) {
+			err = (baud > UART_BAUD)? baud - UART_BAUD: UART_BAUD - baud;
+			printf("%s: uart %u bps at %u Hz -> %u bps (%llu ppm)\n", Bench_name, UART_BAUD,
+				Sys_getMainClk(), baud, (unsigned long long)(err * 1000000 / UART_BAUD));
+			Bench_chk(err * 1000000 <= (uint64_t)UART_ERR_MAX_PPM * UART_BAUD, "uart: baud error");
+		}
+		else {
+			printf("%s: uart %u bps at %u Hz -> stopped\n", Bench_name, UART_BAUD, Sys_getMainClk());
+		}
+	}
+	Bench_chk(Uart_getBaud() != 0, "uart: running at IRC");
+
+	/* 送信: Uart_sendは1バイトの送信時間より短く戻り、全バイトが順に出る */
+	Sim_clrCnt();
+	num = Uart_send(msg, sizeof(msg) - 1);
+	Bench_report("Uart_send 16 bytes");
+	Sim_getCnt(&cnt);
+	Bench_chk(num == sizeof(msg) - 1, "uart: send queued all");
+	Bench_chk(cnt.ps * UART_BAUD < 10 * 1000000000000ULL, "uart: send does not wait for transmission");
+	Bench_chk(Bench_uartFlush(), "uart: transmission completes");
+	num = Sim_uartTx(buf, sizeof(buf));
+	Bench_chk(num == sizeof(msg) - 1 && memcmp(buf, msg, num) == 0, "uart: bytes sent in order");
+
+	/* 送信バッファ溢れ */
+	memset(buf, 'x', sizeof(buf));
+	__disable_irq();		/* 割り込みで送り始める前に詰める */
+	num = Uart_send(buf, sizeof(buf));
+	__enable_irq();
+	Bench_chk(num == UART_TX_SIZE, "uart: send stops at buffer size");
+	Bench_chk(Bench_uartFlush() && Sim_uartTx(buf, sizeof(buf)) == UART_TX_SIZE, "uart: full buffer sent");
+
+	/* 受信 */
+	Sim_uartRx('a');
+	Sim_uartRx('b');
+	Sim_uartRx('c');
+	num = Uart_recv(buf, sizeof(buf));
+	Bench_chk(num == 3 && memcmp(buf, "abc", 3) == 0, "uart: bytes received in order");
+	Bench_chk(Uart_recv(buf, sizeof(buf)) == 0, "uart: receive buffer empty");
+	for (i = 0; i < UART_RX_SIZE + 2; i++) {
+		Sim_uartRx((uint8_t)i);
+	}
+	Uart_getStat(&stat);
+	Bench_chk(stat.rxLost == 2 && stat.overrun == 0, "uart: receive overflow counted");
+	num = Uart_recv(buf, sizeof(buf));
+	Bench_chk(num == UART_RX_SIZE && buf[0] == 0 && buf[UART_RX_SIZE - 1] == UART_RX_SIZE - 1,
+		"uart: oldest bytes kept");
+}
+
+/* USART0の送信完了待ち(時間切れならfalse) */
+static _Bool Bench_uartFlush(void)
+{
+	uint32_t	us;
+
+	for (us = 0; us < UART_WAIT_US; us += UART_STEP_US) {
+		if (Uart_isTxIdle()) {
+			return true;
+		}
+		Sim_advanceUs(UART_STEP_US);
+	}
+	return false;
+}
+
+/***************************************************************************
+	Bench_prof
+	MRTのタイムスタンプと処理時間計測
+
+	Mrt_getElapsedがモデルの経過クロック数と一致すること(タイムスタンプ
+	が一周する時間を挟んでも2^31で割った余りが一致すること)を確認する。
+	PROF_BEGIN/PROF_ENDで__NOPを0, 10, PROF_NOP_MAX回実行する区間を囲み、
+	計測そのもののクロック数が差し引かれて__NOPの数(1回1クロック)が最小・
+	最大・平均になることを確認する。
+***************************************************************************/
+static void Bench_prof(void)
+{
+	static Prof_sec	sec;
+	static const uint32_t	nops[] = { 10, 0, PROF_NOP_MAX };
+	Prof_stat	stat;
+	Sim_cnt		cnt;
+	uint32_t	stamp, got, i, n;
+	_Bool		ok = true;
+
+	Sim_reset(SYS_RST_POR);
+	Sys_iniLpc810();
+
+	Sim_clrCnt();
+	Prof_ini();
+	Bench_report("Prof_ini");
+	if (!PROF_ENABLE) {
+		return;
+	}
+
+	/* 経過クロック数(読み出し自体のクロック数を含む) */
+	stamp = Mrt_getStamp();
+	Sim_clrCnt();
+	got = Mrt_getElapsed(stamp);
+	Sim_getCnt(&cnt);
+	Bench_chk(got == cnt.cycles, "mrt: elapsed matches model");
+	for (i = 0; i < 2; i++) {
+		stamp = Mrt_getStamp();
+		Sim_clrCnt();
+		Sim_advanceUs(MRT_LONG_US);
+		got = Mrt_getElapsed(stamp);
+		Sim_getCnt(&cnt);
+		ok = (got == (cnt.cycles & MRT_STAMP_MASK))? ok: false;
+	}
+	Bench_chk(ok, "mrt: elapsed across wrap-around");
+
+	/* 区間の計測 */
+	Bench_chk(Prof_add(&sec, "nop"), "prof: section added");
+	for (i = 0; i < sizeof(nops) / sizeof(nops[0]); i++) {
+		PROF_BEGIN(sec);
+		for (n = 0; n < nops[i]; n++) {
+			__NOP();
+		}
+		PROF_END(sec);
+	}
+	Bench_chk(Prof_getNum() == 1 && Prof_getStat(0, &stat) && !Prof_getStat(1, &stat),
+		"prof: one section registered");
+	printf("%s: prof %s cnt %u min %u max %u avg %u\n", Bench_name,
+		stat.name, stat.cnt, stat.min, stat.max, stat.avg);
+	Bench_chk(stat.cnt == 3 && stat.min == 0 && stat.max == PROF_NOP_MAX
+		&& stat.avg == (10 + PROF_NOP_MAX) / 3, "prof: overhead subtracted");
+	Prof_clr();
+	Bench_chk(Prof_getStat(0, &stat) && stat.cnt == 0 && stat.max == 0, "prof: cleared");
+}
+
+/***************************************************************************
+	Bench_sup
+	サンプルの定常ループとWDT監視
+
+	サンプル(main.cのmain)を、WDTタイムアウト時間のSUP_RUN_WDT倍だけ動
+	かす。setupでSup_addした監視タスク
+	が期限内に報告し続け、WDT満了・警告割り込みが起きないこと、最後の
+	Sup_feedで報告の無かったタスクが無いことを確認する。
+	Bench_idleは監視タスクを登録せずにIdle_runを呼ぶので、Sup_feedは常に
+	WDTをクリアしてしまい、監視タスクの期限とIdle_runの起床時刻の組み合
+	わせは確かめられない。
+	SysTick割り込みを使うか(SAMPLE_SYSTICK)は構成(configs.txtのTICK)で
+	切り替える。
+	WDTを使わない構成では、サンプルはIN_PORTのピン割り込みまで起床しない
+	(起床要因が無いとモデルが誤操作とする)ので確認しない。
+***************************************************************************/
+static void Bench_sup(void)
+{
+	enum {
+		BLINK_PIN		= 0,		/* LED_BLINK(P0_0) */
+		BLINK_PERIOD_US	= 500000,	/* main.cのLED_BLINK_PERIOD_MS */
+		BLINK_WIN_US	= 1000000,	/* 点滅を調べる時間 */
+		BLINK_TOL_US	= 1000		/* 点灯時間の許容誤差 */
+	};
+	uint32_t	ms = WWDT_TIM_OUT * SUP_RUN_WDT;
+	uint64_t	start, deep, total;
+	uint32_t	high, rise;
+
+	if ((WWDT_MODE & WWDT_WDEN) == 0) {
+		return;
+	}
+	Sim_reset(SYS_RST_POR);
+	start = Sim_getTimeUs();
+	deep = Sim_getDeepUs();
+	Sim_runApp(App_main, ms);
+	total = Sim_getTimeUs() - start;
+	deep = Sim_getDeepUs() - deep;
+	printf("%s: sample main loop %llu ms, SysTick %s (deep-sleep %llu%%)\n", Bench_name,
+		(unsigned long long)(total / 1000), SAMPLE_SYSTICK? "on": "off",
+		(unsigned long long)((total != 0)? deep * 100 / total: 0));
+	Bench_chk(!Sim_isWdtReset(), "sup: no WDT reset in the sample main loop");
+	Bench_chk(Sim_getWdtWarn() == 0, "sup: no WDT warning in the sample main loop");
+	Bench_chk(Sup_getMissed() == 0, "sup: no missed check-in at the last feed");
+	Bench_chk(total >= (uint64_t)ms * 1000, "sup: sample main loop ran to the end");
+
+	/* LED_BLINK(CTOUT_0、P0_0)は500ms周期で250ms点灯し続ける */
+	if (SAMPLE_BLINK != 0) {
+		high = Bench_sctHighUs(BLINK_PIN, BLINK_WIN_US, &rise);
+		printf("%s: sample LED_BLINK high %u us, rise %u in %u us\n", Bench_name, high, rise, BLINK_WIN_US);
+		Bench_chk(rise == BLINK_WIN_US / BLINK_PERIOD_US && high + BLINK_TOL_US >= BLINK_WIN_US / 2
+			&& high <= BLINK_WIN_US / 2 + BLINK_TOL_US, "sup: sample LED_BLINK blinks");
+	}
+}
@@ -0,0 +1,428 @@
+/***************************************************************************
+	clksolve.c
+	クロック構成の探索(ホスト用ツール)
+
+	使用方法: host/Makefileでビルドし、以下のように実行する
+		out/clksolve [-a] [-c] [-e ppm] [-g guard] [-w warn] [-n num] <sys_hz> <wdt_ms>
+
+		sys_hz	目標のシステムクロック(Hz)
+		wdt_ms	WDTタイムアウト時間(ms、WWDT_TIM_OUT)
+		-a		目標を下回る構成も候補にする(既定は目標以上のみ)
+		-c		CLKIN端子(CLKIN_HZ)を使う構成も候補にする
+		-e ppm	この誤差以内の構成は周波数が同じとみなす(既定0)
+		-g guard	WWDT_TIM_GUARD(既定はcore.hの値)
+		-w warn	WWDT_TIM_WARN(既定はcore.hの値)
+		-n num	表示する候補の数(既定10)
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	core.hのMAIN_CLK_SEL, SYS_PLL_CLK, SYS_PLL_RATE, SYS_CLK_DIV, WWDT_FREQ,
+	WWDT_DIVの組み合わせをすべて調べ、ビルドエラーとならない(Sys_lib.c,
+	Wdt_lib.c, Idle_lib.cの_Static_assertを満たす)ものを以下の順で並べる。
+
+	1) 周波数: 目標のシステムクロックとの誤差が小さい順(-eの範囲内は同順)
+	2) 消費電力: PLLを使わない、内蔵オシレータを止められる(IRC_PDWON=1
+	　 で電源断になる)、メインクロックが低い順
+	3) WDT: WDTカウンタ1当たりの時間(タイムアウト時間の分解能)が細かい順
+
+	メインクロックにWDT用オシレータを使う場合以外は、WWDT_FREQ, WWDT_DIVは
+	クロック構成と独立なので、分解能の最も細かいものを選ぶ。
+
+	最上位の構成を、core.hに貼り付ける形と、configs.txtの1行の形で出力す
+	る。configs.txtに加えてmakeすれば、ホスト上でその構成を確認できる。
+
+	※WDT用オシレータの周波数は公称値であり、実際には±40%ずれる。メイン
+	　クロックに使う場合は注意すること。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: configs.txtのSAMPLE_SYSTICKの列に合わせた
+	2026.10.16: mits: configs.txtのSAMPLE_BLINKの列に合わせた
+***************************************************************************/
+#include	<stdio.h>
+#include	<stdlib.h>
+#include	<string.h>
+#include	<unistd.h>
+#include	"core.h"
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+
+/* ビルド時チェックの条件(各ソースのローカル定義と合わせること) */
+enum {
+	PLL_RATE_MAX		= 32,	/* Sys_lib.c: PLL逓倍数の上限 */
+	CLK_DIV_MAX			= 255,	/* Sys_lib.c: システムクロック分周値の上限 */
+	WDT_DIV_MIN			= 2,	/* Wdt_lib.c: WWDT_DIVの下限 */
+	WDT_DIV_MAX			= 64,	/* Wdt_lib.c: WWDT_DIVの上限(偶数のみ) */
+	WDT_PRE_DIV			= 4,	/* Wdt_lib.c: WDTのプリスケーラ */
+	IDLE_WDT_MARGIN_MS	= 50	/* Idle_lib.c: 警告割り込みより前に起床する余裕時間 */
+};
+
+enum {
+	SOLVE_MAX	= 20000,	/* 候補の最大数 */
+	SOLVE_SHOW	= 10		/* 既定の表示数 */
+};
+
+/*** 消費電力の順位付け(小さいほど低消費電力) ***/
+enum {
+	POW_PLL	= 2,	/* PLLを使う */
+	POW_IRC	= 1		/* 内蔵オシレータを止められない */
+};
+
+/*** 候補の構成 ***/
+typedef struct Solve_cfg {
+	uint32_t	mainSel;	/* MAIN_CLK_SEL */
+	uint32_t	pllSel;		/* SYS_PLL_CLK */
+	uint32_t	rate;		/* SYS_PLL_RATE */
+	uint32_t	div;		/* SYS_CLK_DIV */
+	uint32_t	wdtFreq;	/* WWDT_FREQ */
+	uint32_t	wdtDiv;		/* WWDT_DIV */
+	uint32_t	mainHz;		/* メインクロック */
+	uint32_t	sysHz;		/* システムクロック */
+	uint32_t	errPpm;		/* 目標との誤差(ppm) */
+	uint32_t	power;		/* 消費電力の順位(POW_*の和) */
+	uint32_t	resNs;		/* WDTカウンタ1当たりの時間(ns) */
+} Solve_cfg;
+
+/*** 探索条件 ***/
+typedef struct Solve_req {
+	uint32_t	sysHz;		/* 目標のシステムクロック */
+	uint32_t	outMs;		/* WWDT_TIM_OUT */
+	uint32_t	guardMs;	/* WWDT_TIM_GUARD */
+	uint32_t	warnMs;		/* WWDT_TIM_WARN */
+	uint32_t	tolPpm;		/* 同じとみなす誤差 */
+	_Bool		below;		/* 目標を下回る構成も候補にする */
+	_Bool		clkin;		/* CLKIN端子を使う構成も候補にする */
+} Solve_req;
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static Solve_cfg	Solve_cfgs[SOLVE_MAX];	/* 候補 */
+static uint32_t		Solve_num;				/* 候補数 */
+static uint32_t		Solve_tolPpm;			/* Solve_cmpで使う誤差の幅 */
+
+static const char	*Solve_mainName[] = {
+	"SYS_MAIN_CLK_IRC", "SYS_MAIN_CLK_PLLIN", "SYS_MAIN_CLK_WDTOSC", "SYS_MAIN_CLK_PLLOUT"
+};
+static const char	*Solve_freqName[] = {
+	"WDTOSC_FREQ_DIS", "WDTOSC_FREQ_600KHZ", "WDTOSC_FREQ_1_05MHZ", "WDTOSC_FREQ_1_40MHZ",
+	"WDTOSC_FREQ_1_75MHZ", "WDTOSC_FREQ_2_10MHZ", "WDTOSC_FREQ_2_40MHZ", "WDTOSC_FREQ_2_70MHZ",
+	"WDTOSC_FREQ_3_00MHZ", "WDTOSC_FREQ_3_25MHZ", "WDTOSC_FREQ_3_50MHZ", "WDTOSC_FREQ_3_75MHZ",
+	"WDTOSC_FREQ_4_00MHZ", "WDTOSC_FREQ_4_20MHZ", "WDTOSC_FREQ_4_40MHZ", "WDTOSC_FREQ_4_60MHZ"
+};
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static void		Solve_usage(void);
+static _Bool	Solve_wdtOk(const Solve_req *req, uint32_t freq, uint32_t div);
+static uint64_t	Solve_msToCnt(uint32_t freq, uint32_t div, uint32_t ms);
+static uint32_t	Solve_resNs(uint32_t freq, uint32_t div);
+static _Bool	Solve_bestWdt(const Solve_req *req, uint32_t *freq, uint32_t *div);
+static void		Solve_add(const Solve_req *req, Solve_cfg *cfg);
+static void		Solve_clk(const Solve_req *req, uint32_t mainSel, uint32_t pllSel,
+						uint32_t rate, uint32_t mainHz);
+static int		Solve_cmp(const void *a, const void *b);
+static void		Solve_print(const Solve_req *req, uint32_t show);
+
+/***************************************************************************
+	main
+***************************************************************************/
+int main(int argc, char *argv[])
+{
+	Solve_req	req = { 0, 0, WWDT_TIM_GUARD, WWDT_TIM_WARN, 0, false, false };
+	uint32_t	show = SOLVE_SHOW;
+	uint32_t	rate, freq, div;
+	int			opt;
+
+	while ((opt = getopt(argc, argv, "ace:g:w:n:")) != -1) {
+		switch (opt) {
+		case 'a':	req.below = true;								break;
+		case 'c':	req.clkin = true;								break;
+		case 'e':	req.tolPpm = (uint32_t)strtoul(optarg, NULL, 0);	break;
+		case 'g':	req.guardMs = (uint32_t)strtoul(optarg, NULL, 0);	break;
+		case 'w':	req.warnMs = (uint32_t)strtoul(optarg, NULL, 0);	break;
+		case 'n':	show = (uint32_t)strtoul(optarg, NULL, 0);		break;
+		default:	Solve_usage();									return EXIT_FAILURE;
+		}
+	}
+	if (argc - optind != 2) {
+		Solve_usage();
+		return EXIT_FAILURE;
+	}
+	req.sysHz = (uint32_t)strtoul(argv[optind], NULL, 0);
+	req.outMs = (uint32_t)strtoul(argv[optind + 1], NULL, 0);
+	if (req.sysHz == 0 || req.outMs == 0) {
+		Solve_usage();
+		return EXIT_FAILURE;
+	}
+	Solve_tolPpm = req.tolPpm;
+
+	/* 内蔵オシレータ、PLL入力(IRC/CLKIN)、PLL出力 */
+	Solve_clk(&req, SYS_MAIN_CLK_IRC, SYS_PLL_CLK_IRC, 1, IRC_HZ);
+	Solve_clk(&req, SYS_MAIN_CLK_PLLIN, SYS_PLL_CLK_IRC, 1, IRC_HZ);
+	if (req.clkin) {
+		Solve_clk(&req, SYS_MAIN_CLK_PLLIN, SYS_PLL_CLK_CLKIN, 1, CLKIN_HZ);
+	}
+	for (rate = 1; rate <= PLL_RATE_MAX; rate++) {
+		Solve_clk(&req, SYS_MAIN_CLK_PLLOUT, SYS_PLL_CLK_IRC, rate, IRC_HZ * rate);
+		if (req.clkin) {
+			Solve_clk(&req, SYS_MAIN_CLK_PLLOUT, SYS_PLL_CLK_CLKIN, rate, CLKIN_HZ * rate);
+		}
+	}
+	/* WDT用オシレータ(WDTの設定と連動) */
+	for (freq = WDTOSC_FREQ_600KHZ; freq <= WDTOSC_FREQ_4_60MHZ; freq++) {
+		for (div = WDT_DIV_MIN; div <= WDT_DIV_MAX; div += 2) {
+			Solve_cfg	cfg;
+			uint32_t	sysDiv;
+
+			if (!Solve_wdtOk(&req, freq, div)) {
+				continue;
+			}
+			for (sysDiv = 1; sysDiv <= CLK_DIV_MAX; sysDiv++) {
+				memset(&cfg, 0, sizeof(cfg));
+				cfg.mainSel = SYS_MAIN_CLK_WDTOSC;
+				cfg.pllSel = SYS_PLL_CLK_IRC;
+				cfg.rate = 1;
+				cfg.div = sysDiv;
+				cfg.wdtFreq = freq;
+				cfg.wdtDiv = div;
+				cfg.mainHz = WDTOSC_FREQ_HZ(freq) / div;
+				Solve_add(&req, &cfg);
+			}
+		}
+	}
+
+	if (Solve_num == 0) {
+		printf("no legal configuration (check wdt_ms, -g, -w%s)\n", req.below? "": ", or try -a");
+		return EXIT_FAILURE;
+	}
+	qsort(Solve_cfgs, Solve_num, sizeof(Solve_cfgs[0]), Solve_cmp);
+	Solve_print(&req, show);
+	return EXIT_SUCCESS;
+}
+
+/***************************************************************************
+	Solve_usage
+	使用方法の表示
+***************************************************************************/
+static void Solve_usage(void)
+{
+	fprintf(stderr, "usage: clksolve [-a] [-c] [-e ppm] [-g guard] [-w warn] [-n num] <sys_hz> <wdt_ms>\n");
+}
+
+/***************************************************************************
+	Solve_wdtOk
+	WDT設定の妥当性(Wdt_lib.c, Idle_lib.cのビルド時チェックと同じ条件)
+
+	[引数]	req		探索条件
+			freq	WWDT_FREQ
+			div		WWDT_DIV
+	[戻値]	ビルドエラーにならない(true), なる(false)
+***************************************************************************/
+static _Bool Solve_wdtOk(const Solve_req *req, uint32_t freq, uint32_t div)
+{
+	uint64_t	out = Solve_msToCnt(freq, div, req->outMs);
+
+	if (req->guardMs > req->outMs || req->warnMs > req->outMs - req->guardMs) {
+		return false;
+	}
+	if (req->outMs < req->warnMs + IDLE_WDT_MARGIN_MS + req->guardMs) {
+		return false;
+	}
+	return (out >= WWDT_CNT_MIN && out <= WWDT_CNT_MAX
+		&& Solve_msToCnt(freq, div, req->warnMs) <= WWDT_WARN_MAX)? true: false;
+}
+
+/* 時間(ms)のWDTカウンタ値(Wdt_lib.cのWDT_MS2CNTと同じ) */
+static uint64_t Solve_msToCnt(uint32_t freq, uint32_t div, uint32_t ms)
+{
+	return (uint64_t)WDTOSC_FREQ_HZ(freq) * ms / ((uint64_t)div * WDT_PRE_DIV * 1000);
+}
+
+/* WDTカウンタ1当たりの時間(ns) */
+static uint32_t Solve_resNs(uint32_t freq, uint32_t div)
+{
+	return (uint32_t)((uint64_t)div * WDT_PRE_DIV * 1000000000 / WDTOSC_FREQ_HZ(freq));
+}
+
+/***************************************************************************
+	Solve_bestWdt
+	分解能の最も細かいWDT設定
+
+	[引数]	req		探索条件
+			freq	WWDT_FREQの格納先
+			div		WWDT_DIVの格納先
+	[戻値]	見つかった(true), 設定できるものが無い(false)
+***************************************************************************/
+static _Bool Solve_bestWdt(const Solve_req *req, uint32_t *freq, uint32_t *div)
+{
+	uint32_t	f, d;
+	uint32_t	best = UINT32_MAX;
+
+	for (f = WDTOSC_FREQ_600KHZ; f <= WDTOSC_FREQ_4_60MHZ; f++) {
+		for (d = WDT_DIV_MIN; d <= WDT_DIV_MAX; d += 2) {
+			if (Solve_wdtOk(req, f, d) && Solve_resNs(f, d) < best) {
+				best = Solve_resNs(f, d);
+				*freq = f;
+				*div = d;
+			}
+		}
+	}
+	return (best != UINT32_MAX)? true: false;
+}
+
+/***************************************************************************
+	Solve_clk
+	メインクロック1つ分の候補の追加
+
+	[引数]	req		探索条件
+			mainSel	MAIN_CLK_SEL
+			pllSel	SYS_PLL_CLK
+			rate	SYS_PLL_RATE
+			mainHz	メインクロック
+	[戻値]	なし
+
+	SYS_CLK_DIVを1～CLK_DIV_MAXまで変えて追加する。
+***************************************************************************/
+static void Solve_clk(const Solve_req *req, uint32_t mainSel, uint32_t pllSel,
+	uint32_t rate, uint32_t mainHz)
+{
+	Solve_cfg	cfg;
+	uint32_t	div;
+
+	memset(&cfg, 0, sizeof(cfg));
+	if (!Solve_bestWdt(req, &cfg.wdtFreq, &cfg.wdtDiv)) {
+		return;
+	}
+	cfg.mainSel = mainSel;
+	cfg.pllSel = pllSel;
+	cfg.rate = rate;
+	cfg.mainHz = mainHz;
+	for (div = 1; div <= CLK_DIV_MAX; div++) {
+		cfg.div = div;
+		Solve_add(req, &cfg);
+	}
+}
+
+/***************************************************************************
+	Solve_add
+	候補の追加
+
+	[引数]	req	探索条件
+			cfg	構成(mainHzまで設定済み)
+	[戻値]	なし
+
+	Sys_lib.cのビルド時チェック(メインクロックが0より大きくSYS_CLK_MAX
+	以下)を満たさないもの、目標を下回るもの(-aなし)は追加しない。
+***************************************************************************/
+static void Solve_add(const Solve_req *req, Solve_cfg *cfg)
+{
+	uint64_t	diff;
+
+	if (cfg->mainHz == 0 || cfg->mainHz > SYS_CLK_MAX || Solve_num >= SOLVE_MAX) {
+		return;
+	}
+	cfg->sysHz = cfg->mainHz / cfg->div;
+	if (cfg->sysHz < req->sysHz && !req->below) {
+		return;
+	}
+	diff = (cfg->sysHz > req->sysHz)? cfg->sysHz - req->sysHz: req->sysHz - cfg->sysHz;
+	cfg->errPpm = (uint32_t)(diff * 1000000 / req->sysHz);
+	if (cfg->errPpm > 1000000) {
+		return;		/* 目標の2倍を超えるものは候補にしない */
+	}
+	cfg->power = 0;
+	if (cfg->mainSel == SYS_MAIN_CLK_PLLOUT) {
+		cfg->power += POW_PLL;
+	}
+	if (cfg->mainSel == SYS_MAIN_CLK_IRC
+	 || (cfg->mainSel != SYS_MAIN_CLK_WDTOSC && cfg->pllSel == SYS_PLL_CLK_IRC)) {
+		cfg->power += POW_IRC;		/* Sys_lib.cのBOOT_USE_IRCと同じ条件 */
+	}
+	cfg->resNs = Solve_resNs(cfg->wdtFreq, cfg->wdtDiv);
+	Solve_cfgs[Solve_num++] = *cfg;
+}
+
+/***************************************************************************
+	Solve_cmp
+	候補の順位の比較(qsort用)
+***************************************************************************/
+static int Solve_cmp(const void *a, const void *b)
+{
+	const Solve_cfg	*x = a;
+	const Solve_cfg	*y = b;
+	uint32_t		ex = (x->errPpm <= Solve_tolPpm)? 0: x->errPpm;
+	uint32_t		ey = (y->errPpm <= Solve_tolPpm)? 0: y->errPpm;
+
+	if (ex != ey) {
+		return (ex < ey)? -1: 1;
+	}
+	if (x->power != y->power) {
+		return (x->power < y->power)? -1: 1;
+	}
+	if (x->mainHz != y->mainHz) {
+		return (x->mainHz < y->mainHz)? -1: 1;
+	}
+	if (x->resNs != y->resNs) {
+		return (x->resNs < y->resNs)? -1: 1;
+	}
+	if (x->mainSel != y->mainSel) {
+		return (x->mainSel < y->mainSel)? -1: 1;	/* IRCをPLLINより先に */
+	}
+	return 0;
+}
+
+/***************************************************************************
+	Solve_print
+	結果の表示
+
+	[引数]	req		探索条件
+			show	表示する候補の数
+	[戻値]	なし
+***************************************************************************/
+static void Solve_print(const Solve_req *req, uint32_t show)
+{
+	const Solve_cfg	*c = &Solve_cfgs[0];
+	uint32_t		i;
+
+	printf("target: system clock %u Hz (%s), WWDT_TIM_OUT %u ms, GUARD %u ms, WARN %u ms\n",
+		req->sysHz, req->below? "nearest": "at least", req->outMs, req->guardMs, req->warnMs);
+	printf("%u legal configurations\n\n", Solve_num);
+	printf("rank  sys_hz    err_ppm  main_hz   MAIN_CLK_SEL         SYS_PLL_CLK        RATE DIV  IRC PLL  WWDT_FREQ            WDIV wdt_res_us\n");
+	for (i = 0; i < show && i < Solve_num; i++) {
+		c = &Solve_cfgs[i];
+		printf("%4u  %-9u %-8u %-9u %-20s %-18s %4u %3u  %-3s %-3s  %-20s %4u %u.%03u\n",
+			i + 1, c->sysHz, c->errPpm, c->mainHz, Solve_mainName[c->mainSel],
+			(c->pllSel == SYS_PLL_CLK_CLKIN)? "SYS_PLL_CLK_CLKIN": "SYS_PLL_CLK_IRC",
+			c->rate, c->div, ((c->power & POW_IRC) != 0)? "on": "off",
+			((c->power & POW_PLL) != 0)? "on": "off",
+			Solve_freqName[c->wdtFreq], c->wdtDiv, c->resNs / 1000, c->resNs % 1000);
+	}
+
+	c = &Solve_cfgs[0];
+	printf("\n/* core.h */\n");
+	printf("\tMAIN_CLK_SEL\t= %s,\n", Solve_mainName[c->mainSel]);
+	printf("\tSYS_PLL_CLK\t\t= %s,\n", (c->pllSel == SYS_PLL_CLK_CLKIN)? "SYS_PLL_CLK_CLKIN": "SYS_PLL_CLK_IRC");
+	printf("\tSYS_PLL_RATE\t= %u,\n", c->rate);
+	printf("\tSYS_CLK_DIV\t\t= %u\n", c->div);
+	printf("\tIRC_PDWON\t= %u\t\t/* %s */\n", ((c->power & POW_IRC) != 0)? IRC_PDWON: 1,
+		((c->power & POW_IRC) != 0)? "IRC in use: no effect": "IRC unused: power it down");
+	printf("\tWWDT_FREQ\t= %s,\n", Solve_freqName[c->wdtFreq]);
+	printf("\tWWDT_DIV\t= %u\n", c->wdtDiv);
+	printf("\tWWDT_TIM_OUT\t= %u,\n", req->outMs);
+	printf("\tWWDT_TIM_GUARD\t= %u,\n", req->guardMs);
+	printf("\tWWDT_TIM_WARN\t= %u\n", req->warnMs);
+	if (c->mainSel == SYS_MAIN_CLK_WDTOSC) {
+		printf("\t/* note: WDT oscillator is nominal (+-40%%) */\n");
+	}
+
+	printf("\n# configs.txt\n");
+	printf("solved\t\t%s\t%s\t%u\t%u\t-\t\t\t%s\t%u\t%u\t%u\t%u\t-\t-\tok\n",
+		Solve_mainName[c->mainSel],
+		(c->pllSel == SYS_PLL_CLK_CLKIN)? "SYS_PLL_CLK_CLKIN": "SYS_PLL_CLK_IRC",
+		c->rate, c->div, Solve_freqName[c->wdtFreq], c->wdtDiv,
+		req->outMs, req->guardMs, req->warnMs);
+}
@@ -0,0 +1,56 @@
+/***************************************************************************
+	divcmp.c
+	従来の時間換算(64ビット除算)の比較用
+
+	使用方法: make -C host divsize CMSIS=<LPC8xx.hのあるディレクトリ>
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	Sys_msToTicks, Wdt_msToCnt(乗算とシフトだけ)に置き換える前の換算を、
+	そのままの式で残したもの。divsizeでsrc/*.cと一緒にクロスコンパイルし、
+	関数の大きさと、参照する除算ルーチン(__aeabi_uldivmodなど)を並べて
+	比べる。ファームウェアにはリンクしない。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#include	<stdint.h>
+
+uint32_t	Divcmp_msToTicks(uint32_t hz, uint32_t ms);
+uint32_t	Divcmp_msToCnt(uint32_t freq, uint32_t div, uint32_t ms, uint32_t max);
+
+/***************************************************************************
+	Divcmp_msToTicks
+	従来のstartSysTickの換算(Sys_msToTicksの置き換え前)
+
+	[引数]	hz	システムクロック(Hz)
+			ms	時間(ms)
+	[戻値]	システムクロック数
+***************************************************************************/
+uint32_t Divcmp_msToTicks(uint32_t hz, uint32_t ms)
+{
+	uint64_t ticks = (uint64_t)hz * ms / 1000;
+
+	return (uint32_t)ticks;
+}
+
+/***************************************************************************
+	Divcmp_msToCnt
+	従来のWdt_getMs(Wdt_msToCntの置き換え前)
+
+	[引数]	freq	WDT用オシレータの周波数(Hz)
+			div		WDT用オシレータの分周値
+			ms		時間(ms)
+			max		カウンタ上限値
+	[戻値]	WDTカウンタ値
+***************************************************************************/
+uint32_t Divcmp_msToCnt(uint32_t freq, uint32_t div, uint32_t ms, uint32_t max)
+{
+	enum {
+		PRE_DIV		= 4,	/* プリスケーラの分周値(固定値) */
+		SEC_UINT	= 1000	/* 1ms単位 */
+	};
+
+	uint64_t cnt = ((uint64_t)freq * ms) / (div * PRE_DIV * SEC_UINT);
+	return (cnt > max)? max: (uint32_t)cnt;
+}
@@ -0,0 +1,66 @@
+#!/bin/sh
+#
+# mkcfg.sh - configs.txtの構成からcore.hを生成する
+#
+# 使用方法: sh mkcfg.sh <構成名> <configs.txt> <inc/core.h>  > out/<構成名>/core.h
+#
+# inc/core.hの該当行(タブ1つで始まる列挙子の行)の値だけを置き換える。
+# 置き換えられなかった場合はエラーとする。
+#
+# ベンチマーク・回帰テストは全ライブラリを試すので、サンプルの大きさのた
+# めに0にできるライブラリのスイッチ(libs)は、構成に関わらず1にする。
+#
+# 変更履歴
+# 2026.10.16: mits: 新規作成
+# 2026.10.16: mits: PROF_ENABLE, UART_ENABLE, WDT_LEARN_ENABLEを1にするようにした
+# 2026.10.16: mits: SAMPLE_SYSTICKの列を追加
+# 2026.10.16: mits: SAMPLE_BLINKの列を追加
+#
+set -e
+
+name=$1
+cfg=$2
+src=$3
+tab=$(printf '\t')
+syms="MAIN_CLK_SEL SYS_PLL_CLK SYS_PLL_RATE SYS_CLK_DIV WWDT_MODE WWDT_FREQ WWDT_DIV WWDT_TIM_OUT WWDT_TIM_GUARD WWDT_TIM_WARN SAMPLE_SYSTICK SAMPLE_BLINK"
+libs="PROF_ENABLE UART_ENABLE WDT_LEARN_ENABLE"
+
+line=$(awk -v n="$name" '$1 == n { $1 = ""; $NF = ""; print; exit }' "$cfg")
+if [ -z "$line" ]; then
+	echo "mkcfg.sh: $name: no such config" >&2
+	exit 1
+fi
+
+script=""
+set -- $line
+for sym in $syms; do
+	val=$1
+	shift
+	if [ "$val" != "-" ]; then
+		script="$script
+s#^\\(${tab}${sym}${tab}*= *\\)[^,/${tab}]*#\\1${val}#"
+	fi
+done
+for sym in $libs; do
+	script="$script
+s#^\\(${tab}${sym}${tab}*= *\\)[^,/${tab}]*#\\11#"
+done
+
+out=$(sed "$script" "$src")
+
+set -- $line
+for sym in $syms; do
+	val=$1
+	shift
+	if [ "$val" != "-" ] && ! printf '%s\n' "$out" | grep -q "^${tab}${sym}${tab}*= *${val}"; then
+		echo "mkcfg.sh: $name: cannot set $sym" >&2
+		exit 1
+	fi
+done
+for sym in $libs; do
+	if ! printf '%s\n' "$out" | grep -q "^${tab}${sym}${tab}*= *1"; then
+		echo "mkcfg.sh: $name: cannot set $sym" >&2
+		exit 1
+	fi
+done
+printf '%s\n' "$out"
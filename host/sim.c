@@ -0,0 +1,1758 @@
+/***************************************************************************
+	sim.c
+	ホスト用レジスタモデル
+
+	使用方法: host/Makefileでsrc以下のソースとともにリンクする
+
+	マイコン: LPC810(NXP Semiconductors)をホスト上で模擬する
+
+	LPC_SYSCON, LPC_WWDTなどのペリフェラルを、ホストのメモリ上のレジスタ
+	ファイルで置き換える。host/LPC8xx.hにより、ペリフェラルの参照(LPC_xxx->)
+	の度にSim_access()が呼ばれ、以下を行う。
+
+	1) 前回の参照で書かれた値を調べて、ハードウェアの動作を反映する。
+		・SYSPLLCLKUEN, MAINCLKUEN: 0→1でクロック選択を反映する。
+		・PDRUNCFG: PLLの電源投入でロック時間(Sim_setPllLockUs)だけ時間を
+		　進めてSYSPLLSTATをロック済みにする。
+		・FEED: 0xAA→0x55でWDTカウンタ(TV)を再ロードする。ガード時間中の
+		　クリアはWDT満了と同じ扱いとする。
+		・SysTickのVAL、WKTのCOUNTへの書き込みでカウンタを設定する。
+		・PINTのSIENR, CIENR, SIENF, CIENFをIENR, IENFに反映し、レベル検
+		　出のチャネルは入力レベルを判定する。
+		・USART0のTXDATAへの書き込みで送信を始める(保持レジスタとシフト
+		　レジスタの2段)。INTENSET, INTENCLRを割り込み許可に反映する。
+		・MRTのINTVALへの書き込みでカウンタをロードする。
+		・GPIOのSET0, CLR0, NOT0, B0, W0, MPIN0(MASK0が0のビット)への書
+		　き込みを出力ピン(DIR0)のPIN0に反映する。B0, W0, MPIN0は前回公開
+		　した値からの変化で書き込みを検出する(同じ値の書き込みは出力も
+		　変わらないので区別しない)。
+		・SWMのPINASSIGN0～8, PINENABLE0で、1つのピンに2つ以上の機能を割
+		　り当てた場合や、ポート0に無いピンを指定した場合は誤操作とする
+		　(実機では入力機能どうしなら共有できるが、Swm_libの前提に合わせ
+		　る)。
+		・FLASHCFGのアクセス時間がシステムクロックに対して短い場合や、予
+		　約ビットを変えた場合は誤操作とする。
+		・SCTのCTRL_U(HALT_L, STOP_L, CLRCTR_L)で、カウンタの開始・中断・
+		　クリアを反映する。COUNT_Uへの書き込みでカウンタを設定する。
+	2) アクセス回数を数え、SIM_ACC_CYCクロック分だけ時間を進める。
+	　 SYSAHBCLKCTRLでクロックが止まっているペリフェラルの参照は誤操作と
+	　 する。
+	3) 読み出されるレジスタ(TV, VAL, COUNTなど)を現在時刻の値にする。
+
+	時間はps単位で管理し、システムクロック数はモデル上のクロック構成から求
+	める。WDTはWDTOSCCTRLの設定から求めたクロックで数える。
+	メインクロックが止まる操作(使用中のIRCの電源断など)や、誤ったFEEDは誤
+	操作(Sim_getFault)として記録する。
+
+	入力ピンのレベルはSim_setPinで変える。エッジ検出のピン割り込みはその時
+	点で発生する。
+	IOCONの入力フィルタ(S_MODE)は、Sim_pulsePinで与えたパルスの長さを、
+	フィルタのクロック(メインクロック / IOCONCLKDIVn) × S_MODEと比べて、
+	短ければ除く。フィルタのクロックが止まっている(IOCONCLKDIVnが0)ピンの
+	入力を変えた場合は、入力が届かないので誤操作とする。
+	USART0の受信はSim_uartRxで1バイトずつ与える(受信にかかる時間は模擬
+	しない)。送信は1バイトを10ビット分の時間で送り、送り終えたものを
+	Sim_uartTxで取り出せる。
+	SCTは32ビットカウンタ1本(UNIFY)、システムクロック、MATCH0によるリミッ
+	ト(AUTOLIMIT_L)、一致だけのイベント(ステート0)による出力のセット/クリ
+	アだけを模擬する。それ以外の構成と割り込み(EVEN)は誤操作とする。
+	出力(OUTPUT)は、現在のカウンタ値から遡って最も近くで発生したイベント
+	で決め、SWMでCTOUT_0～3を割り当てたピンのPIN0に反映する。MATCHRELは
+	リミットの度にMATCHへ再ロードされるので、MATCHRELの値を一致に使う(書
+	き込みが次の周期から反映されることは模擬しない)。同じ出力を同時にセッ
+	トとクリアするイベントは誤操作とする。ディープスリープ中は止める。
+	MRTはリピートモードのダウンカウンタ(TIMER)だけを模擬し、ワンショット
+	モードと割り込みは模擬しない。INTVALへの書き込みはMRT_LOADの有無に関
+	わらず直ちにロードする。ディープスリープ中はカウントを止める。
+	ディープスリープ・パワーダウン(PCONで区別しない)からの起床では、
+	PDAWAKECFGをPDRUNCFGに反映する。PLLは停止中に電源が落ちるので、起床
+	後にロックし直す。ディープパワーダウン(PCON=PMU_PM_DPD)は時間を進め
+	ずに記録だけして戻る(Sim_isDpd)。
+
+	割り込みはSim_wfi(__WFI)とSim_setPrimask(__enable_irq)、Sim_advanceUs、
+	Sim_setPinの時点でのみ配送する。ハンドラは弱参照しているので、リンクされていなけ
+	れば呼ばない。WDT警告割り込みは、WDT_IRQHandler(アセンブラの入口)の代
+	わりにWdt_procIrqを模擬のスタックフレームで呼び出す。
+
+	数値は以下を仮定している(マニュアルに規定のないもの)。
+		・ペリフェラルの参照1回: SIM_ACC_CYCクロック
+		・PLLのロック時間: SIM_PLL_LOCK_US(Sim_setPllLockUsで変更可)
+		・WDT用オシレータの誤差: 0ppm(Sim_setWdtOscPpmで変更可)
+		・クロック切り替え: 切り替え前後のクロックでSIM_UEN_SYNCクロックずつ
+
+	1書きでクリアするレジスタ(PINTのRISE, FALL, IST)は、読んだ値をそのま
+	ま書き戻すと書き込みを検出できないため、エッジ検出のピン割り込みは、
+	ハンドラから戻った時点でクリアされたものとする。
+	USART0のRXRDY(RXDATAの読み出しでクリア)とエラーフラグ(STATへの1書
+	きでクリア)も同様に、ハンドラから戻った時点でクリアされたものとする。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: ピン割り込み追加
+	2026.10.16: mits: USART0追加
+	2026.10.16: mits: MRT追加
+	2026.10.16: mits: WDT用オシレータの誤差(Sim_setWdtOscPpm)追加
+	2026.10.16: mits: PDSLEEPCFG, PDAWAKECFG, ディープパワーダウン追加
+	2026.10.16: mits: クロックが止まっているペリフェラルの参照を検出
+	2026.10.16: mits: フラッシュのアクセス時間(FLASHCFG)の確認追加
+	2026.10.16: mits: GPIOのB0, W0, MASK0, MPIN0追加
+	2026.10.16: mits: スイッチマトリクスのピンの重複の確認追加
+	2026.10.16: mits: IOCONの入力フィルタ(Sim_pulsePin)追加
+	2026.10.16: mits: SCT追加
+	2026.10.16: mits: ディープスリープしていた時間(Sim_getDeepUs)追加
+	2026.10.16: mits: サンプル(main.c)の定常ループの実行(Sim_runApp)追加
+	2026.10.16: mits: BKPT命令(Sim_bkpt)追加
+***************************************************************************/
+#include	<stdio.h>
+#include	<string.h>
+#include	<setjmp.h>
+#include	"core.h"
+#include	"sim.h"
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	SIM_ACC_CYC		= 2,		/* ペリフェラル参照1回のクロック数 */
+	SIM_UEN_SYNC	= 2,		/* クロック切り替え時の同期クロック数 */
+	SIM_PLL_LOCK_US	= 100,		/* us; PLLのロック時間 */
+	SIM_WFI_MAX_US	= 10000000,	/* us; 起床要因が無い場合のWFIの上限 */
+	SIM_IRQ_NUM		= 32,		/* 外部割り込みの数 */
+	SIM_LPOSC_HZ	= 10000,	/* Hz; 低消費電力オシレータ */
+	SIM_WKT_IRC_DIV	= 16,		/* WKTのIRCクロック分周値 */
+	SIM_WDT_PRE_DIV	= 4,		/* WDTのプリスケーラ */
+	SIM_FLASHCFG_RSV	= 0x5A5A5A58,	/* FLASHCFGの予約ビット(変更を検出するための目印) */
+	SIM_FEED_1ST	= 0xAA,		/* FEEDシーケンス1回目 */
+	SIM_FEED_2ND	= 0x55,		/* FEEDシーケンス2回目 */
+	SIM_UART_BITS	= 10,		/* USARTの1バイトのビット数(8N1) */
+	SIM_UART_LOG	= 256,		/* 送信し終えたバイトの記録数 */
+	SIM_UART_RX_CLR	= UART_RXRDY | UART_OVERRUN | UART_FRAMERR | UART_PARITYERR | UART_RXNOISE,
+	SIM_SCT_CTRL_RST	= SCT_HALT_L | (SCT_HALT_L << 16),	/* SCTのCTRL_Uのリセット値 */
+	SIM_SCT_CTOUT0	= 27	/* SWMのCTOUT_0の機能番号(CTOUT_1～3は続く) */
+};
+
+#define	SIM_UART_TXNONE	0xFFFFFFFFUL	/* TXDATAに書き込みが無い時の値 */
+
+#define	SIM_PS_PER_SEC	1000000000000ULL	/* 1秒当たりのps */
+#define	SIM_PS_PER_US	1000000ULL			/* 1us当たりのps */
+
+/*** WDTOSCCTRLのFREQSELに対応する周波数(Hz) ***/
+static const uint32_t	Sim_wdtFreq[] = {
+	0, 600000, 1050000, 1400000, 1750000, 2100000, 2400000, 2700000,
+	3000000, 3250000, 3500000, 3750000, 4000000, 4200000, 4400000, 4600000
+};
+
+/*** PINENABLE0の固定機能のピン番号(ビット順) ***/
+static const uint8_t	Sim_swmFixedPin[SWM_FIXED_NUM] = {
+	0, 1, 3, 2, 8, 9, 5, 1, 6
+};
+
+/*** ピン番号→IOCONレジスタの位置(PIO0_17からのワード数) ***/
+static const uint8_t	Sim_ioconIdx[GPIO_PIN_NUM] = {
+	17, 11, 6, 5, 4, 3, 16, 15, 14, 13, 8, 7, 2, 1, 18, 10, 9, 0
+};
+
+/*** 割り込みハンドラ(リンクされていれば呼ぶ) ***/
+extern void	SysTick_Handler(void) __attribute__ ((weak));
+extern void	WKT_IRQHandler(void) __attribute__ ((weak));
+extern void	Wdt_procIrq(const uint32_t *frame) __attribute__ ((weak));
+extern void	PININT0_IRQHandler(void) __attribute__ ((weak));
+extern void	PININT1_IRQHandler(void) __attribute__ ((weak));
+extern void	PININT2_IRQHandler(void) __attribute__ ((weak));
+extern void	PININT3_IRQHandler(void) __attribute__ ((weak));
+extern void	PININT4_IRQHandler(void) __attribute__ ((weak));
+extern void	PININT5_IRQHandler(void) __attribute__ ((weak));
+extern void	PININT6_IRQHandler(void) __attribute__ ((weak));
+extern void	PININT7_IRQHandler(void) __attribute__ ((weak));
+extern void	UART0_IRQHandler(void) __attribute__ ((weak));
+
+static void	(* const Sim_pintHandler[PINT_CH_NUM])(void) = {
+	PININT0_IRQHandler, PININT1_IRQHandler, PININT2_IRQHandler, PININT3_IRQHandler,
+	PININT4_IRQHandler, PININT5_IRQHandler, PININT6_IRQHandler, PININT7_IRQHandler
+};
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+
+/*** レジスタファイル ***/
+static struct {
+	LPC_SYSCON_TypeDef		syscon;
+	LPC_WWDT_TypeDef		wwdt;
+	LPC_GPIO_PORT_TypeDef	gpio;
+	LPC_SWM_TypeDef			swm;
+	LPC_IOCON_TypeDef		iocon;
+	LPC_PMU_TypeDef			pmu;
+	LPC_WKT_TypeDef			wkt;
+	LPC_PIN_INT_TypeDef		pint;
+	LPC_USART_TypeDef		usart0;
+	LPC_MRT_TypeDef			mrt;
+	LPC_FLASHCTRL_TypeDef	flashctrl;
+	LPC_SCT_TypeDef			sct;
+	SysTick_Type			systick;
+	SCB_Type				scb;
+} Sim_reg;
+
+/*** モデルの内部状態 ***/
+static struct {
+	/* 時間 */
+	uint64_t	ps;			/* リセットからの経過時間 */
+	uint64_t	cycles;		/* リセットからのシステムクロック数 */
+	uint64_t	cycRem;		/* クロック数換算の余り(ps×Hz) */
+	Sim_cnt		cnt;		/* Sim_clrCnt以降のアクセス回数・経過時間 */
+
+	/* クロック */
+	uint32_t	pllSel;		/* 反映済みのPLL入力クロック選択 */
+	uint32_t	mainSel;	/* 反映済みのメインクロック選択 */
+	uint32_t	pllUen;		/* SYSPLLCLKUENの前回値 */
+	uint32_t	mainUen;	/* MAINCLKUENの前回値 */
+	uint32_t	pdrun;		/* PDRUNCFGの前回値 */
+	_Bool		pllFail;	/* PLLをロックさせない */
+	uint32_t	pllLockUs;	/* PLLのロック時間 */
+	int32_t		wdtOscPpm;	/* WDT用オシレータの公称値からの誤差(ppm) */
+
+	/* WDT */
+	_Bool		wdtRun;		/* カウント中 */
+	_Bool		wdtFeed1;	/* FEEDの1回目(0xAA)を受けた */
+	uint32_t	wdtTv;		/* 最後にFEEDした時のTV */
+	uint64_t	wdtPs;		/* 最後にFEEDした時刻 */
+	_Bool		wdtWarned;	/* 警告割り込み発生済み */
+	_Bool		wdtReset;	/* WDTによるリセット発生 */
+	uint32_t	wdtWarn;	/* 警告割り込みの発生回数 */
+
+	/* SysTick */
+	uint32_t	stVal;		/* 公開したVAL */
+
+	/* WKT */
+	_Bool		wktRun;		/* カウント中 */
+	_Bool		wktAlarm;	/* タイムアウトした */
+	uint32_t	wktCnt;		/* カウント開始時のCOUNT */
+	uint64_t	wktPs;		/* カウント開始時刻 */
+	uint32_t	wktPub;		/* 公開したCOUNT */
+	uint32_t	wktCtrl;	/* 公開したCTRL */
+
+	/* USART0 */
+	uint32_t	uIntEn;		/* 割り込み許可(INTENSETの読み出し値) */
+	uint32_t	uStat;		/* STATのうちRXRDYとエラーフラグ */
+	_Bool		txShift;	/* シフトレジスタで送信中 */
+	_Bool		txHold;		/* 保持レジスタにデータあり */
+	uint8_t		txShiftData;
+	uint8_t		txHoldData;
+	uint64_t	txEndPs;	/* 送信中の1バイトの完了時刻 */
+	uint8_t		txLog[SIM_UART_LOG];	/* 送信し終えたバイト */
+	uint32_t	txLogNum;
+
+	/* SWM */
+	uint32_t	swm[SWM_PINASSIGN_NUM + 1];	/* 確認済みのPINASSIGN0～8, PINENABLE0 */
+
+	/* GPIO */
+	uint8_t		gpioB[GPIO_PIN_NUM];	/* 公開したB0 */
+	uint32_t	gpioW[GPIO_PIN_NUM];	/* 公開したW0 */
+	uint32_t	gpioMpin;	/* 公開したMPIN0 */
+
+	/* MRT */
+	uint64_t	mrtCyc;		/* MRTが数えたクロック数(クロック供給中かつディープスリープ以外) */
+	uint64_t	mrtStart[MRT_CH_NUM];	/* ロードした時のmrtCyc */
+	uint32_t	mrtIval[MRT_CH_NUM];	/* ロードした時間間隔(0なら停止) */
+
+	/* SCT */
+	uint64_t	sctCyc;		/* SCTが数えたクロック数(クロック供給中かつディープスリープ以外) */
+	uint64_t	sctStart;	/* カウント開始時のsctCyc */
+	uint32_t	sctCnt0;	/* カウント開始時のCOUNT_U */
+	uint32_t	sctOut0;	/* カウント開始時のOUTPUT */
+	_Bool		sctRun;		/* カウント中 */
+	uint32_t	sctCtrl;	/* 公開したCTRL_U */
+	uint32_t	sctCount;	/* 公開したCOUNT_U */
+	uint32_t	sctOut;		/* 公開したOUTPUT */
+
+	_Bool		deep;		/* ディープスリープ中 */
+	uint64_t	deepPs;		/* ディープスリープ(パワーダウン含む)していた時間の合計(ps) */
+	_Bool		dpd;		/* ディープパワーダウンに入った */
+
+	/* 割り込み */
+	uint32_t	primask;
+	uint32_t	irqEn;		/* 許可済みの割り込み(ビットパターン) */
+	uint32_t	irqPend;	/* 保留中の割り込み(ビットパターン) */
+	_Bool		tickPend;	/* SysTick割り込み保留中 */
+	_Bool		inIrq;		/* 割り込み処理中 */
+
+	const char	*fault;		/* 最初に検出した誤操作 */
+
+	/* Sim_runApp */
+	_Bool		appRun;		/* アプリケーション実行中 */
+	uint64_t	appEndPs;	/* アプリケーションを止める時刻(ps) */
+} Sim;
+
+static jmp_buf	Sim_appJmp;	/* Sim_runAppへ戻るための環境 */
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static void		Sim_access(Sim_peri peri);
+static void		Sim_update(void);
+static void		Sim_publish(void);
+static void		Sim_run(uint64_t ps);
+static void		Sim_runCyc(uint32_t cyc);
+static void		Sim_dispatch(void);
+static void		Sim_setFault(const char *msg);
+static uint32_t	Sim_wdtOscHz(void);
+static uint32_t	Sim_wdtCntHz(void);
+static uint32_t	Sim_pllInHz(void);
+static uint32_t	Sim_calcMainHz(uint32_t sel);
+static uint32_t	Sim_wdtNowTv(void);
+static void		Sim_updPint(void);
+static void		Sim_updUart(void);
+static void		Sim_pubUart(void);
+static uint64_t	Sim_uartBytePs(void);
+static void		Sim_updMrt(void);
+static void		Sim_pubMrt(void);
+static void		Sim_updGpio(void);
+static void		Sim_updSwm(void);
+static void		Sim_pubGpio(void);
+static uint64_t	Sim_filterPs(uint32_t pin);
+static void		Sim_updSct(void);
+static void		Sim_pubSct(void);
+
+/***************************************************************************
+	ペリフェラルの取得(host/LPC8xx.hのLPC_xxxの実体)
+***************************************************************************/
+LPC_SYSCON_TypeDef *Sim_syscon(void)	{ Sim_access(SIM_SYSCON);	return &Sim_reg.syscon; }
+LPC_WWDT_TypeDef *Sim_wwdt(void)		{ Sim_access(SIM_WWDT);		return &Sim_reg.wwdt; }
+LPC_GPIO_PORT_TypeDef *Sim_gpio(void)	{ Sim_access(SIM_GPIO);		return &Sim_reg.gpio; }
+LPC_SWM_TypeDef *Sim_swm(void)			{ Sim_access(SIM_SWM);		return &Sim_reg.swm; }
+LPC_IOCON_TypeDef *Sim_iocon(void)		{ Sim_access(SIM_IOCON);	return &Sim_reg.iocon; }
+LPC_PMU_TypeDef *Sim_pmu(void)			{ Sim_access(SIM_PMU);		return &Sim_reg.pmu; }
+LPC_WKT_TypeDef *Sim_wkt(void)			{ Sim_access(SIM_WKT);		return &Sim_reg.wkt; }
+SysTick_Type *Sim_systick(void)			{ Sim_access(SIM_SYSTICK);	return &Sim_reg.systick; }
+SCB_Type *Sim_scb(void)					{ Sim_access(SIM_SCB);		return &Sim_reg.scb; }
+LPC_PIN_INT_TypeDef *Sim_pint(void)		{ Sim_access(SIM_PINT);		return &Sim_reg.pint; }
+LPC_USART_TypeDef *Sim_usart0(void)		{ Sim_access(SIM_USART0);	return &Sim_reg.usart0; }
+LPC_MRT_TypeDef *Sim_mrt(void)			{ Sim_access(SIM_MRT);		return &Sim_reg.mrt; }
+LPC_FLASHCTRL_TypeDef *Sim_flashctrl(void)	{ Sim_access(SIM_FLASHCTRL);	return &Sim_reg.flashctrl; }
+LPC_SCT_TypeDef *Sim_sct(void)			{ Sim_access(SIM_SCT);		return &Sim_reg.sct; }
+
+/***************************************************************************
+	Sim_reset
+	モデルのリセット
+
+	[引数]	rststat	リセット後のSYSRSTSTATの値(SYS_RST_*)
+	[戻値]	なし
+
+	レジスタをリセット値にする。.noinitセクションの変数はホストのメモリ上
+	にあるので、そのまま残る(リセットをまたいだ記録の確認に使える)。
+***************************************************************************/
+void Sim_reset(uint32_t rststat)
+{
+	uint32_t	pllLockUs = Sim.pllLockUs;
+	int32_t		wdtOscPpm = Sim.wdtOscPpm;
+	uint32_t	i;
+
+	memset(&Sim_reg, 0, sizeof(Sim_reg));
+	memset(&Sim, 0, sizeof(Sim));
+	Sim.pllLockUs = (pllLockUs != 0)? pllLockUs: SIM_PLL_LOCK_US;
+	Sim.wdtOscPpm = wdtOscPpm;	/* チップの特性なのでリセットをまたいで残す */
+
+	/* UM10601 - Chapter 4: LPC800 System configuration (SYSCON)のリセット値 */
+	Sim_reg.syscon.PRESETCTRL = 0x00001FFF;
+	Sim_reg.syscon.SYSRSTSTAT = rststat;
+	Sim_reg.syscon.SYSAHBCLKDIV = 1;
+	Sim_reg.syscon.SYSAHBCLKCTRL = 0x000000DF;
+	Sim_reg.syscon.PDSLEEPCFG = 0x0000FFFF;
+	Sim_reg.syscon.PDAWAKECFG = 0x0000EDF0;
+	Sim_reg.syscon.PDRUNCFG = 0x0000EDF0;
+	Sim_reg.syscon.WDTOSCCTRL = 0x000000A0;
+	Sim.pdrun = Sim_reg.syscon.PDRUNCFG;
+
+	Sim_reg.flashctrl.FLASHCFG = SIM_FLASHCFG_RSV | FLASH_TIM_2CLK;
+
+	/* UM10601 - 12.6 WWDTのリセット値 */
+	Sim_reg.wwdt.TC = 0xFF;
+	Sim_reg.wwdt.TV = 0xFF;
+	Sim_reg.wwdt.WINDOW = 0xFFFFFF;
+
+	Sim_reg.swm.PINASSIGN0 = 0xFFFFFFFF;
+	Sim_reg.swm.PINASSIGN1 = 0xFFFFFFFF;
+	Sim_reg.swm.PINASSIGN2 = 0xFFFFFFFF;
+	Sim_reg.swm.PINASSIGN3 = 0xFFFFFFFF;
+	Sim_reg.swm.PINASSIGN4 = 0xFFFFFFFF;
+	Sim_reg.swm.PINASSIGN5 = 0xFFFFFFFF;
+	Sim_reg.swm.PINASSIGN6 = 0xFFFFFFFF;
+	Sim_reg.swm.PINASSIGN7 = 0xFFFFFFFF;
+	Sim_reg.swm.PINASSIGN8 = 0xFFFFFFFF;
+	Sim_reg.swm.PINENABLE0 = 0x000001B3;
+
+	/* UM10601 - 6.5 IOCONのリセット値(プルアップ、ヒステリシスなし、フィルタなし) */
+	for (i = 0; i < GPIO_PIN_NUM; i++) {
+		(&Sim_reg.iocon.PIO0_17)[Sim_ioconIdx[i]] = 0x00000090;
+	}
+
+	Sim_reg.gpio.PIN0 = 0x0003FFFF;	/* 入力はすべてプルアップでH */
+
+	Sim_reg.usart0.TXDATA = SIM_UART_TXNONE;
+
+	Sim_reg.sct.CTRL_U = SIM_SCT_CTRL_RST;
+	Sim.sctCtrl = SIM_SCT_CTRL_RST;
+}
+
+/***************************************************************************
+	アクセス回数・時間
+***************************************************************************/
+void Sim_clrCnt(void)
+{
+	memset(&Sim.cnt, 0, sizeof(Sim.cnt));
+}
+
+void Sim_getCnt(Sim_cnt *cnt)
+{
+	*cnt = Sim.cnt;
+}
+
+uint64_t Sim_getTimeUs(void)
+{
+	return Sim.ps / SIM_PS_PER_US;
+}
+
+/***************************************************************************
+	Sim_advanceUs
+	時間を進める
+
+	[引数]	us	進める時間(us)
+	[戻値]	なし
+
+	コアが何もしないまま時間が経過したものとする。
+	割り込み許可中であれば、その間に発生した割り込みを配送する。
+***************************************************************************/
+void Sim_advanceUs(uint32_t us)
+{
+	Sim_update();
+	Sim_run((uint64_t)us * SIM_PS_PER_US);
+	Sim_publish();
+	if (Sim.primask == 0) {
+		Sim_dispatch();
+	}
+}
+
+/***************************************************************************
+	モデルの状態取得・設定
+***************************************************************************/
+uint32_t Sim_getMainHz(void)
+{
+	return Sim_calcMainHz(Sim.mainSel);
+}
+
+uint32_t Sim_getCoreHz(void)
+{
+	uint32_t	div = Sim_reg.syscon.SYSAHBCLKDIV & 0xFF;
+
+	return (div == 0)? 0: Sim_getMainHz() / div;
+}
+
+void Sim_setPllFail(_Bool fail)
+{
+	Sim.pllFail = fail;
+}
+
+void Sim_setPllLockUs(uint32_t us)
+{
+	Sim.pllLockUs = us;
+}
+
+void Sim_setWdtOscPpm(int32_t ppm)
+{
+	Sim.wdtOscPpm = ppm;
+}
+
+_Bool Sim_isDpd(void)
+{
+	return Sim.dpd;
+}
+
+uint64_t Sim_getDeepUs(void)
+{
+	return Sim.deepPs / SIM_PS_PER_US;
+}
+
+_Bool Sim_isWdtReset(void)
+{
+	return Sim.wdtReset;
+}
+
+uint32_t Sim_getWdtWarn(void)
+{
+	return Sim.wdtWarn;
+}
+
+const char *Sim_getFault(void)
+{
+	return Sim.fault;
+}
+
+/***************************************************************************
+	Sim_setPin
+	入力ピンのレベル設定
+
+	[引数]	pin		ピン番号(0:PIO0_0～)
+			high	H(true), L(false)
+	[戻値]	なし
+
+	出力ピン(DIR0が1)は変えない。
+	PINTSELでこのピンを選んでいるエッジ検出のチャネルは、IENR, IENFに従っ
+	てRISE, FALL, ISTをセットし、割り込みを発生する。
+	入力フィルタのクロックが止まっているピンは、レベルを変えずに誤操作と
+	する(変化しないレベルの設定は除く)。
+***************************************************************************/
+void Sim_setPin(uint32_t pin, _Bool high)
+{
+	LPC_PIN_INT_TypeDef	*pi = &Sim_reg.pint;
+	uint32_t			bit = 0x1UL << pin;
+	uint32_t			old = Sim_reg.gpio.PIN0 & bit;
+	uint32_t			ch, chbit;
+
+	Sim_update();
+	if ((Sim_reg.gpio.DIR0 & bit) != 0) {
+		return;
+	}
+	if ((old != 0) != high && Sim_filterPs(pin) == UINT64_MAX) {
+		Sim_setFault("IOCON filter enabled with IOCONCLKDIV=0");
+		return;
+	}
+	if (high) {
+		Sim_reg.gpio.PIN0 |= bit;
+	}
+	else {
+		Sim_reg.gpio.PIN0 &= ~bit;
+	}
+	for (ch = 0; ch < PINT_CH_NUM; ch++) {
+		chbit = 0x1UL << ch;
+		if (Sim_reg.syscon.PINTSEL[ch] != pin || (pi->ISEL & chbit) != 0) {
+			continue;
+		}
+		if (old == 0 && high && (pi->IENR & chbit) != 0) {
+			pi->RISE |= chbit;
+			pi->IST |= chbit;
+			Sim.irqPend |= 0x1UL << (PININT0_IRQn + ch);
+		}
+		if (old != 0 && !high && (pi->IENF & chbit) != 0) {
+			pi->FALL |= chbit;
+			pi->IST |= chbit;
+			Sim.irqPend |= 0x1UL << (PININT0_IRQn + ch);
+		}
+	}
+	Sim_update();
+	if (Sim.primask == 0) {
+		Sim_dispatch();
+	}
+}
+
+/***************************************************************************
+	Sim_pulsePin
+	入力ピンへのパルス入力
+
+	[引数]	pin		ピン番号(0:PIO0_0～)
+			high	パルスのレベル H(true), L(false)
+			us		パルスの長さ(us)
+	[戻値]	入力フィルタを通過した(true), 除かれた(false)
+
+	入力フィルタ(IOCONのS_MODE)で除かれる長さであれば、レベルを変えずに時
+	間だけ進める。通過する場合は、Sim_setPinでレベルを変え、時間を進めて
+	から元のレベルに戻す。入力フィルタを使っていないピンは常に通過する。
+***************************************************************************/
+_Bool Sim_pulsePin(uint32_t pin, _Bool high, uint32_t us)
+{
+	uint64_t	filt;
+
+	Sim_update();
+	filt = Sim_filterPs(pin);
+	if (filt == UINT64_MAX) {
+		Sim_setFault("IOCON filter enabled with IOCONCLKDIV=0");
+		return false;
+	}
+	if ((uint64_t)us * SIM_PS_PER_US < filt) {
+		Sim_advanceUs(us);
+		return false;
+	}
+	Sim_setPin(pin, high);
+	Sim_advanceUs(us);
+	Sim_setPin(pin, !high);
+	return true;
+}
+
+/***************************************************************************
+	Sim_uartRx
+	USART0での1バイト受信
+
+	[引数]	data	受信データ
+	[戻値]	なし
+
+	USART0が停止中なら捨てる。前の受信データがRXDATAに残っていればオー
+	バーランとして捨てる。
+***************************************************************************/
+void Sim_uartRx(uint8_t data)
+{
+	Sim_update();
+	if (Sim_uartBytePs() != 0) {
+		if ((Sim.uStat & UART_RXRDY) != 0) {
+			Sim.uStat |= UART_OVERRUN;
+		}
+		else {
+			Sim_reg.usart0.RXDATA = data;
+			Sim.uStat |= UART_RXRDY;
+		}
+	}
+	Sim_publish();
+	if (Sim.primask == 0) {
+		Sim_dispatch();
+	}
+}
+
+/***************************************************************************
+	Sim_uartTx
+	USART0で送信し終えたバイトの取り出し
+
+	[引数]	buf	格納先
+			max	格納先のバイト数
+	[戻値]	取り出したバイト数
+
+	取り出した分は記録から消す。記録はSIM_UART_LOGバイトまで。
+***************************************************************************/
+uint32_t Sim_uartTx(uint8_t *buf, uint32_t max)
+{
+	uint32_t	num = (Sim.txLogNum < max)? Sim.txLogNum: max;
+
+	memcpy(buf, Sim.txLog, num);
+	memmove(Sim.txLog, &Sim.txLog[num], Sim.txLogNum - num);
+	Sim.txLogNum -= num;
+	return num;
+}
+
+/***************************************************************************
+	Sim_getUartBaud
+	モデル上のUSART0の伝送速度
+
+	[引数]	なし
+	[戻値]	伝送速度(bps)、停止中は0
+***************************************************************************/
+uint32_t Sim_getUartBaud(void)
+{
+	uint64_t	ps = Sim_uartBytePs();
+
+	return (ps == 0)? 0: (uint32_t)((SIM_UART_BITS * SIM_PS_PER_SEC + ps / 2) / ps);
+}
+
+/***************************************************************************
+	Sim_runApp
+	アプリケーション(戻らない定常ループ)の実行
+
+	[引数]	app	実行する関数(main.cのmainなど)
+			ms	実行する時間(ms)
+	[戻値]	なし
+
+	指定時間が経過するか、WDTによるリセット、誤操作の検出が起きた後の最初
+	のペリフェラル参照で、appを抜けて戻る(longjmp)。appの途中で抜けるので、
+	続けてモデルを使う場合はSim_resetから始めること。
+***************************************************************************/
+void Sim_runApp(int (*app)(void), uint32_t ms)
+{
+	Sim.appEndPs = Sim.ps + (uint64_t)ms * 1000 * SIM_PS_PER_US;
+	if (setjmp(Sim_appJmp) == 0) {
+		Sim.appRun = true;
+		(void)app();
+	}
+	Sim.appRun = false;
+}
+
+/***************************************************************************
+	CMSIS関数の置き換え
+***************************************************************************/
+void Sim_nop(void)
+{
+	Sim_runCyc(1);
+}
+
+/***************************************************************************
+	Sim_bkpt
+	BKPT命令の模擬
+
+	[引数]	なし
+	[戻値]	なし
+
+	ライブラリが誤用を検出して停止した箇所なので、誤操作として記録する。
+	本物と違って停止はせず、呼び出し元へ戻る。
+***************************************************************************/
+void Sim_bkpt(void)
+{
+	Sim_setFault("BKPT executed");
+}
+
+/***************************************************************************
+	Sim_wfi
+	WFIの模擬
+
+	[引数]	なし
+	[戻値]	なし
+
+	次の起床要因(SysTick割り込み、WKTタイムアウト、WDT警告割り込み)まで
+	時間を進める。割り込み禁止中でも起床はするが、ハンドラは割り込み許可
+	時に呼ぶ(本物と同じ)。
+	ディープスリープ(SCR.SLEEPDEEP)中はSysTickが止まり、STARTERP1で許可
+	された要因でしか起床しない。
+***************************************************************************/
+void Sim_wfi(void)
+{
+	_Bool		deep = ((Sim_reg.scb.SCR & SCB_SCR_SLEEPDEEP_Msk) != 0)? true: false;
+	uint64_t	wait = (uint64_t)SIM_WFI_MAX_US * SIM_PS_PER_US;
+	uint64_t	ps;
+	uint32_t	hz;
+	_Bool		woke = false;
+
+	Sim_update();
+	if ((Sim.irqPend & Sim.irqEn) != 0 || Sim.tickPend) {
+		return;		/* 保留中の割り込みがあれば即座に起床 */
+	}
+	if (deep && (Sim.mainSel == SYS_MAIN_CLK_PLLOUT)) {
+		Sim_setFault("deep-sleep with PLL main clock");
+	}
+	if (deep && Sim.wdtRun && (Sim_reg.syscon.PDSLEEPCFG & SYS_WDTOSC_PD) != 0) {
+		Sim_setFault("WDT oscillator powered down in deep-sleep while WDT running");
+	}
+	if (deep && (Sim_reg.pmu.PCON & PMU_PM) == PMU_PM_DPD) {
+		Sim.dpd = true;		/* 本物はリセットで起床する(戻らない) */
+		return;
+	}
+
+	/* SysTick */
+	hz = Sim_getCoreHz();
+	if (!deep && hz != 0
+	 && (Sim_reg.systick.CTRL & (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk))
+			== (SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk)) {
+		ps = ((uint64_t)Sim.stVal + 1) * SIM_PS_PER_SEC / hz;
+		if (ps < wait) {
+			wait = ps;
+			woke = true;
+		}
+	}
+	/* WKT */
+	if (Sim.wktRun && (!deep || (Sim_reg.syscon.STARTERP1 & SYS_START_WKT) != 0)) {
+		hz = ((Sim_reg.wkt.CTRL & WKT_CLKSEL) != 0)? SIM_LPOSC_HZ: IRC_HZ / SIM_WKT_IRC_DIV;
+		ps = ((uint64_t)Sim.wktPub + 1) * SIM_PS_PER_SEC / hz;
+		if (ps < wait) {
+			wait = ps;
+			woke = true;
+		}
+	}
+	/* WDT警告割り込み */
+	if (Sim.wdtRun && !Sim.wdtWarned && ((Sim.irqEn & (0x1UL << WDT_IRQn)) != 0)
+	 && (!deep || (Sim_reg.syscon.STARTERP1 & SYS_START_WWDT) != 0)) {
+		uint32_t	tv = Sim_wdtNowTv();
+		uint32_t	warn = Sim_reg.wwdt.WARNINT;
+
+		hz = Sim_wdtCntHz();
+		ps = (tv > warn)? ((uint64_t)(tv - warn) + 1) * SIM_PS_PER_SEC / hz: 0;
+		if (ps < wait) {
+			wait = ps;
+			woke = true;
+		}
+	}
+	/* USART0の送信(TXRDY, TXIDLEの割り込み) */
+	if (Sim.txShift) {
+		if (deep) {
+			Sim_setFault("deep-sleep while USART0 transmitting");
+		}
+		else if ((Sim.uIntEn & (UART_TXRDY | UART_TXIDLE)) != 0
+		 && (Sim.irqEn & (0x1UL << UART0_IRQn)) != 0) {
+			ps = Sim.txEndPs - Sim.ps;
+			if (ps < wait) {
+				wait = ps;
+				woke = true;
+			}
+		}
+	}
+	if (!woke) {
+		Sim_setFault("WFI without wake-up source");
+	}
+
+	if (deep) {
+		uint32_t	ctrl = Sim_reg.systick.CTRL;
+
+		Sim_reg.systick.CTRL = 0;		/* ディープスリープ中はSysTick, MRT停止 */
+		Sim.deep = true;
+		Sim_run(wait);
+		Sim.deep = false;
+		Sim.deepPs += wait;
+		Sim_reg.systick.CTRL = ctrl;
+
+		/* 起床時の電源(停止中に落ちたPLLは電源投入としてロックし直す) */
+		Sim.pdrun |= SYS_SYSPLL_PD;
+		Sim_reg.syscon.SYSPLLSTAT = SYS_PLL_NOT_LOCKED;
+		Sim_reg.syscon.PDRUNCFG = Sim_reg.syscon.PDAWAKECFG;
+		Sim_update();
+	}
+	else {
+		Sim_run(wait);
+	}
+	Sim_publish();
+	if (Sim.primask == 0) {
+		Sim_dispatch();
+	}
+}
+
+void Sim_setPrimask(uint32_t primask)
+{
+	Sim.primask = primask & 0x1;
+	if (Sim.primask == 0) {
+		Sim_dispatch();
+	}
+}
+
+uint32_t Sim_getPrimask(void)
+{
+	return Sim.primask;
+}
+
+void Sim_enableIrq(IRQn_Type irq, _Bool en)
+{
+	if (irq < 0 || (uint32_t)irq >= SIM_IRQ_NUM) {
+		return;
+	}
+	if (en) {
+		Sim.irqEn |= 0x1UL << irq;
+	}
+	else {
+		Sim.irqEn &= ~(0x1UL << irq);
+	}
+}
+
+void Sim_setPendIrq(IRQn_Type irq, _Bool pend)
+{
+	if (irq == SysTick_IRQn) {
+		Sim.tickPend = pend;
+		return;
+	}
+	if (irq < 0 || (uint32_t)irq >= SIM_IRQ_NUM) {
+		return;
+	}
+	if (pend) {
+		Sim.irqPend |= 0x1UL << irq;
+	}
+	else {
+		Sim.irqPend &= ~(0x1UL << irq);
+	}
+}
+
+void Sim_setPriority(IRQn_Type irq, uint32_t pri)
+{
+	(void)irq;
+	(void)pri;		/* 優先度は模擬しない */
+}
+
+/***************************************************************************
+	Sim_sysTickConfig
+	SysTick_Configの模擬
+
+	CMSISのSysTick_Configと同じくLOAD, VAL, CTRLの順に書く。
+***************************************************************************/
+uint32_t Sim_sysTickConfig(uint32_t ticks)
+{
+	if ((ticks - 1) > SysTick_LOAD_RELOAD_Msk) {
+		return 1;
+	}
+	SysTick->LOAD = ticks - 1;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+	return 0;
+}
+
+/***************************************************************************
+	Sim_access
+	ペリフェラル参照1回分の処理
+
+	[引数]	peri	参照されたペリフェラル
+	[戻値]	なし
+***************************************************************************/
+static void Sim_access(Sim_peri peri)
+{
+	/* ペリフェラル毎のクロック(SYSAHBCLKCTRL)、0は常に供給 */
+	static const uint32_t	clk[SIM_PERI_NUM] = {
+		0, SYS_AHB_CLK_WWDT, SYS_AHB_CLK_GPIO, SYS_AHB_CLK_SWM, SYS_AHB_CLK_IOCON,
+		0, SYS_AHB_CLK_WKT, 0, 0, SYS_AHB_CLK_GPIO, SYS_AHB_CLK_UART0, SYS_AHB_CLK_MRT,
+		SYS_AHB_CLK_FLASHREG, SYS_AHB_CLK_SCT
+	};
+
+	if (Sim.appRun && (Sim.ps >= Sim.appEndPs || Sim.wdtReset || Sim.fault != NULL)) {
+		Sim.appRun = false;
+		longjmp(Sim_appJmp, 1);		/* Sim_runAppへ戻る */
+	}
+	if ((Sim_reg.syscon.SYSAHBCLKCTRL & clk[peri]) != clk[peri]) {
+		Sim_setFault("access to peripheral without clock");
+	}
+	Sim.cnt.acc[peri]++;
+	Sim.cnt.total++;
+	Sim_update();
+	Sim_runCyc(SIM_ACC_CYC);
+	Sim_publish();
+}
+
+/***************************************************************************
+	Sim_update
+	書き込まれた値のハードウェアへの反映
+***************************************************************************/
+static void Sim_update(void)
+{
+	LPC_SYSCON_TypeDef	*sc = &Sim_reg.syscon;
+	uint32_t			pdrun = sc->PDRUNCFG;
+	uint32_t			oldhz, newhz;
+
+	/* SysTickのVALへの書き込み(カウンタをクリア)
+	   ※以降で時間を進めるとVALが変わるので、最初に調べる */
+	if (Sim_reg.systick.VAL != Sim.stVal) {
+		Sim_reg.systick.VAL = 0;
+		Sim.stVal = 0;
+		Sim_reg.systick.CTRL &= ~SysTick_CTRL_COUNTFLAG_Msk;
+	}
+
+	/* WKT */
+	if (Sim_reg.wkt.CTRL != Sim.wktCtrl) {
+		if ((Sim_reg.wkt.CTRL & WKT_ALARMFLAG) != 0) {
+			Sim.wktAlarm = false;		/* 1書きでクリア */
+		}
+		if ((Sim_reg.wkt.CTRL & WKT_CLEARCTR) != 0) {
+			Sim.wktRun = false;
+			Sim_reg.wkt.COUNT = 0;
+			Sim.wktPub = 0;
+		}
+	}
+	if (Sim_reg.wkt.COUNT != Sim.wktPub) {
+		Sim.wktRun = (Sim_reg.wkt.COUNT != 0)? true: false;
+		Sim.wktCnt = Sim_reg.wkt.COUNT;
+		Sim.wktPs = Sim.ps;
+		if ((Sim_reg.wkt.CTRL & WKT_CLKSEL) != 0
+		 && (Sim_reg.pmu.DPDCTRL & PMU_LPOSCEN) == 0) {
+			Sim_setFault("WKT started without low-power oscillator");
+		}
+	}
+
+	/* PLL入力クロックの切り替え(UENの0→1) */
+	if (sc->SYSPLLCLKUEN != Sim.pllUen) {
+		if ((Sim.pllUen & SYS_PLL_CLK_UPDATE) == 0 && (sc->SYSPLLCLKUEN & SYS_PLL_CLK_UPDATE) != 0) {
+			Sim.pllSel = sc->SYSPLLCLKSEL & SYS_PLL_CLK_SEL;
+		}
+		Sim.pllUen = sc->SYSPLLCLKUEN;
+	}
+
+	/* PLLの電源 */
+	if ((pdrun ^ Sim.pdrun) & SYS_SYSPLL_PD) {
+		if ((pdrun & SYS_SYSPLL_PD) == 0) {
+			if (!Sim.pllFail && Sim_pllInHz() != 0) {
+				Sim_run((uint64_t)Sim.pllLockUs * SIM_PS_PER_US);	/* ロック待ちの時間 */
+				sc->SYSPLLSTAT = SYS_PLL_LOCKED;
+			}
+		}
+		else {
+			sc->SYSPLLSTAT = SYS_PLL_NOT_LOCKED;
+		}
+	}
+	/* WDT用オシレータの電源(WDTは止まる) */
+	if ((pdrun & SYS_WDTOSC_PD) != 0) {
+		Sim.wdtRun = false;
+	}
+	Sim.pdrun = pdrun;
+
+	/* メインクロックの切り替え(UENの0→1) */
+	if (sc->MAINCLKUEN != Sim.mainUen) {
+		if ((Sim.mainUen & SYS_MAIN_CLK_UPDATE) == 0 && (sc->MAINCLKUEN & SYS_MAIN_CLK_UPDATE) != 0) {
+			oldhz = Sim_getCoreHz();
+			Sim.mainSel = sc->MAINCLKSEL & SYS_MAIN_CLK_SEL;
+			newhz = Sim_getCoreHz();
+			if (newhz == 0) {
+				Sim_setFault("main clock stopped by MAINCLKSEL");
+			}
+			else {
+				/* 切り替え前後のクロックで同期 */
+				Sim_run(SIM_UEN_SYNC * SIM_PS_PER_SEC / oldhz
+					  + SIM_UEN_SYNC * SIM_PS_PER_SEC / newhz);
+			}
+			Sim.cycRem = 0;
+		}
+		Sim.mainUen = sc->MAINCLKUEN;
+	}
+	if (Sim_getCoreHz() == 0) {
+		Sim_setFault("main clock stopped (power-down or SYSAHBCLKDIV=0)");
+	}
+
+	/* フラッシュのアクセス時間(予約値とシステムクロックに対する不足) */
+	if ((Sim_reg.flashctrl.FLASHCFG & FLASH_TIM) > FLASH_TIM_2CLK
+	 || ((Sim_reg.flashctrl.FLASHCFG & FLASH_TIM) == FLASH_TIM_1CLK && Sim_getCoreHz() > FLASH_1CLK_MAX_HZ)) {
+		Sim_setFault("flash access time too short for system clock");
+	}
+	if ((Sim_reg.flashctrl.FLASHCFG & ~FLASH_TIM) != SIM_FLASHCFG_RSV) {
+		Sim_setFault("FLASHCFG reserved bits changed");
+	}
+
+	/* WDTのFEED */
+	if (Sim_reg.wwdt.FEED != 0) {
+		uint32_t	feed = Sim_reg.wwdt.FEED;
+
+		Sim_reg.wwdt.FEED = 0;
+		if (feed == SIM_FEED_1ST) {
+			Sim.wdtFeed1 = true;
+		}
+		else if (feed == SIM_FEED_2ND && Sim.wdtFeed1) {
+			Sim.wdtFeed1 = false;
+			if ((Sim_reg.wwdt.MOD & WWDT_WDEN) != 0) {
+				if (Sim.wdtRun && Sim_wdtNowTv() > Sim_reg.wwdt.WINDOW) {
+					Sim_setFault("WDT fed in guard window");
+					Sim.wdtReset = ((Sim_reg.wwdt.MOD & WWDT_WDRESET) != 0)? true: Sim.wdtReset;
+				}
+				if (Sim_wdtCntHz() == 0) {
+					Sim_setFault("WDT enabled without WDT oscillator");
+				}
+				else {
+					Sim.wdtRun = true;
+				}
+			}
+			Sim.wdtTv = Sim_reg.wwdt.TC;
+			Sim.wdtPs = Sim.ps;
+			Sim.wdtWarned = false;
+		}
+		else {
+			Sim.wdtFeed1 = false;
+			if ((Sim_reg.wwdt.MOD & WWDT_WDEN) != 0) {
+				Sim_setFault("invalid WDT feed sequence");
+			}
+		}
+	}
+
+	/* PINTのセット/クリアレジスタとレベル検出 */
+	Sim_updPint();
+
+	/* USART0の割り込み許可と送信 */
+	Sim_updUart();
+
+	/* MRTのINTVALへの書き込み */
+	Sim_updMrt();
+
+	/* GPIOの出力 */
+	Sim_updGpio();
+
+	/* SWMのピンの重複 */
+	Sim_updSwm();
+
+	/* SCTのカウンタの開始・中断 */
+	Sim_updSct();
+}
+
+/***************************************************************************
+	Sim_updPint
+	ピン割り込みの設定の反映とレベル検出
+***************************************************************************/
+static void Sim_updPint(void)
+{
+	LPC_PIN_INT_TypeDef	*pi = &Sim_reg.pint;
+	uint32_t			ch, chbit, level;
+
+	pi->IENR = (pi->IENR | pi->SIENR) & ~pi->CIENR;
+	pi->IENF = (pi->IENF | pi->SIENF) & ~pi->CIENF;
+	pi->SIENR = 0;
+	pi->CIENR = 0;
+	pi->SIENF = 0;
+	pi->CIENF = 0;
+
+	for (ch = 0; ch < PINT_CH_NUM; ch++) {
+		chbit = 0x1UL << ch;
+		if ((pi->ISEL & chbit) == 0) {
+			continue;
+		}
+		level = (Sim_reg.gpio.PIN0 >> Sim_reg.syscon.PINTSEL[ch]) & 0x1;
+		if ((pi->IENR & chbit) != 0 && level == ((pi->IENF >> ch) & 0x1)) {
+			pi->IST |= chbit;
+			Sim.irqPend |= 0x1UL << (PININT0_IRQn + ch);
+		}
+		else {
+			pi->IST &= ~chbit;
+		}
+	}
+}
+
+/***************************************************************************
+	Sim_updUart
+	USART0の割り込み許可の反映とTXDATAへの書き込み
+***************************************************************************/
+static void Sim_updUart(void)
+{
+	LPC_USART_TypeDef	*us = &Sim_reg.usart0;
+	uint8_t				data;
+
+	Sim.uIntEn = (Sim.uIntEn | us->INTENSET) & ~us->INTENCLR;
+	us->INTENSET = Sim.uIntEn;
+	us->INTENCLR = 0;
+
+	if (us->TXDATA == SIM_UART_TXNONE) {
+		return;
+	}
+	data = (uint8_t)us->TXDATA;
+	us->TXDATA = SIM_UART_TXNONE;
+	if (Sim_uartBytePs() == 0) {
+		Sim_setFault("TXDATA written while USART0 stopped");
+	}
+	else if (!Sim.txShift) {
+		Sim.txShift = true;
+		Sim.txShiftData = data;
+		Sim.txEndPs = Sim.ps + Sim_uartBytePs();
+	}
+	else if (!Sim.txHold) {
+		Sim.txHold = true;
+		Sim.txHoldData = data;
+	}
+	else {
+		Sim_setFault("TXDATA written while not TXRDY");
+	}
+}
+
+/***************************************************************************
+	Sim_pubUart
+	USART0の送信の進行とSTATの更新
+***************************************************************************/
+static void Sim_pubUart(void)
+{
+	_Bool		run = (Sim_uartBytePs() != 0)? true: false;
+	uint32_t	stat;
+
+	while (Sim.txShift && Sim.ps >= Sim.txEndPs) {
+		if (Sim.txLogNum < SIM_UART_LOG) {
+			Sim.txLog[Sim.txLogNum++] = Sim.txShiftData;
+		}
+		Sim.txShift = Sim.txHold;
+		Sim.txShiftData = Sim.txHoldData;
+		Sim.txHold = false;
+		Sim.txEndPs += Sim_uartBytePs();
+	}
+	stat = Sim.uStat | UART_RXIDLE;
+	if (run && !Sim.txHold) {
+		stat |= UART_TXRDY;
+	}
+	if (!Sim.txShift && !Sim.txHold) {
+		stat |= UART_TXIDLE;
+	}
+	Sim_reg.usart0.STAT = stat;
+	Sim_reg.usart0.INTSTAT = stat & Sim.uIntEn;
+	if (Sim_reg.usart0.INTSTAT != 0) {
+		Sim.irqPend |= 0x1UL << UART0_IRQn;
+	}
+}
+
+/***************************************************************************
+	Sim_uartBytePs
+	USART0で1バイト(SIM_UART_BITSビット)送る時間
+
+	[引数]	なし
+	[戻値]	時間(ps)、USART0が停止中(クロックなし、リセット中、無効)なら0
+***************************************************************************/
+static uint64_t Sim_uartBytePs(void)
+{
+	LPC_SYSCON_TypeDef	*sc = &Sim_reg.syscon;
+	uint32_t			clkdiv = sc->UARTCLKDIV & 0xFF;
+	uint32_t			frgdiv = (sc->UARTFRGDIV & 0xFF) + 1;
+	uint32_t			hz = Sim_getMainHz();
+	unsigned __int128	num;
+
+	if ((sc->SYSAHBCLKCTRL & SYS_AHB_CLK_UART0) == 0
+	 || (sc->PRESETCTRL & (SYS_UART0_RST_N | SYS_UARTFRG_RST_N)) != (SYS_UART0_RST_N | SYS_UARTFRG_RST_N)
+	 || (Sim_reg.usart0.CFG & UART_CFG_ENABLE) == 0 || clkdiv == 0 || hz == 0) {
+		return 0;
+	}
+	/* 1ビット = 16 * (BRG+1) * UARTCLKDIV * (1 + MULT/(DIV+1)) / メインクロック */
+	num = (unsigned __int128)SIM_UART_BITS * SIM_PS_PER_SEC * UART_OVERSAMPLE
+		* ((Sim_reg.usart0.BRG & 0xFFFF) + 1) * clkdiv * (frgdiv + (sc->UARTFRGMULT & 0xFF));
+	return (uint64_t)(num / ((uint64_t)hz * frgdiv));
+}
+
+/***************************************************************************
+	Sim_updMrt
+	MRTのリセットとINTVALへの書き込み
+***************************************************************************/
+static void Sim_updMrt(void)
+{
+	uint32_t	ch, val;
+
+	if ((Sim_reg.syscon.PRESETCTRL & SYS_MRT_RST_N) == 0) {
+		memset(&Sim_reg.mrt, 0, sizeof(Sim_reg.mrt));
+		memset(Sim.mrtIval, 0, sizeof(Sim.mrtIval));
+		return;
+	}
+	for (ch = 0; ch < MRT_CH_NUM; ch++) {
+		val = Sim_reg.mrt.Channel[ch].INTVAL;
+		if (val == Sim.mrtIval[ch]) {
+			continue;
+		}
+		if ((Sim_reg.syscon.SYSAHBCLKCTRL & SYS_AHB_CLK_MRT) == 0) {
+			Sim_setFault("MRT written without clock");
+		}
+		if ((Sim_reg.mrt.Channel[ch].CTRL & MRT_MODE) != MRT_MODE_REPEAT) {
+			Sim_setFault("MRT one-shot mode not modeled");
+		}
+		Sim.mrtIval[ch] = val & MRT_IVALUE_MAX;
+		Sim.mrtStart[ch] = Sim.mrtCyc;
+		Sim_reg.mrt.Channel[ch].INTVAL = Sim.mrtIval[ch];
+	}
+}
+
+/***************************************************************************
+	Sim_pubMrt
+	MRTのTIMER, STATの更新
+
+	TIMERはIVALUEから0まで数えてIVALUEに戻る(周期はIVALUE+1クロック)。
+***************************************************************************/
+static void Sim_pubMrt(void)
+{
+	uint32_t	ch, ival;
+
+	for (ch = 0; ch < MRT_CH_NUM; ch++) {
+		ival = Sim.mrtIval[ch];
+		if (ival == 0) {
+			Sim_reg.mrt.Channel[ch].TIMER = 0;
+			Sim_reg.mrt.Channel[ch].STAT &= ~MRT_RUN;
+		}
+		else {
+			Sim_reg.mrt.Channel[ch].TIMER =
+				ival - (uint32_t)((Sim.mrtCyc - Sim.mrtStart[ch]) % ((uint64_t)ival + 1));
+			Sim_reg.mrt.Channel[ch].STAT |= MRT_RUN;
+		}
+	}
+}
+
+/***************************************************************************
+	Sim_updGpio
+	GPIOの出力レジスタへの書き込み
+***************************************************************************/
+static void Sim_updGpio(void)
+{
+	LPC_GPIO_PORT_TypeDef	*g = &Sim_reg.gpio;
+	uint32_t				pin, bit, out;
+
+	if (g->SET0 != 0) {
+		g->PIN0 |= g->SET0 & g->DIR0;
+		g->SET0 = 0;
+	}
+	if (g->CLR0 != 0) {
+		g->PIN0 &= ~(g->CLR0 & g->DIR0);
+		g->CLR0 = 0;
+	}
+	if (g->NOT0 != 0) {
+		g->PIN0 ^= g->NOT0 & g->DIR0;
+		g->NOT0 = 0;
+	}
+	for (pin = 0; pin < GPIO_PIN_NUM; pin++) {
+		bit = 0x1UL << pin;
+		if (g->B0[pin] != Sim.gpioB[pin]) {
+			out = ((g->B0[pin] & 0x1) != 0)? bit: 0;		/* b0だけ有効 */
+		}
+		else if (g->W0[pin] != Sim.gpioW[pin]) {
+			out = (g->W0[pin] != 0)? bit: 0;				/* 0以外でH */
+		}
+		else {
+			continue;
+		}
+		g->PIN0 = (g->PIN0 & ~(bit & g->DIR0)) | (out & g->DIR0);
+	}
+	if (g->MPIN0 != Sim.gpioMpin) {
+		out = ~g->MASK0 & g->DIR0;		/* 書き込み対象のピン */
+		g->PIN0 = (g->PIN0 & ~out) | (g->MPIN0 & out);
+	}
+}
+
+/***************************************************************************
+	Sim_updSwm
+	スイッチマトリクスのピンの重複の確認(変化した時だけ)
+***************************************************************************/
+static void Sim_updSwm(void)
+{
+	const uint32_t	*assign = (const uint32_t *)&Sim_reg.swm.PINASSIGN0;
+	uint32_t		en = Sim_reg.swm.PINENABLE0;
+	uint32_t		used = 0;
+	uint32_t		pin[SWM_PINASSIGN_NUM * SWM_ASSIGN_PER_REG + SWM_FIXED_NUM];
+	uint32_t		num = 0;
+	uint32_t		i, n;
+
+	if (memcmp(assign, Sim.swm, sizeof(uint32_t) * SWM_PINASSIGN_NUM) == 0
+	 && en == Sim.swm[SWM_PINASSIGN_NUM]) {
+		return;
+	}
+	memcpy(Sim.swm, assign, sizeof(uint32_t) * SWM_PINASSIGN_NUM);
+	Sim.swm[SWM_PINASSIGN_NUM] = en;
+
+	for (i = 0; i < SWM_PINASSIGN_NUM; i++) {
+		for (n = 0; n < SWM_ASSIGN_PER_REG; n++) {
+			pin[num] = (assign[i] >> (n * SWM_ASSIGN_BITS)) & SWM_ASSIGN_NONE;
+			num += (pin[num] != SWM_ASSIGN_NONE)? 1: 0;
+		}
+	}
+	for (i = 0; i < SWM_FIXED_NUM; i++) {
+		if ((en & (0x1UL << i)) == 0) {
+			pin[num++] = Sim_swmFixedPin[i];
+		}
+	}
+	for (i = 0; i < num; i++) {
+		if (pin[i] >= GPIO_PIN_NUM) {
+			Sim_setFault("SWM function assigned to nonexistent pin");
+			continue;
+		}
+		if ((used & (0x1UL << pin[i])) != 0) {
+			Sim_setFault("SWM pin assigned to two functions");
+		}
+		used |= 0x1UL << pin[i];
+	}
+}
+
+/***************************************************************************
+	Sim_updSct
+	SCTのカウンタの開始・中断・クリアとCOUNT_U, OUTPUTへの書き込み
+***************************************************************************/
+static void Sim_updSct(void)
+{
+	LPC_SCT_TypeDef	*sc = &Sim_reg.sct;
+	uint32_t		cfg = sc->CONFIG;
+	_Bool			run;
+
+	if ((Sim_reg.syscon.PRESETCTRL & SYS_SCT_RST_N) == 0) {
+		memset(sc, 0, sizeof(*sc));
+		sc->CTRL_U = SIM_SCT_CTRL_RST;
+		Sim.sctCtrl = SIM_SCT_CTRL_RST;
+		Sim.sctCount = 0;
+		Sim.sctOut = 0;
+		Sim.sctRun = false;
+		return;
+	}
+	if (sc->EVEN != 0) {
+		Sim_setFault("SCT interrupt not modeled");
+	}
+	if (sc->OUTPUT != Sim.sctOut) {
+		if (Sim.sctRun) {
+			Sim_setFault("SCT OUTPUT written while counter running");
+		}
+		Sim.sctOut = sc->OUTPUT;
+	}
+	if (sc->COUNT_U != Sim.sctCount) {
+		Sim.sctCount = sc->COUNT_U;
+		Sim.sctCnt0 = sc->COUNT_U;
+		Sim.sctStart = Sim.sctCyc;
+		Sim.sctOut0 = Sim.sctOut;
+	}
+	if (sc->CTRL_U == Sim.sctCtrl) {
+		return;
+	}
+	if ((sc->CTRL_U & SCT_CLRCTR_L) != 0) {
+		sc->CTRL_U &= ~SCT_CLRCTR_L;		/* 読むと0 */
+		sc->COUNT_U = 0;
+		Sim.sctCount = 0;
+	}
+	run = ((sc->CTRL_U & (SCT_HALT_L | SCT_STOP_L)) == 0)? true: false;
+	if (run && ((cfg & SCT_UNIFY) == 0 || (cfg & SCT_CLKMODE) != SCT_CLKMODE_BUS
+	 || (cfg & SCT_AUTOLIMIT_L) == 0 || (sc->CTRL_U & (SCT_BIDIR_L | SCT_DOWN_L)) != 0)) {
+		Sim_setFault("SCT mode not modeled");
+		run = false;
+	}
+	if (run && (!Sim.sctRun || (sc->CTRL_U & SCT_PRE_L) != (Sim.sctCtrl & SCT_PRE_L))) {
+		Sim.sctCnt0 = sc->COUNT_U;
+		Sim.sctStart = Sim.sctCyc;
+		Sim.sctOut0 = Sim.sctOut;
+	}
+	Sim.sctRun = run;
+	Sim.sctCtrl = sc->CTRL_U;
+}
+
+/***************************************************************************
+	Sim_pubSct
+	SCTのCOUNT_U, OUTPUTの更新とCTOUT_0～3のピンへの反映
+
+	出力毎に、現在のカウンタ値から遡って最も近くで発生した(開始後の)イベ
+	ントのセット/クリアを出力とする。該当するイベントが無ければ開始時の
+	OUTPUTのままとする。
+***************************************************************************/
+static void Sim_pubSct(void)
+{
+	LPC_SCT_TypeDef	*sc = &Sim_reg.sct;
+	const uint32_t	*assign = (const uint32_t *)&Sim_reg.swm.PINASSIGN0;
+	uint64_t		elapsed, period, cnt, d, best;
+	uint32_t		ch, ev, bit, func, pin, m, ctl;
+	_Bool			set, clr;
+
+	if (Sim.sctRun) {
+		elapsed = (Sim.sctCyc - Sim.sctStart) / (((sc->CTRL_U & SCT_PRE_L) >> 5) + 1);
+		period = (uint64_t)(sc->MATCHREL[0].U) + 1;
+		cnt = (Sim.sctCnt0 + elapsed) % period;
+		sc->COUNT_U = (uint32_t)cnt;
+		Sim.sctCount = sc->COUNT_U;
+		for (ch = 0; ch < SCT_OUT_NUM; ch++) {
+			bit = 0x1UL << ch;
+			best = UINT64_MAX;
+			set = false;
+			clr = false;
+			for (ev = 0; ev < SCT_EV_NUM; ev++) {
+				ctl = sc->EVENT[ev].CTRL;
+				if ((sc->EVENT[ev].STATE & SCT_EV_STATE0) == 0
+				 || ((sc->OUT[ch].SET | sc->OUT[ch].CLR) & (0x1UL << ev)) == 0) {
+					continue;
+				}
+				if ((ctl & SCT_EV_COMBMODE) != SCT_EV_COMB_MATCH || (ctl & SCT_EV_MATCHSEL) >= SCT_MATCH_NUM) {
+					Sim_setFault("SCT event mode not modeled");
+					continue;
+				}
+				m = sc->MATCHREL[ctl & SCT_EV_MATCHSEL].U;
+				if (m >= period) {
+					continue;		/* 一致しない */
+				}
+				d = (cnt + period - m) % period;	/* 何クロック前に発生したか */
+				if (d > elapsed || d > best) {
+					continue;
+				}
+				if (d < best) {
+					best = d;
+					set = false;
+					clr = false;
+				}
+				set = set || (sc->OUT[ch].SET & (0x1UL << ev)) != 0;
+				clr = clr || (sc->OUT[ch].CLR & (0x1UL << ev)) != 0;
+			}
+			if (set && clr) {
+				Sim_setFault("SCT output set and cleared by simultaneous events");
+			}
+			if (best == UINT64_MAX) {
+				sc->OUTPUT = (sc->OUTPUT & ~bit) | (Sim.sctOut0 & bit);
+			}
+			else {
+				sc->OUTPUT = set? (sc->OUTPUT | bit): (sc->OUTPUT & ~bit);
+			}
+		}
+		Sim.sctOut = sc->OUTPUT;
+	}
+
+	/* CTOUT_0～3を割り当てたピン */
+	for (ch = 0; ch < SCT_OUT_NUM; ch++) {
+		func = SIM_SCT_CTOUT0 + ch;
+		pin = (assign[func / SWM_ASSIGN_PER_REG] >> ((func % SWM_ASSIGN_PER_REG) * SWM_ASSIGN_BITS)) & SWM_ASSIGN_NONE;
+		if (pin < GPIO_PIN_NUM) {
+			Sim_reg.gpio.PIN0 = (Sim_reg.gpio.PIN0 & ~(0x1UL << pin)) | (((sc->OUTPUT >> ch) & 0x1) << pin);
+		}
+	}
+}
+
+/***************************************************************************
+	Sim_pubGpio
+	GPIOのB0, W0, MPIN0の更新(PIN0の値にする)
+***************************************************************************/
+static void Sim_pubGpio(void)
+{
+	LPC_GPIO_PORT_TypeDef	*g = &Sim_reg.gpio;
+	uint32_t				pin;
+
+	for (pin = 0; pin < GPIO_PIN_NUM; pin++) {
+		g->B0[pin] = (uint8_t)((g->PIN0 >> pin) & 0x1);
+		g->W0[pin] = (g->B0[pin] != 0)? 0xFFFFFFFF: 0;
+		Sim.gpioB[pin] = g->B0[pin];
+		Sim.gpioW[pin] = g->W0[pin];
+	}
+	g->MPIN0 = g->PIN0 & ~g->MASK0;
+	Sim.gpioMpin = g->MPIN0;
+}
+
+/***************************************************************************
+	Sim_filterPs
+	入力フィルタで除かれるパルスの長さ(ps)
+
+	[引数]	pin	ピン番号
+	[戻値]	この長さ未満のパルスを除く(0:フィルタなし、UINT64_MAX:フィル
+			タのクロックが停止)
+***************************************************************************/
+static uint64_t Sim_filterPs(uint32_t pin)
+{
+	uint32_t	cfg = (&Sim_reg.iocon.PIO0_17)[Sim_ioconIdx[pin]];
+	uint32_t	clks = (cfg & IOCON_S_MODE) >> IOCON_S_MODE_SFT;	/* 1～3クロック */
+	uint32_t	div;
+	uint32_t	hz = Sim_getMainHz();
+
+	if (clks == 0) {
+		return 0;
+	}
+	div = Sim_reg.syscon.IOCONCLKDIV[IOCON_CLKDIV_NUM - 1 - ((cfg & IOCON_CLK_DIV) >> IOCON_CLK_DIV_SFT)] & IOCON_CLKDIV_MAX;
+	if (div == 0 || hz == 0) {
+		return UINT64_MAX;
+	}
+	return (uint64_t)clks * div * SIM_PS_PER_SEC / hz;
+}
+
+/***************************************************************************
+	Sim_publish
+	読み出されるレジスタを現在時刻の値にする
+***************************************************************************/
+static void Sim_publish(void)
+{
+	uint32_t	tv;
+	uint64_t	elapsed;
+	uint32_t	hz;
+
+	/* WDT */
+	if (Sim.wdtRun) {
+		tv = Sim_wdtNowTv();
+		Sim_reg.wwdt.TV = tv;
+		if (!Sim.wdtWarned && tv <= Sim_reg.wwdt.WARNINT) {
+			Sim.wdtWarned = true;
+			Sim.wdtWarn++;
+			Sim_reg.wwdt.MOD |= WWDT_WDINT;
+			Sim.irqPend |= 0x1UL << WDT_IRQn;
+		}
+		if (tv == 0) {
+			Sim_reg.wwdt.MOD |= WWDT_WDTOF;
+			if ((Sim_reg.wwdt.MOD & WWDT_WDRESET) != 0) {
+				Sim.wdtReset = true;
+			}
+			Sim.wdtRun = false;
+		}
+	}
+
+	/* WKT */
+	if (Sim.wktRun) {
+		hz = ((Sim_reg.wkt.CTRL & WKT_CLKSEL) != 0)? SIM_LPOSC_HZ: IRC_HZ / SIM_WKT_IRC_DIV;
+		elapsed = (Sim.ps - Sim.wktPs) * hz / SIM_PS_PER_SEC;
+		if (elapsed >= Sim.wktCnt) {
+			Sim.wktRun = false;
+			Sim.wktAlarm = true;
+			Sim.irqPend |= 0x1UL << WKT_IRQn;
+			Sim_reg.wkt.COUNT = 0;
+		}
+		else {
+			Sim_reg.wkt.COUNT = Sim.wktCnt - (uint32_t)elapsed;
+		}
+	}
+	Sim.wktPub = Sim_reg.wkt.COUNT;
+	Sim_reg.wkt.CTRL = (Sim_reg.wkt.CTRL & WKT_CLKSEL) | (Sim.wktAlarm? WKT_ALARMFLAG: 0);
+	Sim.wktCtrl = Sim_reg.wkt.CTRL;
+
+	/* SysTick */
+	Sim_reg.systick.VAL = Sim.stVal;
+
+	/* USART0 */
+	Sim_pubUart();
+
+	/* MRT */
+	Sim_pubMrt();
+
+	/* SCT(出力はGPIOのPIN0に反映) */
+	Sim_pubSct();
+
+	/* GPIO */
+	Sim_pubGpio();
+}
+
+/***************************************************************************
+	Sim_run
+	時間を進める
+
+	[引数]	ps	進める時間(ps)
+	[戻値]	なし
+
+	経過時間から現在のシステムクロック数を求め、SysTickを進める。
+***************************************************************************/
+static void Sim_run(uint64_t ps)
+{
+	unsigned __int128	acc;
+	uint64_t			cyc;
+	uint64_t			period;
+	uint32_t			hz = Sim_getCoreHz();
+
+	Sim.ps += ps;
+	Sim.cnt.ps += ps;
+	if (hz == 0) {
+		return;
+	}
+	acc = (unsigned __int128)ps * hz + Sim.cycRem;
+	cyc = (uint64_t)(acc / SIM_PS_PER_SEC);
+	Sim.cycRem = (uint64_t)(acc % SIM_PS_PER_SEC);
+	Sim.cycles += cyc;
+	Sim.cnt.cycles += cyc;
+	if (!Sim.deep && (Sim_reg.syscon.SYSAHBCLKCTRL & SYS_AHB_CLK_MRT) != 0) {
+		Sim.mrtCyc += cyc;
+	}
+	if (!Sim.deep && (Sim_reg.syscon.SYSAHBCLKCTRL & SYS_AHB_CLK_SCT) != 0) {
+		Sim.sctCyc += cyc;
+	}
+
+	if ((Sim_reg.systick.CTRL & SysTick_CTRL_ENABLE_Msk) != 0 && cyc != 0) {
+		period = (uint64_t)(Sim_reg.systick.LOAD & SysTick_LOAD_RELOAD_Msk) + 1;
+		if (cyc <= Sim.stVal) {
+			Sim.stVal -= (uint32_t)cyc;
+		}
+		else {
+			/* 0を通過してLOADから再開 */
+			cyc -= (uint64_t)Sim.stVal + 1;
+			Sim.stVal = (uint32_t)(period - 1 - (cyc % period));
+			Sim_reg.systick.CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+			if ((Sim_reg.systick.CTRL & SysTick_CTRL_TICKINT_Msk) != 0) {
+				Sim.tickPend = true;
+			}
+		}
+	}
+}
+
+/***************************************************************************
+	Sim_runCyc
+	システムクロック数で時間を進める
+***************************************************************************/
+static void Sim_runCyc(uint32_t cyc)
+{
+	uint32_t	hz = Sim_getCoreHz();
+
+	Sim_run((uint64_t)cyc * SIM_PS_PER_SEC / ((hz != 0)? hz: IRC_HZ));
+}
+
+/***************************************************************************
+	Sim_dispatch
+	保留中の割り込みの配送
+***************************************************************************/
+static void Sim_dispatch(void)
+{
+	uint32_t	frame[8];
+	uint32_t	ch, bit;
+
+	if (Sim.inIrq) {
+		return;
+	}
+	Sim.inIrq = true;
+	for (;;) {
+		if (Sim.tickPend) {
+			Sim.tickPend = false;
+			if (SysTick_Handler != NULL) {
+				SysTick_Handler();
+			}
+		}
+		else if ((Sim.irqPend & Sim.irqEn & (0x1UL << WDT_IRQn)) != 0) {
+			Sim.irqPend &= ~(0x1UL << WDT_IRQn);
+			memset(frame, 0, sizeof(frame));
+			frame[5] = 0xFFFFFFF9;	/* LR(模擬) */
+			frame[6] = 0x00000100;	/* PC(模擬) */
+			frame[7] = 0x01000000;	/* xPSR(Thumbビット) */
+			if (Wdt_procIrq != NULL) {
+				Wdt_procIrq(frame);
+			}
+		}
+		else if ((Sim.irqPend & Sim.irqEn & (0xFFUL << PININT0_IRQn)) != 0) {
+			ch = (uint32_t)__builtin_ctz(Sim.irqPend & Sim.irqEn & (0xFFUL << PININT0_IRQn)) - PININT0_IRQn;
+			bit = 0x1UL << ch;
+			Sim.irqPend &= ~(bit << PININT0_IRQn);
+			if (Sim_pintHandler[ch] != NULL) {
+				Sim_pintHandler[ch]();
+			}
+			if ((Sim_reg.pint.ISEL & bit) == 0) {
+				/* エッジ検出: ハンドラでクリアされたものとする */
+				Sim_reg.pint.RISE &= ~bit;
+				Sim_reg.pint.FALL &= ~bit;
+				Sim_reg.pint.IST &= ~bit;
+			}
+			else {
+				/* レベル検出: ハンドラ終了時点のレベルで判定し直す */
+				Sim.irqPend &= ~(bit << PININT0_IRQn);
+				Sim_update();
+			}
+		}
+		else if ((Sim.irqPend & Sim.irqEn & (0x1UL << UART0_IRQn)) != 0) {
+			Sim.irqPend &= ~(0x1UL << UART0_IRQn);
+			if (UART0_IRQHandler != NULL) {
+				UART0_IRQHandler();
+			}
+			/* RXDATAの読み出しとエラーフラグの1書きがされたものとする */
+			Sim.uStat &= ~SIM_UART_RX_CLR;
+			Sim.irqPend &= ~(0x1UL << UART0_IRQn);
+			Sim_update();
+			Sim_publish();		/* 要因が残っていれば再度保留 */
+		}
+		else if ((Sim.irqPend & Sim.irqEn & (0x1UL << WKT_IRQn)) != 0) {
+			Sim.irqPend &= ~(0x1UL << WKT_IRQn);
+			if (WKT_IRQHandler != NULL) {
+				WKT_IRQHandler();
+			}
+		}
+		else {
+			break;
+		}
+	}
+	Sim.inIrq = false;
+}
+
+/***************************************************************************
+	Sim_setFault
+	誤操作の記録(最初のものだけ残す)
+***************************************************************************/
+static void Sim_setFault(const char *msg)
+{
+	if (Sim.fault == NULL) {
+		Sim.fault = msg;
+	}
+}
+
+/***************************************************************************
+	クロックの計算
+***************************************************************************/
+
+/* WDT用オシレータの出力(WDTOSCCTRLと誤差(wdtOscPpm)より、電源断なら0) */
+static uint32_t Sim_wdtOscHz(void)
+{
+	uint32_t	ctrl = Sim_reg.syscon.WDTOSCCTRL;
+	uint64_t	hz;
+
+	if ((Sim.pdrun & SYS_WDTOSC_PD) != 0) {
+		return 0;
+	}
+	hz = (uint64_t)Sim_wdtFreq[(ctrl >> 5) & 0xF] * (1000000 + Sim.wdtOscPpm) / 1000000;
+	return (uint32_t)(hz / (2 * ((ctrl & 0x1F) + 1)));
+}
+
+/* WDTカウンタのクロック */
+static uint32_t Sim_wdtCntHz(void)
+{
+	return Sim_wdtOscHz() / SIM_WDT_PRE_DIV;
+}
+
+/* PLL入力クロック */
+static uint32_t Sim_pllInHz(void)
+{
+	switch (Sim.pllSel) {
+	case SYS_PLL_CLK_IRC:
+		return ((Sim.pdrun & (SYS_IRCOUT_PD | SYS_IRC_PD)) == 0)? IRC_HZ: 0;
+	case SYS_PLL_CLK_CLKIN:
+		return ((Sim_reg.swm.PINENABLE0 & SWM_CLKIN_DIS) == 0)? CLKIN_HZ: 0;
+	default:
+		return 0;
+	}
+}
+
+/* 指定のメインクロック選択での周波数 */
+static uint32_t Sim_calcMainHz(uint32_t sel)
+{
+	switch (sel) {
+	case SYS_MAIN_CLK_IRC:
+		return ((Sim.pdrun & (SYS_IRCOUT_PD | SYS_IRC_PD)) == 0)? IRC_HZ: 0;
+	case SYS_MAIN_CLK_PLLIN:
+		return Sim_pllInHz();
+	case SYS_MAIN_CLK_WDTOSC:
+		return Sim_wdtOscHz();
+	case SYS_MAIN_CLK_PLLOUT:
+		if ((Sim.pdrun & SYS_SYSPLL_PD) != 0 || Sim_reg.syscon.SYSPLLSTAT != SYS_PLL_LOCKED) {
+			return 0;
+		}
+		return Sim_pllInHz() * ((Sim_reg.syscon.SYSPLLCTRL & 0x1F) + 1);
+	default:
+		return 0;
+	}
+}
+
+/* 現在時刻のWDTカウンタ値 */
+static uint32_t Sim_wdtNowTv(void)
+{
+	uint64_t	elapsed;
+	uint32_t	hz = Sim_wdtCntHz();
+
+	if (!Sim.wdtRun || hz == 0) {
+		return Sim_reg.wwdt.TV;
+	}
+	elapsed = (Sim.ps - Sim.wdtPs) * hz / SIM_PS_PER_SEC;
+	return (elapsed >= Sim.wdtTv)? 0: Sim.wdtTv - (uint32_t)elapsed;
+}
@@ -0,0 +1,80 @@
+/***************************************************************************
+	sim.h
+	ホスト用レジスタモデルの操作
+
+	マイコン: LPC810(NXP Semiconductors)をホスト上で模擬する
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: ピン割り込み(Sim_setPin)追加
+	2026.10.16: mits: USART0(Sim_uartRx, Sim_uartTx, Sim_getUartBaud)追加
+	2026.10.16: mits: MRT追加
+	2026.10.16: mits: WDT用オシレータの誤差(Sim_setWdtOscPpm)追加
+	2026.10.16: mits: ディープパワーダウン(Sim_isDpd)追加
+	2026.10.16: mits: フラッシュコントローラ追加
+	2026.10.16: mits: 入力フィルタ(Sim_pulsePin)追加
+	2026.10.16: mits: SCT追加
+	2026.10.16: mits: ディープスリープしていた時間(Sim_getDeepUs)追加
+	2026.10.16: mits: アプリケーションの実行(Sim_runApp)追加
+***************************************************************************/
+#ifndef	SIM_H
+#define	SIM_H
+
+#include	<stdint.h>
+
+/***************************************************************************
+	定義
+***************************************************************************/
+
+/*** ペリフェラル毎のアクセス回数 ***/
+typedef enum Sim_peri {
+	SIM_SYSCON	= 0,
+	SIM_WWDT,
+	SIM_GPIO,
+	SIM_SWM,
+	SIM_IOCON,
+	SIM_PMU,
+	SIM_WKT,
+	SIM_SYSTICK,
+	SIM_SCB,
+	SIM_PINT,
+	SIM_USART0,
+	SIM_MRT,
+	SIM_FLASHCTRL,
+	SIM_SCT,
+	SIM_PERI_NUM
+} Sim_peri;
+
+typedef struct Sim_cnt {
+	uint32_t	acc[SIM_PERI_NUM];	/* アクセス回数 */
+	uint32_t	total;				/* 合計 */
+	uint64_t	cycles;				/* 経過したシステムクロック数 */
+	uint64_t	ps;					/* 経過時間(ps) */
+} Sim_cnt;
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+void		Sim_reset(uint32_t rststat);	/* リセット(SYSRSTSTATの値を指定) */
+void		Sim_clrCnt(void);				/* アクセス回数・経過時間のクリア */
+void		Sim_getCnt(Sim_cnt *cnt);		/* アクセス回数・経過時間の取得 */
+void		Sim_advanceUs(uint32_t us);		/* 時間を進める(コアは止まっている扱い) */
+uint64_t	Sim_getTimeUs(void);			/* リセットからの経過時間(us) */
+uint32_t	Sim_getMainHz(void);			/* モデル上のメインクロック */
+uint32_t	Sim_getCoreHz(void);			/* モデル上のシステムクロック */
+void		Sim_setPllFail(_Bool fail);		/* PLLをロックさせない */
+void		Sim_setPllLockUs(uint32_t us);	/* PLLのロック時間 */
+void		Sim_setWdtOscPpm(int32_t ppm);	/* WDT用オシレータの公称値からの誤差(ppm) */
+_Bool		Sim_isWdtReset(void);			/* WDTによるリセットが発生したか */
+_Bool		Sim_isDpd(void);				/* ディープパワーダウンに入ったか */
+uint64_t	Sim_getDeepUs(void);			/* ディープスリープ・パワーダウンしていた時間の合計(us) */
+uint32_t	Sim_getWdtWarn(void);			/* WDT警告割り込みの発生回数 */
+const char	*Sim_getFault(void);			/* モデルが検出した誤操作(無ければNULL) */
+void		Sim_setPin(uint32_t pin, _Bool high);	/* 入力ピンのレベル設定(ピン割り込みも発生) */
+_Bool		Sim_pulsePin(uint32_t pin, _Bool high, uint32_t us);	/* 入力ピンへのパルス(入力フィルタを通過したか) */
+void		Sim_uartRx(uint8_t data);		/* USART0で1バイト受信する */
+uint32_t	Sim_uartTx(uint8_t *buf, uint32_t max);	/* USART0で送信し終えたバイトの取り出し */
+uint32_t	Sim_getUartBaud(void);			/* モデル上のUSART0の伝送速度(停止中は0) */
+void		Sim_runApp(int (*app)(void), uint32_t ms);	/* 戻らない定常ループを指定時間だけ実行 */
+
+#endif	/* SIM_H */
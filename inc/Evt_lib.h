@@ -0,0 +1,44 @@
+/***************************************************************************
+	Evt_lib.h
+	私家版イベントキューライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	EVT_LIB_H
+#define	EVT_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+enum {
+	EVT_QUE_SIZE	= 8,	/* キュー1本当たりのイベント数(2のべき乗) */
+	EVT_QUE_MAX		= 4,	/* 登録可能なキューの数 */
+	EVT_ID_MAX		= 16,	/* イベント番号の数(0～EVT_ID_MAX-1) */
+	EVT_ARG_MAX		= 0xFF	/* イベント引数の最大値 */
+};
+
+/*** イベントキュー(書き込む割り込み処理1つにつき1本) ***/
+/* headは書き込み側(割り込み)だけが、tailは読み出し側(main)だけが更新する */
+typedef struct Evt_que {
+	volatile uint8_t	head;				/* 次に書き込む位置(フリーラン) */
+	volatile uint8_t	tail;				/* 次に読み出す位置(フリーラン) */
+	volatile uint8_t	lost;				/* 満杯で捨てたイベント数(最大255) */
+	volatile uint16_t	buf[EVT_QUE_SIZE];	/* b0-7:イベント番号、b8-15:引数 */
+} Evt_que;
+
+/*** イベント処理関数(main側から呼ばれる) ***/
+typedef void (*Evt_func)(uint32_t arg);
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+_Bool		Evt_addQue(Evt_que *que);					/* キューの登録 */
+_Bool		Evt_setFunc(uint32_t id, Evt_func func);	/* イベント処理関数の登録 */
+_Bool		Evt_post(Evt_que *que, uint32_t id, uint32_t arg);	/* イベントの送信(割り込み内で使用) */
+uint32_t	Evt_run(void);								/* 溜まったイベントの処理(main側で使用) */
+_Bool		Evt_isEmpty(void);							/* 未処理のイベントが無いか否か */
+
+#endif	/* EVT_LIB_H */
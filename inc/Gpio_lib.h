@@ -0,0 +1,106 @@
+/***************************************************************************
+	Gpio_lib.h
+	私家版GPIOライブラリ(ヘッダのみ)
+
+	使用方法: #include "Gpio_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	GPIOポート0の入出力を、1回のロードまたはストアで済ませるためのインラ
+	イン関数群。引数が定数ならレジスタへのストア1命令(とアドレス・値の
+	ロード)に展開されるので、割り込み処理の中でも時間をほとんど使わない。
+	関数呼び出しも出力の種類での分岐も残らない。
+
+	・Gpio_set, Gpio_clr, Gpio_tgl
+		ビットパターンで指定したピンをH出力、L出力、反転出力する
+		(SET0, CLR0, NOT0)。
+	・Gpio_wrPin, Gpio_rdPin
+		ピン番号で指定した1ピンを出力、入力する(バイトレジスタB0)。
+		ポート全体を読んでマスクする必要がない。
+	・Gpio_rdPinW
+		1ピンを0/0xFFFFFFFFで入力する(ワードレジスタW0)。
+		分岐せずにマスクとして使える。
+	・Gpio_setMask, Gpio_wrMasked, Gpio_rdMasked
+		Gpio_setMaskで指定したピンだけを、まとめて出力、入力する(MASK0,
+		MPIN0)。他のピンは変化しない。
+	・GPIO_BIT
+		ピン番号をビットパターンにする。
+
+	注意点:
+	・あらかじめGPIOへのクロック供給(Sys_acqClk)とDIR0の設定をしておくこと。
+	・MASK0はポートで1つなので、Gpio_setMaskで決めたマスクはmain側と割り込
+	　み処理で共有される。Gpio_wrMasked, Gpio_rdMaskedは、1つの処理(main側
+	　か1つの割り込み処理)だけで使うこと。それ以外の関数はリエントラントで
+	　ある。
+	・ピン番号は0～GPIO_PIN_NUM-1であること(範囲は調べない)。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	GPIO_LIB_H
+#define	GPIO_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+#define	GPIO_BIT(pin)	(0x1UL << (pin))	/* ピン番号→ビットパターン */
+
+/***************************************************************************
+	インライン関数
+***************************************************************************/
+
+/* 1のビットのピンをH出力 */
+static inline void Gpio_set(uint32_t pat)
+{
+	LPC_GPIO_PORT->SET0 = pat;
+}
+
+/* 1のビットのピンをL出力 */
+static inline void Gpio_clr(uint32_t pat)
+{
+	LPC_GPIO_PORT->CLR0 = pat;
+}
+
+/* 1のビットのピンを反転出力 */
+static inline void Gpio_tgl(uint32_t pat)
+{
+	LPC_GPIO_PORT->NOT0 = pat;
+}
+
+/* 1ピンの出力(false:L, true:H) */
+static inline void Gpio_wrPin(uint32_t pin, _Bool high)
+{
+	LPC_GPIO_PORT->B0[pin] = high;
+}
+
+/* 1ピンの入力(false:L, true:H) */
+static inline _Bool Gpio_rdPin(uint32_t pin)
+{
+	return LPC_GPIO_PORT->B0[pin];
+}
+
+/* 1ピンの入力(0:L, 0xFFFFFFFF:H) */
+static inline uint32_t Gpio_rdPinW(uint32_t pin)
+{
+	return LPC_GPIO_PORT->W0[pin];
+}
+
+/* Gpio_wrMasked, Gpio_rdMaskedの対象にするピン(1のビット)の設定 */
+static inline void Gpio_setMask(uint32_t pat)
+{
+	LPC_GPIO_PORT->MASK0 = ~pat;
+}
+
+/* 対象のピンだけをまとめて出力(対象外のビットの値は無視される) */
+static inline void Gpio_wrMasked(uint32_t val)
+{
+	LPC_GPIO_PORT->MPIN0 = val;
+}
+
+/* 対象のピンだけをまとめて入力(対象外のビットは0) */
+static inline uint32_t Gpio_rdMasked(void)
+{
+	return LPC_GPIO_PORT->MPIN0;
+}
+
+#endif	/* GPIO_LIB_H */
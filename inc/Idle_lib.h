@@ -0,0 +1,25 @@
+/***************************************************************************
+	Idle_lib.h
+	私家版アイドル(低消費電力待機)ライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	IDLE_LIB_H
+#define	IDLE_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+/* Idle_runの待機時間指定なし(割り込み・WDTクリア期限まで待つ) */
+#define	IDLE_FOREVER	UINT32_MAX
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+void	Idle_ini(void);				/* アイドル処理の初期化(※Sys_iniLpc810後に使用可能) */
+void	Idle_run(uint32_t ms);		/* 次の起床要因まで低消費電力で待機 */
+
+#endif	/* IDLE_LIB_H */
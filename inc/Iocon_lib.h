@@ -0,0 +1,21 @@
+/***************************************************************************
+	Iocon_lib.h
+	私家版IOCON(ピン設定)ライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	IOCON_LIB_H
+#define	IOCON_LIB_H
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+void		Iocon_setPin(uint32_t pin, uint32_t cfg);	/* ピンの設定(IOCON_*の組み合わせ) */
+uint32_t	Iocon_getPin(uint32_t pin);					/* ピンの設定の取得 */
+void		Iocon_setClkDiv(uint32_t sel, uint32_t div);	/* フィルタのクロック分周値の設定 */
+_Bool		Iocon_setSampleUs(uint32_t sel, uint32_t us);	/* フィルタのクロック周期(us)の設定 */
+
+#endif	/* IOCON_LIB_H */
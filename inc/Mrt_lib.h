@@ -0,0 +1,30 @@
+/***************************************************************************
+	Mrt_lib.h
+	私家版マルチレートタイマ(MRT)ライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: Mrt_end追加
+***************************************************************************/
+#ifndef	MRT_LIB_H
+#define	MRT_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+enum {
+	MRT_CH_STAMP	= 0,				/* タイムスタンプに使うチャネル */
+	MRT_STAMP_MASK	= MRT_IVALUE_MAX	/* タイムスタンプのマスク(2^31で一周する) */
+};
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+void		Mrt_ini(void);						/* タイムスタンプの開始 */
+void		Mrt_end(void);						/* タイムスタンプの使用終了 */
+uint32_t	Mrt_getStamp(void);					/* タイムスタンプ(システムクロック数)の取得 */
+uint32_t	Mrt_getElapsed(uint32_t stamp);		/* タイムスタンプからの経過クロック数 */
+
+#endif	/* MRT_LIB_H */
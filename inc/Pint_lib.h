@@ -0,0 +1,40 @@
+/***************************************************************************
+	Pint_lib.h
+	私家版ピン割り込みライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	PINT_LIB_H
+#define	PINT_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+enum {
+	PINT_CH_NONE	= PINT_CH_NUM	/* Pint_addで登録できなかった */
+};
+
+/*** 検出条件 ***/
+typedef enum Pint_mode {
+	PINT_EDGE_RISE	= 0,	/* 立ち上がりエッジ */
+	PINT_EDGE_FALL,			/* 立ち下がりエッジ */
+	PINT_EDGE_BOTH,			/* 両エッジ */
+	PINT_LEVEL_HIGH,		/* Hレベル(1回検出すると停止、Pint_startで再開) */
+	PINT_LEVEL_LOW			/* Lレベル(同上) */
+} Pint_mode;
+
+/*** 検出時に呼び出す関数(割り込み内から呼ばれる) ***/
+/* ch: チャネル番号、rise: 立ち上がり(true)/立ち下がり(false)、レベル検出では検出レベル */
+typedef void (*Pint_func)(uint32_t ch, _Bool rise);
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+uint32_t	Pint_add(uint32_t pin, Pint_mode mode, Pint_func func);	/* ピン割り込みの登録 */
+void		Pint_start(uint32_t ch);	/* 検出の開始(再開) */
+void		Pint_stop(uint32_t ch);		/* 検出の停止 */
+
+#endif	/* PINT_LIB_H */
@@ -0,0 +1,54 @@
+/***************************************************************************
+	Prof_lib.h
+	私家版処理時間計測ライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	PROF_LIB_H
+#define	PROF_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+enum {
+	PROF_SEC_MAX	= 8		/* 登録可能な区間の数 */
+};
+
+/*** 計測区間(静的に確保してProf_addで登録する) ***/
+typedef struct Prof_sec {
+	const char	*name;		/* 区間名 */
+	uint32_t	start;		/* PROF_BEGINのタイムスタンプ */
+	uint32_t	cnt;		/* 計測回数 */
+	uint32_t	min;		/* 最小クロック数 */
+	uint32_t	max;		/* 最大クロック数 */
+	uint64_t	sum;		/* 合計クロック数(平均の計算用) */
+} Prof_sec;
+
+/*** 計測結果(Prof_getStat) ***/
+typedef struct Prof_stat {
+	const char	*name;		/* 区間名 */
+	uint32_t	cnt;		/* 計測回数 */
+	uint32_t	min;		/* 最小クロック数 */
+	uint32_t	max;		/* 最大クロック数 */
+	uint32_t	avg;		/* 平均クロック数 */
+} Prof_stat;
+
+/*** 区間の計測(PROF_ENABLEが0なら何もしない) ***/
+#define	PROF_BEGIN(sec)	do { if (PROF_ENABLE) { Prof_begin(&(sec)); } } while (0)
+#define	PROF_END(sec)	do { if (PROF_ENABLE) { Prof_end(&(sec)); } } while (0)
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+void		Prof_ini(void);								/* 計測の準備(MRTの開始) */
+_Bool		Prof_add(Prof_sec *sec, const char *name);	/* 区間の登録 */
+void		Prof_begin(Prof_sec *sec);					/* 区間の開始(PROF_BEGINから呼ぶ) */
+void		Prof_end(Prof_sec *sec);					/* 区間の終了(PROF_ENDから呼ぶ) */
+uint32_t	Prof_getNum(void);							/* 登録済みの区間数 */
+_Bool		Prof_getStat(uint32_t idx, Prof_stat *stat);	/* 計測結果の取得 */
+void		Prof_clr(void);								/* 計測結果のクリア */
+
+#endif	/* PROF_LIB_H */
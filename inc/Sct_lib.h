@@ -0,0 +1,29 @@
+/***************************************************************************
+	Sct_lib.h
+	私家版SCT(PWM・点滅出力)ライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	SCT_LIB_H
+#define	SCT_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+enum {
+	SCT_EDGE_MAX	= SCT_MATCH_NUM - 1	/* 全チャネル合計の変化点の数(MATCH0は周期に使う) */
+};
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+_Bool	Sct_ini(uint32_t periodUs);		/* SCTの開始(※Sys_iniLpc810後に使用可能) */
+_Bool	Sct_setPeriod(uint32_t periodUs);	/* 周期の変更(全チャネル共通) */
+_Bool	Sct_setPwm(uint32_t ch, uint32_t highUs);	/* PWM出力(周期の先頭からhighUsだけH) */
+_Bool	Sct_setBlink(uint32_t ch, const uint32_t *edgeUs, uint32_t num);	/* 点滅パターンの出力 */
+void	Sct_stop(void);					/* SCTの停止 */
+
+#endif	/* SCT_LIB_H */
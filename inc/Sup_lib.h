@@ -0,0 +1,33 @@
+/***************************************************************************
+	Sup_lib.h
+	私家版WDT監視(スーパーバイザ)ライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: Sup_getRestMs追加
+	2026.10.16: mits: Sup_setMs追加
+***************************************************************************/
+#ifndef	SUP_LIB_H
+#define	SUP_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+enum {
+	SUP_TASK_MAX	= 8,			/* 登録可能なタスク数(最大32) */
+	SUP_ID_NONE		= SUP_TASK_MAX	/* Sup_addで登録できなかった */
+};
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+uint32_t	Sup_add(uint32_t ms);		/* 監視タスクの登録(※Wdt_ini後に使用可能) */
+void		Sup_setMs(uint32_t id, uint32_t ms);	/* 監視タスクの期限の変更 */
+void		Sup_chk(uint32_t id);		/* タスクの生存報告(割り込み内でも使用可) */
+_Bool		Sup_feed(void);				/* 全タスクが報告済みならWDTクリア */
+uint32_t	Sup_getMissed(void);		/* 報告の無かったタスク(ビットパターン) */
+uint32_t	Sup_getRestMs(void);		/* 報告の無いタスクの期限までの残り時間(ms) */
+
+#endif	/* SUP_LIB_H */
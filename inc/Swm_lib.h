@@ -0,0 +1,97 @@
+/***************************************************************************
+	Swm_lib.h
+	私家版スイッチマトリクス(SWM)ライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	SWM_LIB_H
+#define	SWM_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+
+/*** 固定機能の番号(PINENABLE0のビット番号と、割り当てられるピン番号) ***/
+#define	SWM_FIX(bit, pin)	(SWM_FIXED | ((bit) << 5) | (pin))
+
+/*** 割り当てる機能 ***/
+/*--------------------------------------------------------------------------
+	移動可能な機能は機能番号(PINASSIGNの並び順)、固定機能はSWM_FIXEDと
+	PINENABLE0のビット番号、ピン番号を合わせた値とする。
+	※UM10601 - Chapter 9: LPC800 Switch Matrix
+--------------------------------------------------------------------------*/
+typedef enum Swm_func {
+	/* 移動可能な機能(PINASSIGN0～8) */
+	SWM_U0_TXD		= 0,	SWM_U0_RXD,		SWM_U0_RTS,		SWM_U0_CTS,
+	SWM_U0_SCLK,			SWM_U1_TXD,		SWM_U1_RXD,		SWM_U1_RTS,
+	SWM_U1_CTS,				SWM_U1_SCLK,	SWM_U2_TXD,		SWM_U2_RXD,
+	SWM_U2_RTS,				SWM_U2_CTS,		SWM_U2_SCLK,	SWM_SPI0_SCK,
+	SWM_SPI0_MOSI,			SWM_SPI0_MISO,	SWM_SPI0_SSEL,	SWM_SPI1_SCK,
+	SWM_SPI1_MOSI,			SWM_SPI1_MISO,	SWM_SPI1_SSEL,	SWM_CTIN_0,
+	SWM_CTIN_1,				SWM_CTIN_2,		SWM_CTIN_3,		SWM_CTOUT_0,
+	SWM_CTOUT_1,			SWM_CTOUT_2,	SWM_CTOUT_3,	SWM_I2C_SDA,
+	SWM_I2C_SCL,			SWM_ACMP_O,		SWM_CLKOUT,		SWM_GPIO_INT_BMAT,
+	SWM_MOVABLE_NUM,		/* 移動可能な機能の数 */
+
+	/* 固定機能(PINENABLE0) */
+	SWM_FIXED		= 0x200,
+	SWM_ACMP_I1		= SWM_FIX(0, 0),	/* PIO0_0 */
+	SWM_ACMP_I2		= SWM_FIX(1, 1),	/* PIO0_1 */
+	SWM_SWCLK		= SWM_FIX(2, 3),	/* PIO0_3 */
+	SWM_SWDIO		= SWM_FIX(3, 2),	/* PIO0_2 */
+	SWM_XTALIN		= SWM_FIX(4, 8),	/* PIO0_8(LPC810には無い) */
+	SWM_XTALOUT		= SWM_FIX(5, 9),	/* PIO0_9(LPC810には無い) */
+	SWM_RESET		= SWM_FIX(6, 5),	/* PIO0_5 */
+	SWM_CLKIN		= SWM_FIX(7, 1),	/* PIO0_1 */
+	SWM_VDDCMP		= SWM_FIX(8, 6),	/* PIO0_6(LPC810には無い) */
+
+	SWM_FUNC_NONE	= 0x3FF				/* 機能なし(Swm_getFunc) */
+} Swm_func;
+
+#define	SWM_IS_FIXED(f)		(((f) & SWM_FIXED) != 0)		/* 固定機能か */
+#define	SWM_FIXED_BIT(f)	(((f) >> 5) & 0xF)				/* 固定機能のPINENABLE0のビット番号 */
+#define	SWM_FIXED_PIN(f)	((f) & 0x1F)					/* 固定機能のピン番号 */
+#define	SWM_FUNC_BIT(f)		(0x1ULL << (SWM_IS_FIXED(f)? SWM_MOVABLE_NUM + SWM_FIXED_BIT(f): (f)))
+
+/*** ピン配置表の要素(SWM_PIN_MAPから作る) ***/
+typedef struct Swm_pin {
+	uint16_t	func;		/* 機能(Swm_func) */
+	uint8_t		pin;		/* ピン番号 */
+} Swm_pin;
+
+#define	SWM_X_ENTRY(f, pin)		{ (f), (pin) },
+
+/*** ピン配置表のビルド時チェック ***/
+/*--------------------------------------------------------------------------
+	X(機能, ピン番号)の並びの表(core.hのSWM_PIN_MAPなど)について、定数式
+	で以下を調べる。_Static_assertで使う。
+	・SWM_MAP_PIN_UNIQUE	同じピンが2回以上現れない
+	・SWM_MAP_FUNC_UNIQUE	同じ機能が2回以上現れない
+	・SWM_MAP_PIN_VALID		ピン番号がLPC810にあり、固定機能は決められた
+							ピンである
+	重複は、ビットの和と論理和が一致するかで調べる(重複があると和の方に
+	桁上がりが起きる)。
+--------------------------------------------------------------------------*/
+#define	SWM_X_PIN_SUM(f, pin)	+ (0x1ULL << (pin))
+#define	SWM_X_PIN_OR(f, pin)	| (0x1ULL << (pin))
+#define	SWM_X_FUNC_SUM(f, pin)	+ SWM_FUNC_BIT(f)
+#define	SWM_X_FUNC_OR(f, pin)	| SWM_FUNC_BIT(f)
+#define	SWM_X_PIN_OK(f, pin)	&& ((pin) < SWM_PIN_NUM) && (!SWM_IS_FIXED(f) || SWM_FIXED_PIN(f) == (pin))
+
+#define	SWM_MAP_PIN_UNIQUE(map)		((0 map(SWM_X_PIN_SUM)) == (0 map(SWM_X_PIN_OR)))
+#define	SWM_MAP_FUNC_UNIQUE(map)	((0 map(SWM_X_FUNC_SUM)) == (0 map(SWM_X_FUNC_OR)))
+#define	SWM_MAP_PIN_VALID(map)		(1 map(SWM_X_PIN_OK))
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+void		Swm_ini(void);							/* ピン配置表(SWM_PIN_MAP)の反映 */
+_Bool		Swm_assign(Swm_func func, uint32_t pin);	/* 機能のピンへの割り当て */
+void		Swm_release(Swm_func func);				/* 機能の割り当て解除 */
+uint32_t	Swm_getPin(Swm_func func);				/* 機能を割り当てたピン番号 */
+Swm_func	Swm_getFunc(uint32_t pin);				/* ピンに割り当てた機能 */
+
+#endif	/* SWM_LIB_H */
@@ -6,16 +6,86 @@
 
 	変更履歴
 	2014.06.07: mits: 新規作成
+	2026.10.16: mits: Sys_setClock, Sys_getClock, Sys_addClkNotify追加
+	2026.10.16: mits: Sys_msToTicks追加
+	2026.10.16: mits: Sys_usToTicks, Sys_delayUs, Sys_waitReg追加
+	2026.10.16: mits: Sys_getBootTim追加
+	2026.10.16: mits: Sys_getRstInfo追加
+	2026.10.16: mits: Sys_enterPowerMode, Sys_getWakeUs, Sys_selPowerMode追加
+	2026.10.16: mits: Sys_acqClk, Sys_relClk追加
+	2026.10.16: mits: Sys_bootTimの単位をusにした
 ***************************************************************************/
 #ifndef	SYS_LIB_H
 #define	SYS_LIB_H
 
+/***************************************************************************
+	型定義
+***************************************************************************/
+
+/*** クロック構成(各メンバの意味はcore.h内の同名シンボルを参照) ***/
+typedef struct Sys_clk {
+	uint32_t	mainSel;	/* メインクロックの選択(MAIN_CLK_SEL相当) */
+	uint32_t	pllSel;		/* PLL入力クロックの選択(SYS_PLL_CLK相当) */
+	uint32_t	pllRate;	/* PLL逓倍数(SYS_PLL_RATE相当) */
+	uint32_t	div;		/* システムクロックの分周値(SYS_CLK_DIV相当) */
+} Sys_clk;
+
+/*** 起動時間の記録(Sys_iniLpc810内の各段階の終了時刻) ***/
+/* 単位はSys_iniLpc810開始からのus */
+/* SysTickで数えたクロック数を、pllLockまではリセット直後のクロック(IRC_HZ)、 */
+/* mainSelの区間は切り替え後のメインクロック(mainHz)でusに換算して積み上げる */
+typedef struct Sys_bootTim {
+	uint32_t	wdtIni;		/* Wdt_ini完了 */
+	uint32_t	clkin;		/* CLKIN安定待ち完了(CLKIN未使用時はwdtIniと同じ) */
+	uint32_t	pllSel;		/* PLL入力クロック切り替え(SYSPLLCLKUEN)完了 */
+	uint32_t	pllLock;	/* PLLロック(SYSPLLSTAT)完了(PLL未使用時はpllSelと同じ) */
+	uint32_t	mainSel;	/* メインクロック切り替え(MAINCLKUEN)完了(ロック失敗時は0) */
+	uint32_t	mainHz;		/* Hz; mainSelの区間を換算したクロック */
+	_Bool		pllOk;		/* PLLがロックした(PLL未使用時もtrue) */
+} Sys_bootTim;
+
+/*** リセット要因の記録 ***/
+enum {
+	SYS_RST_NUM	= 5		/* リセット要因の数(SYSRSTSTATのb0～b4) */
+};
+typedef struct Sys_rstInfo {
+	uint32_t	cause;				/* 今回のリセット要因(SYS_RST_*の組み合わせ) */
+	uint32_t	cnt[SYS_RST_NUM];	/* 要因毎のリセット回数(添字はSYS_RST_*のビット位置) */
+} Sys_rstInfo;
+
+/*** クロック変更通知関数 ***/
+typedef void (*Sys_clkNotify)(void);
+
+/*** 低消費電力モード(Sys_enterPowerMode) ***/
+/* ※浅い順に並べている(Sys_selPowerModeはこの順で探す) */
+typedef enum Sys_pmode {
+	SYS_PM_SLEEP	= 0,	/* スリープ(コアのクロックのみ停止) */
+	SYS_PM_DEEPSLEEP,		/* ディープスリープ(IRC, フラッシュ停止) */
+	SYS_PM_POWERDOWN,		/* パワーダウン(さらにフラッシュの電源断) */
+	SYS_PM_DPD,				/* ディープパワーダウン(起床はリセット) */
+	SYS_PM_NUM
+} Sys_pmode;
+
 /***************************************************************************
 	グローバル関数
 ***************************************************************************/
 void		Sys_iniLpc810(void);
 uint32_t	Sys_getMainClk(void);
 uint32_t	Sys_getSysClk(void);
+_Bool		Sys_setClock(const Sys_clk *clk);
+void		Sys_getClock(Sys_clk *clk);
+_Bool		Sys_addClkNotify(Sys_clkNotify func);
+uint32_t	Sys_msToTicks(uint32_t ms);
+uint32_t	Sys_usToTicks(uint32_t us);
+void		Sys_delayUs(uint32_t us);
+_Bool		Sys_waitReg(const volatile uint32_t *reg, uint32_t mask, uint32_t val, uint32_t us);
+const Sys_bootTim	*Sys_getBootTim(void);
+const Sys_rstInfo	*Sys_getRstInfo(void);
+_Bool		Sys_acqClk(uint32_t clk, uint32_t rst);
+void		Sys_relClk(uint32_t clk);
+_Bool		Sys_enterPowerMode(Sys_pmode mode);
+uint32_t	Sys_getWakeUs(Sys_pmode mode);
+Sys_pmode	Sys_selPowerMode(uint32_t us);
 
 /***************************************************************************
 	以下は、コアライブラリとの整合性をとるためのextern宣言
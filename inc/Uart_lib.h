@@ -0,0 +1,42 @@
+/***************************************************************************
+	Uart_lib.h
+	私家版USARTライブラリ
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#ifndef	UART_LIB_H
+#define	UART_LIB_H
+
+/***************************************************************************
+	定義
+***************************************************************************/
+enum {
+	UART_TX_SIZE	= 32,		/* 送信バッファのバイト数(2のべき乗) */
+	UART_RX_SIZE	= 16,		/* 受信バッファのバイト数(2のべき乗) */
+	UART_ERR_MAX_PPM	= 20000	/* ppm; 許容する伝送速度の誤差(2%) */
+};
+
+/*** 通信の統計(Uart_getStat) ***/
+typedef struct Uart_stat {
+	uint32_t	rxLost;		/* 受信バッファが満杯で捨てたバイト数 */
+	uint32_t	overrun;	/* オーバーラン(割り込みが間に合わなかった)回数 */
+	uint32_t	frameErr;	/* フレーミングエラー回数 */
+	uint32_t	parityErr;	/* パリティエラー回数 */
+	uint32_t	noise;		/* 受信ノイズ回数 */
+} Uart_stat;
+
+/***************************************************************************
+	グローバル関数
+***************************************************************************/
+_Bool		Uart_ini(uint32_t baud);	/* USART0の初期化(※Sys_iniLpc810後に使用可能) */
+uint32_t	Uart_getBaud(void);			/* 実際の伝送速度 */
+uint32_t	Uart_send(const void *data, uint32_t len);	/* 送信(バッファに積むだけ) */
+uint32_t	Uart_puts(const char *str);	/* 文字列の送信(同上) */
+uint32_t	Uart_recv(void *buf, uint32_t max);	/* 受信済みデータの取り出し */
+_Bool		Uart_isTxIdle(void);		/* 送信がすべて完了したか否か */
+void		Uart_getStat(Uart_stat *stat);	/* 通信の統計の取得 */
+
+#endif	/* UART_LIB_H */
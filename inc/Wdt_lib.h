@@ -6,15 +6,63 @@
 
 	変更履歴
 	2014.06.07: mits: 新規作成
+	2026.10.16: mits: Wdt_msToCnt追加
+	2026.10.16: mits: Wdt_cntToMs, Wdt_isFeedable, Wdt_getRestMs追加
+	2026.10.16: mits: Wdt_getCrash, Wdt_clrCrash追加
+	2026.10.16: mits: Wdt_calOsc追加
+	2026.10.16: mits: クリア間隔の学習(Wdt_learnStart, Wdt_learnApply, Wdt_getLearn)追加
 ***************************************************************************/
 #ifndef	WDT_LIB_H
 #define	WDT_LIB_H
 
+/***************************************************************************
+	定義
+***************************************************************************/
+enum {
+	WDT_HIST_NUM		= 16,	/* クリア間隔のヒストグラムの区間数 */
+	WDT_LEARN_MARGIN_SFT	= 2,	/* 学習した間隔に加える余裕(1/2^n、2で25%) */
+	WDT_LEARN_LEAD_MS	= 50	/* ms; 学習後も警告割り込みの前に残すクリア可能時間 */
+};
+
+/***************************************************************************
+	型定義
+***************************************************************************/
+
+/*** 警告割り込み時の記録(割り込まれた箇所) ***/
+typedef struct Wdt_crash {
+	uint32_t	pc;		/* 割り込まれた箇所のPC */
+	uint32_t	lr;		/* 同LR */
+	uint32_t	xpsr;	/* 同xPSR */
+	uint32_t	cnt;	/* 警告割り込みの発生回数(記録を消去するまでの累計) */
+} Wdt_crash;
+
+/*** クリア間隔の学習結果(Wdt_getLearn) ***/
+/* 間隔の単位はWDTカウンタ値(Wdt_cntToMsでmsに換算できる) */
+typedef struct Wdt_learn {
+	uint32_t	cnt;		/* 記録したクリアの回数 */
+	uint32_t	min;		/* 最短間隔 */
+	uint32_t	max;		/* 最長間隔 */
+	uint32_t	sft;		/* ヒストグラムの1区間の幅(2^sft) */
+	uint32_t	hist[WDT_HIST_NUM];	/* 間隔毎の回数(最後の区間はそれ以上の全て) */
+	_Bool		run;		/* 学習中 */
+	_Bool		applied;	/* 学習結果をTC, WINDOWに設定済み */
+} Wdt_learn;
+
 /***************************************************************************
 	グローバル関数
 ***************************************************************************/
 void		Wdt_ini(void);			/* WWDTユニットの初期化 */
+_Bool		Wdt_calOsc(void);		/* WDT用オシレータの周波数の較正(※Wdt_ini後に使用可能) */
 uint32_t	Wdt_getOscClk(void);	/* WDT用オシレータの周波数(※Wdt_ini後に使用可能) */
 void		Wdt_clr(void);			/* WDTクリア */
+uint32_t	Wdt_msToCnt(uint32_t ms);	/* 時間(ms)からWDTカウンタ値への換算(※Wdt_ini後に使用可能) */
+uint32_t	Wdt_cntToMs(uint32_t cnt);	/* WDTカウンタ値から時間(ms)への換算(※Wdt_ini後に使用可能) */
+_Bool		Wdt_isFeedable(void);	/* WDTクリア可能(ガード時間外)か否か */
+uint32_t	Wdt_getRestMs(void);	/* WDT満了までの残り時間(ms) */
+_Bool		Wdt_getCrash(Wdt_crash *crash);	/* 警告割り込み時の記録の取得 */
+void		Wdt_clrCrash(void);		/* 警告割り込み時の記録の消去 */
+void		Wdt_learnStart(uint32_t num);	/* クリア間隔の学習開始(num回で自動設定、0なら記録のみ) */
+_Bool		Wdt_learnApply(void);	/* 学習結果をTC, WINDOWに設定 */
+void		Wdt_getLearn(Wdt_learn *learn);	/* クリア間隔の学習結果の取得 */
 
 #endif	/* WDT_LIB_H */
@@ -11,6 +11,18 @@
 
 	変更履歴
 	2014.06.07: mits: 新規作成
+	2026.10.16: mits: SYS_CLK_MAX追加、設定値のビルド時チェックの説明追加
+	2026.10.16: mits: RECIP_1000, RECIP_1000_SFT, RATE_Q追加
+	2026.10.16: mits: RECIP_1000000, RECIP_1000000_SFT追加
+	2026.10.16: mits: NOINIT追加
+	2026.10.16: mits: PROF_ENABLE追加
+	2026.10.16: mits: IDLE_WAKE_US追加
+	2026.10.16: mits: RAMFUNC, RAMFUNC_ENABLE追加
+	2026.10.16: mits: SWM_PIN_MAP追加
+	2026.10.16: mits: SAMPLE_SYSTICK, SAMPLE_BLINK追加
+	2026.10.16: mits: SAMPLE_WDT_CAL, WDT_LEARN_ENABLE, UART_ENABLE追加、PROF_ENABLEの既定を0にした
+	2026.10.16: mits: SWM_PIN_MAPからSWM_CLKINを外した(Sys_libが必要な時だけ割り当てる)
+	2026.10.16: mits: SAMPLE_BLINKの既定を1(SCTのレジスタを直接設定して点滅)にし、SWM_CTOUT_0をSWM_PIN_MAPに加えた
 ***************************************************************************/
 #ifndef	CORE_H
 #define	CORE_H
@@ -23,6 +35,42 @@
 #include	"LPC8xx.h"		/* LPC800関連の定義 */
 #include	"lpc8xx_ctrl.h"	/* LPC800関連の定義追加版 */
 
+/***************************************************************************
+	コンパイラ依存の定義
+
+	・NOINIT
+		変数を.noinitセクションに配置する。
+		スタートアップでゼロクリアも初期化もされないため、リセット(WDT満了
+		など)をまたいで値が残る。電源投入直後の値は不定である。
+		リンカスクリプトで.noinitセクションをNOLOADとしてRAMに配置しておく
+		こと(LPCXpressoの自動生成リンカスクリプトは対応している)。
+
+	・RAMFUNC
+		関数を.ramfuncセクションに配置し、SRAM上で実行する。
+		リンカスクリプトで.ramfuncセクションを.dataセクション内(RAMに配置、
+		初期値はフラッシュ)に含めておけば、スタートアップの.dataの初期化で
+		フラッシュからSRAMへコピーされる(LPCXpressoの自動生成リンカスクリ
+		プトは.dataの先頭に*(.ramfunc*)を含めている)。
+		SRAMからの命令フェッチには待ち時間がないので、フラッシュのアクセス
+		時間(FLASHCFG)やクロック設定によらず実行時間が一定になる。
+		SRAMは1KBしかなく、.data, .bss, スタックと共用なので、割り込み処理
+		の入口などの短い関数だけに付けること。使用量はmake -C host ramsize
+		で確認できる。
+		インライン展開されるとフラッシュ側にコピーされてしまうので、
+		noinlineも付けている。SRAMの関数からフラッシュの関数を呼ぶと分岐先
+		が範囲外になるが、リンカが中継コード(veneer)を挿入する。
+	・RAMFUNC_ENABLE
+		0にするとRAMFUNCを付けた関数もフラッシュに置く(実行時間の比較用)。
+***************************************************************************/
+#define	NOINIT	__attribute__((section(".noinit")))
+
+#define	RAMFUNC_ENABLE	1		/* 0:フラッシュで実行、1:SRAMで実行 */
+#if	RAMFUNC_ENABLE
+#define	RAMFUNC	__attribute__((section(".ramfunc"), noinline))
+#else
+#define	RAMFUNC	__attribute__((noinline))
+#endif
+
 /***************************************************************************
 	クロック周波数の定義(Sys_lib.c内で使用)
 
@@ -32,7 +80,30 @@
 ***************************************************************************/
 enum {
 	IRC_HZ		= 12000000,	/* Hz; 内蔵オシレータ周波数 */
-	CLKIN_HZ	= 12000000	/* Hz; CLKIN端子からの入力クロック */
+	CLKIN_HZ	= 12000000,	/* Hz; CLKIN端子からの入力クロック */
+	SYS_CLK_MAX	= 30000000	/* Hz; LPC8xxシリーズ仕様上の最高速 */
+};
+
+/***************************************************************************
+	除算を使わない時間換算用の定数(Sys_lib.c, Wdt_lib.c内で使用)
+
+	Cortex-M0+には除算命令がないため、実行時の除算はライブラリ関数
+	(__aeabi_uidiv, __aeabi_uldivmod)の呼び出しとなり、遅い上にコードサイズ
+	も大きい。
+	そこで、1/1000, 1/1000000は逆数の乗算とシフトで求める。
+
+		x / 1000    = (x * RECIP_1000) >> RECIP_1000_SFT	(xは32ビット全域で正確)
+		x / 1000000 = (x * RECIP_1000000) >> RECIP_1000000_SFT	(同上)
+
+	周波数(Hz)から1ms(1us)当たりのクロック数を求める際は、小数部を残すため
+	RATE_Qビットの固定小数点数とする。
+***************************************************************************/
+enum {
+	RECIP_1000			= 0x10624DD3,	/* 2^38 / 1000(切り上げ) */
+	RECIP_1000_SFT		= 38,			/* RECIP_1000のシフト数 */
+	RECIP_1000000		= 0x431BDE83,	/* 2^50 / 1000000(切り上げ) */
+	RECIP_1000000_SFT	= 50,			/* RECIP_1000000のシフト数 */
+	RATE_Q				= 16			/* 1ms(1us)当たりのクロック数の小数部ビット数 */
 };
 
 /***************************************************************************
@@ -85,6 +156,12 @@ enum {
 		※LPC8xxシリーズ仕様上の最高速は30MHzである。
 
 	※すべてのケースでSYS_CLK_DIVは独立して機能する。
+
+	※メインクロックがSYS_CLK_MAXを超える組み合わせや、範囲外の値を指定した
+	　場合はビルドエラーとなる(Sys_lib.c内でチェックしている)。
+
+	※これらは起動時(Sys_iniLpc810)のクロック構成である。
+	　動作中にクロックを切り替える場合はSys_setClock()を使う(Sys_lib.c参照)。
 ***************************************************************************/
 enum {
 	MAIN_CLK_SEL	= SYS_MAIN_CLK_IRC,		/* メインクロック選択 */
@@ -198,6 +275,11 @@ enum {
 		指定可能である。
 		一番早いクロック設定(2.3MHz)だった場合は、1(=1ms)しか指定できない。
 
+	※各時間をWDTカウンタ値に換算した結果がレジスタの範囲外となる場合や、
+	　WWDT_TIM_GUARD, WWDT_TIM_WARNがWWDT_TIM_OUTに収まらない場合はビルド
+	　エラーとなる(Wdt_lib.c内でチェックしている)。
+	　WWDT_FREQ, WWDT_DIVの指定が不正な場合も同様である。
+
 	※WWDT_TIM_OUTとWWDT_TIM_WARNの指定範囲に関しては、以下のページで詳しく
 	　説明している。
 		http://mits-whisper.info/post/85408704581/lpc810-14
@@ -208,4 +290,107 @@ enum {
 	WWDT_TIM_WARN	= 200		/* ms; 警告発生時間 */
 };
 
+/***************************************************************************
+	処理時間計測の選択スイッチ(Prof_lib.h内で使用)
+
+	PROF_BEGIN/PROF_ENDによる区間毎の処理時間(クロック数)の計測を行うか
+	どうかを選択する。
+	0にすると、PROF_BEGIN/PROF_ENDはコンパイル時に消え、Prof_iniもMRTを
+	動かさない(ソースを書き換えずに計測を外せる)。
+***************************************************************************/
+enum {
+	PROF_ENABLE	= 0		/* 0:計測しない、1:計測する */
+};
+
+/***************************************************************************
+	サンプルプログラムの選択スイッチ(main.c, Uart_lib.c, Wdt_lib.c内で使用)
+
+	LPC810のフラッシュは4KB、SRAMは1KBしかないため、全部のライブラリの使
+	用例を入れると収まらない。
+	そこで、基本の機能(クロック選択、WDT監視、低消費電力待機、IN_PORTの
+	ピン割り込み)以外の使用例は、以下のスイッチで選ぶようにしている。
+	0にすると、その使用例とそこから呼び出すライブラリ関数はリンクされない
+	(リンカの--gc-sectionsで除かれる)。
+	1にした場合の大きさはmake -C host romsizeで確認すること。既定の設定で
+	4KBに収まるようにしており、全部1にすると収まらない。
+
+	・SAMPLE_SYSTICK
+		SysTick割り込み(SYSTICK_MS毎)と、その負荷の計測・周期の自動調整
+		の使用例を入れるかどうか。
+		SysTickはディープスリープ中に止まるので、1にするとIdle_runは常にス
+		リープで待機し、SYSTICK_MS毎に起床する。
+		0にすると、起床要因はWDTクリア期限(WKT)とピン割り込みだけになり、
+		SAMPLE_BLINKも0ならIdle_runはディープスリープ、またはパワーダウン
+		で待機する(待機中の消費電流を下げるのが目的なので、既定は0として
+		いる)。
+	・SAMPLE_BLINK
+		SCTによるLED_BLINKの点滅(PWM出力)の方法を選ぶ。
+		1(既定)はSCTのレジスタを直接設定するだけの最小の点滅で、Sct_libは
+		リンクされない。動作中にクロックを切り替えると周期がずれる。
+		2はSct_lib(Sct_ini, Sct_setPwm)を使い、クロックの切り替えにも追従
+		する(4KBには収まらない)。
+		SCTはシステムクロックで動くので、0以外ではIdle_runはディープスリー
+		プせずにスリープで待機する。待機中の消費電流を下げたい場合は0にす
+		る(LED_BLINKは消灯のまま)。
+	・SAMPLE_WDT_CAL
+		WDT用オシレータの起動時の較正(Wdt_calOsc、MRTを使う)の使用例を入
+		れるかどうか。
+	・WDT_LEARN_ENABLE
+		WDTクリアの間隔の学習(Wdt_learnStart)を使うかどうか。学習の記録は
+		Wdt_clrから呼ばれるので、0にするとWdt_lib.c側でも記録しない(学習
+		の処理と記録の領域がリンクされない)。
+	・UART_ENABLE
+		Uart_lib.cのUSART0割り込みハンドラは、ベクタテーブルから参照され
+		るので、Uart_iniを呼ばなくてもリンクされてしまう。0にすると、ハン
+		ドラは何もしない(バッファなども消える)。
+***************************************************************************/
+enum {
+	SAMPLE_SYSTICK		= 0,	/* 0:SysTickを使わない、1:SysTick割り込みを使う */
+	SAMPLE_BLINK		= 1,	/* 0:点滅しない、1:SCTでLED_BLINKを点滅(最小)、2:Sct_libで点滅 */
+	SAMPLE_WDT_CAL		= 0,	/* 0:なし、1:WDT用オシレータを起動時に較正(Wdt_calOsc) */
+	WDT_LEARN_ENABLE	= 0,	/* 0:学習しない、1:WDTクリアの間隔を学習(Wdt_lib) */
+	UART_ENABLE			= 0		/* 0:USART0を使わない、1:使う(Uart_lib) */
+};
+
+/***************************************************************************
+	待機時の応答時間の指定(Idle_lib.c内で使用)
+
+	Idle_runで待機している間に割り込み(ピン割り込みなど)が来てから、処理
+	を再開するまでに許される時間。
+	Idle_runは、起床時間(Sys_getWakeUs)がこの時間に収まる最も深い低消費
+	電力モード(ディープスリープ、パワーダウン)で待機する。
+	PLLを使っている場合はロック待ちの時間も含まれるので、小さくするとスリー
+	プでしか待機しなくなる。
+***************************************************************************/
+enum {
+	IDLE_WAKE_US	= 200		/* us; 起床の応答時間の上限 */
+};
+
+/***************************************************************************
+	ピン配置表(Swm_lib.c内で使用)
+
+	スイッチマトリクスで割り当てる機能とピン番号(PIO0_nのn)の組を、
+	X(機能, ピン番号)の並びで書く。機能はSwm_lib.hのSwm_func(SWM_*)。
+	Swm_iniがこの表の通りにピンを割り当てる(表に無い機能は割り当てなし)。
+
+	以下の場合はビルドエラーとなる。
+	・同じピンを2つの機能に割り当てた
+	・同じ機能を2回書いた
+	・LPC810に無いピン(PIO0_6以降)を書いた
+	・固定機能(SWM_SWCLK, SWM_CLKINなど)を決められたピン以外に書いた
+
+	動作中の付け替え(USARTのピンを一時的に借りるなど)はSwm_assign,
+	Swm_releaseで行う。
+	SWM_CLKINは表に書かない。メインクロックにCLKINを使うクロック構成(PLL
+	入力・出力で、PLL入力がCLKIN)の間だけ、Sys_iniLpc810, Sys_setClockが
+	Swm_assignで割り当て、それ以外の構成に切り替えると外す。その間は
+	PIO0_1を他の機能に使わないこと。
+	SWM_CTOUT_0はサンプル(main.c)のLED_BLINKである。SCTにクロックを供給
+	していない間(SAMPLE_BLINKが0)はL出力のままになる。
+***************************************************************************/
+#define	SWM_PIN_MAP(X)		\
+	X(SWM_SWDIO,	2)		\
+	X(SWM_SWCLK,	3)		\
+	X(SWM_CTOUT_0,	0)
+
 #endif	/* CORE_H */
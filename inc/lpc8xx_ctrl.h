@@ -8,11 +8,22 @@
 	コアライブラリ(CMSIS_CORE_LPC8xx)で定義されてなかったため、プログラム中
 	にマジックナンバーを直接書くよりかは可読性の向上を図るため用意した。
 
-	現版ではSYSCONとWWDT関連のものしか定義してない。
+	現版ではSYSCON, フラッシュコントローラ, PMU, WKT, PINT, USART, MRT, SCT, IOCON, SWM, WWDT
+	関連のものしか定義してない。
 	必要に応じて追加していく予定。
 
 	変更履歴
 	2014.06.07: mits: 新規作成
+	2026.10.16: mits: WDTOSC_FREQ_HZ, WWDT_CNT_MIN追加
+	2026.10.16: mits: PDSLEEPCFG, STARTERP1, PMU, WKT関連の定義追加
+	2026.10.16: mits: STARTERP0, PINT関連の定義追加
+	2026.10.16: mits: USART関連の定義追加
+	2026.10.16: mits: MRT関連の定義追加
+	2026.10.16: mits: フラッシュコントローラ(FLASHCFG)関連の定義追加
+	2026.10.16: mits: GPIO関連の定義追加
+	2026.10.16: mits: PINASSIGN関連の定義追加
+	2026.10.16: mits: IOCON_CFG_MASK, IOCONCLKDIV関連の定義追加
+	2026.10.16: mits: SCT関連の定義追加
 ***************************************************************************/
 #ifndef	LPC8XX_CTRL_H
 #define	LPC8XX_CTRL_H
@@ -86,6 +97,24 @@ enum {
 	WDTOSC_FREQ_4_40MHZ = 14,	/* 4.40MHz */
 	WDTOSC_FREQ_4_60MHZ = 15	/* 4.60MHz */
 };
+/* 選択コードに対応する周波数(Hz)　※定数式として使えるようマクロにしている */
+#define	WDTOSC_FREQ_HZ(sel)	(						\
+	((uint32_t)(sel) == WDTOSC_FREQ_600KHZ)?	600000:		\
+	((uint32_t)(sel) == WDTOSC_FREQ_1_05MHZ)?	1050000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_1_40MHZ)?	1400000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_1_75MHZ)?	1750000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_2_10MHZ)?	2100000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_2_40MHZ)?	2400000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_2_70MHZ)?	2700000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_3_00MHZ)?	3000000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_3_25MHZ)?	3250000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_3_50MHZ)?	3500000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_3_75MHZ)?	3750000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_4_00MHZ)?	4000000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_4_20MHZ)?	4200000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_4_40MHZ)?	4400000:	\
+	((uint32_t)(sel) == WDTOSC_FREQ_4_60MHZ)?	4600000:	\
+	0)
 
 /* システムリセット状態レジスタ(LPC_SYSCON->SYSRSTSTAT) */
 /* 0:該当のリセット非検出、1:該当のリセット検出　※1書きで要因クリア */
@@ -179,6 +208,274 @@ enum {
 	SYS_ACMP_PD		= 0x1<<15	/* Analog comparator power down . */
 };
 
+/* ディープスリープ時のパワーダウンレジスタ(LPC_SYSCON->PDSLEEPCFG) */
+/* 0:パワーオン、1:パワーダウン　※ビット位置はPDRUNCFGと同じ */
+enum {
+	SYS_PDSLEEP_RSV	= 0xFFB7	/* 予約ビット(1を書くこと) */
+								/* ※BOD_PD(b3), WDTOSC_PD(b6)以外のb0～b15 */
+};
+
+/* スタートロジック割り込み許可レジスタ0(LPC_SYSCON->STARTERP0) */
+/* 0:禁止、1:許可(ディープスリープ/パワーダウンからの起床要因とする) */
+enum {
+	SYS_START_PINT0	= 0x1<<0	/* GPIO pin interrupt 0 wake-up(PINTn: 0x1<<n) */
+};
+
+/* スタートロジック割り込み許可レジスタ1(LPC_SYSCON->STARTERP1) */
+/* 0:禁止、1:許可(ディープスリープ/パワーダウンからの起床要因とする) */
+enum {
+	SYS_START_SPI0	= 0x1<<0,	/* SPI0 interrupt wake-up */
+	SYS_START_SPI1	= 0x1<<1,	/* SPI1 interrupt wake-up */
+	SYS_START_UART0	= 0x1<<3,	/* USART0 interrupt wake-up */
+	SYS_START_UART1	= 0x1<<4,	/* USART1 interrupt wake-up */
+	SYS_START_UART2	= 0x1<<5,	/* USART2 interrupt wake-up */
+	SYS_START_I2C	= 0x1<<7,	/* I2C interrupt wake-up */
+	SYS_START_WWDT	= 0x1<<12,	/* WWDT interrupt wake-up */
+	SYS_START_BOD	= 0x1<<13,	/* BOD interrupt wake-up */
+	SYS_START_WKT	= 0x1<<15	/* Self wake-up timer interrupt wake-up */
+};
+
+/***************************************************************************
+	フラッシュコントローラ
+***************************************************************************/
+
+/* フラッシュ設定レジスタ(LPC_FLASHCTRL->FLASHCFG) */
+/* ※b31～b2は予約(値を変えないこと) */
+enum {
+	FLASH_TIM		= 0x3<<0,	/* フラッシュのアクセス時間(システムクロック数-1) */
+		FLASH_TIM_1CLK	= 0x0<<0,	/* 1クロック(システムクロックFLASH_1CLK_MAX_HZ以下) */
+		FLASH_TIM_2CLK	= 0x1<<0	/* 2クロック(同30MHz以下)　※リセット直後の値 */
+};
+enum {
+	FLASH_1CLK_MAX_HZ	= 20000000	/* Hz; 1クロックでアクセスできるシステムクロックの上限 */
+};
+
+/***************************************************************************
+	PMU
+***************************************************************************/
+
+/* 電源制御レジスタ(LPC_PMU->PCON) */
+enum {
+	PMU_PM			= 0x7<<0,	/* 電源モード(WFI実行時に移行するモード) */
+		PMU_PM_SLEEP		= 0x0<<0,	/* スリープ(またはSLEEPDEEP=1でディープスリープ) */
+		PMU_PM_DEEPSLEEP	= 0x1<<0,	/* ディープスリープ */
+		PMU_PM_POWERDOWN	= 0x2<<0,	/* パワーダウン */
+		PMU_PM_DPD			= 0x3<<0,	/* ディープパワーダウン */
+	PMU_NODPD		= 0x1<<3,	/* 1:ディープパワーダウンを禁止 */
+	PMU_SLEEPFLAG	= 0x1<<8,	/* スリープ系モードから復帰した(1書きでクリア) */
+	PMU_DPDFLAG		= 0x1<<11	/* ディープパワーダウンから復帰した(1書きでクリア) */
+};
+
+/* ディープパワーダウン制御レジスタ(LPC_PMU->DPDCTRL) */
+enum {
+	PMU_WAKEUPHYS		= 0x1<<0,	/* WAKEUP端子のヒステリシス有効 */
+	PMU_WAKEPAD_DIS		= 0x1<<1,	/* WAKEUP端子による起床を禁止 */
+	PMU_LPOSCEN			= 0x1<<2,	/* 低消費電力オシレータ(10kHz)有効 */
+	PMU_LPOSCDPDEN		= 0x1<<3	/* ディープパワーダウン中も低消費電力オシレータ有効 */
+};
+
+/***************************************************************************
+	セルフウェイクアップタイマ(WKT)
+***************************************************************************/
+
+/* WKT制御レジスタ(LPC_WKT->CTRL) */
+enum {
+	WKT_CLKSEL		= 0x1<<0,	/* クロック選択、0:IRC/16(750kHz)、1:低消費電力オシレータ(10kHz) */
+	WKT_ALARMFLAG	= 0x1<<1,	/* タイムアウトフラグ(1書きでクリア) */
+	WKT_CLEARCTR	= 0x1<<2	/* 1書きでカウンタをクリア(停止) */
+};
+
+/***************************************************************************
+	GPIO
+***************************************************************************/
+
+/* ポート0のピン数(LPC_GPIO_PORT->B0[], W0[]) */
+/*--------------------------------------------------------------------------
+	B0[n]	ピンnのバイトレジスタ。読むと0/1、書くとb0の値を出力する。
+	W0[n]	ピンnのワードレジスタ。読むと0/0xFFFFFFFF、書くと0以外でH出力。
+	MASK0	1のビットはMPIN0の読み書きの対象外(読むと0、書いても変化しない)。
+	MPIN0	MASK0が0のビットだけ読み書きする。
+	SET0, CLR0, NOT0は1のビットだけH出力、L出力、反転出力する。
+	どれも1回のストアで完結するので、割り込みとmain側で同時に使える
+	(MASK0の設定だけは共有されるので注意)。
+	※UM10601 - Chapter 7: LPC800 GPIO port
+--------------------------------------------------------------------------*/
+enum {
+	GPIO_PIN_NUM	= 18	/* PIO0_0～PIO0_17 */
+};
+
+/***************************************************************************
+	ピン割り込み(PINT)
+***************************************************************************/
+
+/* ピン割り込みのチャネル数(LPC_SYSCON->PINTSEL[], LPC_PIN_INT->*のビット) */
+enum {
+	PINT_CH_NUM		= 8,	/* チャネル0～7(PININT0_IRQn～PININT7_IRQn) */
+	PINT_PIN_MAX	= 17	/* PINTSELに指定できるピン番号(PIO0_0～PIO0_17) */
+};
+
+/*--------------------------------------------------------------------------
+	LPC_PIN_INTの各レジスタは、チャネルn(0～7)をビットnで表す。
+	ISEL	0:エッジ検出、1:レベル検出
+	IENR	エッジ:立ち上がり検出有効、レベル:検出有効(SIENR/CIENRで1書きセット/クリア)
+	IENF	エッジ:立ち下がり検出有効、レベル:0=L、1=Hで検出(SIENF/CIENFで同上)
+	RISE	立ち上がりを検出した(1書きでクリア)
+	FALL	立ち下がりを検出した(1書きでクリア)
+	IST		割り込み要求中(エッジ:1書きでクリア、レベル:1書きで検出レベルを反転)
+	※UM10601 - Chapter 8: LPC800 Pin interrupts/pattern match engine
+--------------------------------------------------------------------------*/
+
+/***************************************************************************
+	USART
+***************************************************************************/
+
+/* USART設定レジスタ(LPC_USART0->CFG) */
+enum {
+	UART_CFG_ENABLE		= 0x1<<0,	/* USART有効化(ボーレートの設定変更は0の間に行う) */
+	UART_CFG_DATALEN	= 0x3<<2,	/* データ長 */
+		UART_CFG_DATALEN_7	= 0x0<<2,	/* 7ビット */
+		UART_CFG_DATALEN_8	= 0x1<<2,	/* 8ビット */
+		UART_CFG_DATALEN_9	= 0x2<<2,	/* 9ビット */
+	UART_CFG_PARITY		= 0x3<<4,	/* パリティ */
+		UART_CFG_PARITY_NONE	= 0x0<<4,	/* なし */
+		UART_CFG_PARITY_EVEN	= 0x2<<4,	/* 偶数 */
+		UART_CFG_PARITY_ODD		= 0x3<<4,	/* 奇数 */
+	UART_CFG_STOPLEN	= 0x1<<6	/* 0:ストップビット1、1:2 */
+};
+
+/* USARTステータスレジスタ(LPC_USART0->STAT)、割り込み許可(INTENSET/INTENCLR) */
+/* ★のビットはSTATへの1書きでクリアする */
+enum {
+	UART_RXRDY		= 0x1<<0,	/* 　受信データあり(RXDATAの読み出しでクリア) */
+	UART_RXIDLE		= 0x1<<1,	/* 　受信アイドル(STATのみ) */
+	UART_TXRDY		= 0x1<<2,	/* 　送信データ書き込み可(TXDATAの書き込みでクリア) */
+	UART_TXIDLE		= 0x1<<3,	/* 　送信完了(シフトレジスタも空) */
+	UART_OVERRUN	= 0x1<<8,	/* ★オーバーラン(RXDATA未読のまま次を受信した) */
+	UART_DELTARXBRK	= 0x1<<11,	/* ★ブレーク検出状態の変化 */
+	UART_START		= 0x1<<12,	/* ★スタートビット検出 */
+	UART_FRAMERR	= 0x1<<13,	/* ★フレーミングエラー */
+	UART_PARITYERR	= 0x1<<14,	/* ★パリティエラー */
+	UART_RXNOISE	= 0x1<<15	/* ★受信ノイズ */
+};
+/* ※INTENSETのb8はOVERRUNENで、オーバーランの割り込み許可 */
+
+/* 伝送速度の設定値 */
+/*--------------------------------------------------------------------------
+	伝送速度は以下の式で決まる(USART0～2で共通なのはUARTCLKDIVとFRG)。
+	U_PCLK = メインクロック / UARTCLKDIV / (1 + UARTFRGMULT / (UARTFRGDIV + 1))
+	伝送速度 = U_PCLK / (UART_OVERSAMPLE * (BRG + 1))
+	UARTFRGDIVは0xFF固定で使う(UM10601 - 4.6.20)。
+	UARTCLKDIVが0の間はU_PCLKが停止する。
+	※UM10601 - Chapter 15: LPC800 USART0/1/2
+--------------------------------------------------------------------------*/
+enum {
+	UART_OVERSAMPLE		= 16,		/* 1ビット当たりのU_PCLK数 */
+	UART_CLKDIV_MAX		= 0xFF,		/* LPC_SYSCON->UARTCLKDIV */
+	UART_FRGDIV_VAL		= 0xFF,		/* LPC_SYSCON->UARTFRGDIV(固定) */
+	UART_FRGMULT_MAX	= 0xFF,		/* LPC_SYSCON->UARTFRGMULT */
+	UART_BRG_MAX		= 0xFFFF	/* LPC_USART0->BRG */
+};
+
+/***************************************************************************
+	マルチレートタイマ(MRT)
+***************************************************************************/
+
+/* MRTのチャネル数(LPC_MRT->Channel[]) */
+enum {
+	MRT_CH_NUM		= 4		/* チャネル0～3(割り込みはMRT_IRQnの1本) */
+};
+
+/* 時間間隔レジスタ(LPC_MRT->Channel[n].INTVAL)、タイマレジスタ(TIMER) */
+/*--------------------------------------------------------------------------
+	各チャネルはシステムクロックで動く31ビットのダウンカウンタである。
+	TIMERはIVALUEから0まで数えて、リピートモードではIVALUEを再ロードする
+	(周期はIVALUE+1クロック)。
+	INTVALのb31(MRT_LOAD)を1にして書くと、カウント中でも直ちにロードする。
+	※UM10601 - Chapter 11: LPC800 Multi-Rate Timer (MRT)
+--------------------------------------------------------------------------*/
+enum {
+	MRT_IVALUE_MAX	= 0x7FFFFFFF	/* 時間間隔(IVALUE)、TIMERの最大値 */
+};
+#define	MRT_LOAD	0x80000000UL	/* INTVALに直ちにロード(intに収まらないのでマクロ) */
+
+/* 制御レジスタ(LPC_MRT->Channel[n].CTRL) */
+enum {
+	MRT_INTEN		= 0x1<<0,	/* 割り込み許可 */
+	MRT_MODE		= 0x3<<1,	/* 動作モード */
+		MRT_MODE_REPEAT		= 0x0<<1,	/* リピート */
+		MRT_MODE_ONESHOT	= 0x1<<1,	/* ワンショット */
+		MRT_MODE_STALL		= 0x2<<1	/* ワンショット(バスストール) */
+};
+
+/* 状態レジスタ(LPC_MRT->Channel[n].STAT) */
+enum {
+	MRT_INTFLAG		= 0x1<<0,	/* 割り込み要求(1書きでクリア) */
+	MRT_RUN			= 0x1<<1	/* カウント中 */
+};
+
+/***************************************************************************
+	ステートコンフィギュラブルタイマ(SCT)
+***************************************************************************/
+
+/* SCTの資源数(LPC_SCT->MATCH[], MATCHREL[], EVENT[], OUT[]) */
+/*--------------------------------------------------------------------------
+	LPC81xのSCTは、マッチ/キャプチャレジスタ5本、イベント6個、ステート2
+	個、出力4本(CTOUT_0～3、ピンへはSWMで割り当てる)を持つ。
+	※UM10601 - Chapter 10: LPC800 State Configurable Timer (SCT)
+--------------------------------------------------------------------------*/
+enum {
+	SCT_MATCH_NUM	= 5,	/* MATCH0～4 */
+	SCT_EV_NUM		= 6,	/* イベント0～5 */
+	SCT_OUT_NUM		= 4		/* CTOUT_0～3 */
+};
+
+/* 構成レジスタ(LPC_SCT->CONFIG) */
+enum {
+	SCT_UNIFY			= 0x1<<0,	/* 32ビットカウンタ1本で使う(0:16ビット×2) */
+	SCT_CLKMODE			= 0x3<<1,	/* クロックモード */
+		SCT_CLKMODE_BUS		= 0x0<<1,	/* システムクロック */
+	SCT_NORELOAD_L		= 0x1<<7,	/* MATCHRELからMATCHへの再ロードを禁止 */
+	SCT_AUTOLIMIT_L		= 0x1<<17	/* MATCH0との一致をリミットとする(カウンタを0に戻す) */
+};
+
+/* 制御レジスタ(LPC_SCT->CTRL_U) ※SCT_UNIFYの場合はL側のビットを使う */
+enum {
+	SCT_DOWN_L		= 0x1<<0,	/* ダウンカウント中 */
+	SCT_STOP_L		= 0x1<<1,	/* 停止(イベントでは再開可) */
+	SCT_HALT_L		= 0x1<<2,	/* 中断(リセット値で1、ソフトウェアで0にするまで止まる) */
+	SCT_CLRCTR_L	= 0x1<<3,	/* 1書きでカウンタをクリア(読むと0) */
+	SCT_BIDIR_L		= 0x1<<4,	/* アップダウンカウント */
+	SCT_PRE_L		= 0xFF<<5	/* プリスケーラ(分周値-1) */
+};
+
+/* イベント制御レジスタ(LPC_SCT->EVENT[n].CTRL) */
+/*--------------------------------------------------------------------------
+	EVENT[n].STATEには、イベントを有効にするステートをビットで設定する
+	(ステート0だけなら0x1)。
+--------------------------------------------------------------------------*/
+enum {
+	SCT_EV_MATCHSEL		= 0xF<<0,	/* 一致を調べるMATCHの番号 */
+	SCT_EV_COMBMODE		= 0x3<<12,	/* 一致と入出力の組み合わせ */
+		SCT_EV_COMB_OR		= 0x0<<12,	/* 一致または入出力 */
+		SCT_EV_COMB_MATCH	= 0x1<<12,	/* 一致のみ */
+		SCT_EV_COMB_IO		= 0x2<<12,	/* 入出力のみ */
+		SCT_EV_COMB_AND		= 0x3<<12,	/* 一致かつ入出力 */
+	SCT_EV_STATELD		= 0x1<<14,	/* STATEVをステートにロード(0:加算) */
+	SCT_EV_STATEV		= 0x1F<<15	/* ステートの値 */
+};
+enum {
+	SCT_EV_STATE0		= 0x1<<0	/* EVENT[n].STATE: ステート0で有効 */
+};
+
+/* 出力の衝突時の動作(LPC_SCT->RES、出力n毎に2ビット) */
+enum {
+	SCT_RES_NONE	= 0x0,	/* 変化なし */
+	SCT_RES_SET		= 0x1,	/* セット */
+	SCT_RES_CLR		= 0x2,	/* クリア */
+	SCT_RES_TGL		= 0x3,	/* 反転 */
+	SCT_RES_BITS	= 2		/* 出力1本当たりのビット数 */
+};
+
 /***************************************************************************
 	IOCON
 ***************************************************************************/
@@ -213,6 +510,25 @@ enum {
 		IOCON_CLK_DIV5			= 0x5<<13,	/* IOCONCLKDIV5. */
 		IOCON_CLK_DIV6			= 0x6<<13	/* IOCONCLKDIV6. */
 };
+enum {
+	IOCON_CFG_MASK	= IOCON_MODE | IOCON_HYS | IOCON_INV | IOCON_OD | IOCON_S_MODE | IOCON_CLK_DIV,
+							/* 設定できるビット(b0～b2, b7～b9は予約、読んだ値のまま書く) */
+	IOCON_S_MODE_SFT	= 11,	/* IOCON_S_MODEのシフト数(値はフィルタのクロック数) */
+	IOCON_CLK_DIV_SFT	= 13	/* IOCON_CLK_DIVのシフト数 */
+};
+
+/* 入力フィルタのクロック分周レジスタ(LPC_SYSCON->IOCONCLKDIV[]) */
+/*--------------------------------------------------------------------------
+	フィルタのクロック = メインクロック / IOCONCLKDIVn(0で停止、リセット値)
+	IOCON_S_MODE_nCLOCKのピンは、このクロックn回分より短いパルスを除く。
+	CMSISのIOCONCLKDIV[]はアドレス順なので、番号と逆順になる
+	(IOCONCLKDIV[0]がIOCONCLKDIV6、IOCONCLKDIV[6]がIOCONCLKDIV0)。
+	※UM10601 - 4.6.19 Peripheral glitch filter clock divider registers 0 to 6
+--------------------------------------------------------------------------*/
+enum {
+	IOCON_CLKDIV_NUM	= 7,	/* IOCONCLKDIV0～6 */
+	IOCON_CLKDIV_MAX	= 0xFF	/* 分周値の最大 */
+};
 
 /***************************************************************************
 	Switch Matrix
@@ -235,6 +551,26 @@ enum {
 	SWM_CLKIN_DIS	= 0x1<<7,	/* 　0：5番pin(PIO0_1)にCLKINを割り当て有効化、1：無効 */
 	SWM_VDDCMP_DIS	= 0x1<<8	/* 　0：PIO0_6にVDDCMPを割り当て有効化、1：無効　※LPC810では無効 */
 };
+enum {
+	SWM_FIXED_NUM	= 9,		/* 固定機能の数(PINENABLE0のb0～b8) */
+	SWM_FIXED_MASK	= 0x1FF		/* 固定機能のビット(b9～b31は予約) */
+};
+
+/* ピンアサインレジスタ(LPC_SWM->PINASSIGN0～8) */
+/*--------------------------------------------------------------------------
+	どのピンにも割り当てられる機能(USART, SPI, SCT, I2Cなど)毎に、割り当
+	てるピン番号(PIO0_nのn)を8ビットで設定する。
+	機能番号nはPINASSIGN(n/4)のビット(n%4)*8～(n%4)*8+7で、0xFFは割り当
+	てなし(リセット値)。機能番号はSwm_lib.hのSwm_funcを参照。
+	※UM10601 - Chapter 9: LPC800 Switch Matrix
+--------------------------------------------------------------------------*/
+enum {
+	SWM_PINASSIGN_NUM	= 9,	/* PINASSIGN0～8 */
+	SWM_ASSIGN_PER_REG	= 4,	/* 1レジスタ当たりの機能数 */
+	SWM_ASSIGN_BITS		= 8,	/* 1機能当たりのビット数 */
+	SWM_ASSIGN_NONE		= 0xFF,	/* 割り当てなし */
+	SWM_PIN_NUM			= 6		/* LPC810(DIP8)のピン(PIO0_0～PIO0_5) */
+};
 
 /***************************************************************************
 	ウィンドウウォッチドッグタイマ(WWDT)
@@ -253,6 +589,7 @@ enum {
 
 /* 各カウンタの最大値 */
 enum {
+	WWDT_CNT_MIN	= 0xFF,		/* WWDTカウンタ(LPC_WWDT->TC)の最小値 */
 	WWDT_CNT_MAX	= 0xFFFFFF,	/* WWDTカウンタ(LPC_WWDT->TC) */
 	WWDT_WINDOW_MAX	= 0xFFFFFF,	/* WWDTウィンドウカウンタ(LPC_WWDT->WINDOW) */
 	WWDT_WARN_MAX	= 0x3FF		/* WWDT警告割り込みカウンタ(LPC_WWDT->WARNINT) */
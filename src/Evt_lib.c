@@ -0,0 +1,185 @@
+/***************************************************************************
+	Evt_lib.c
+	私家版イベントキューライブラリ
+
+	使用方法: #include "Evt_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	割り込み処理の中で行っていた処理をmain側へ移すためのライブラリ。
+	割り込み処理はイベント(番号と8ビットの引数)をキューに積むだけにして、
+	実際の処理はmain側(Idle_runで待機する前など)でまとめて行う。
+	機能を追加しても割り込み処理の時間は延びない。
+
+	・Evt_addQue
+		イベントキューを登録する。キューは書き込む割り込み処理毎に1本用意
+		すること(書き込み側1つ、読み出し側1つの前提で排他を省いている)。
+	・Evt_setFunc
+		イベント番号毎の処理関数を登録する。
+	・Evt_post
+		イベントをキューに積む。割り込み処理から呼び出す。
+		満杯の場合は捨てて、捨てた数(lost)を数える。
+	・Evt_run
+		登録された全キューのイベントを取り出し、処理関数を呼び出す。
+		呼び出し時点で溜まっていた分だけ処理して戻る(処理中に積まれた分は
+		次回)。
+	・Evt_isEmpty
+		未処理のイベントが無いかを返す。割り込み禁止のままIdle_runの直前で
+		確認すれば、イベントを残したまま眠り込むことはない。
+
+	排他について:
+	headは書き込み側だけが、tailは読み出し側だけが更新し、どちらも1バイト
+	の読み書きなので分断されることはない。書き込み側はbufに書いてからhead
+	を、読み出し側はbufを読んでからtailを進める。Cortex-M0+はシングルコア
+	で書き込み順序も入れ替わらないので、volatileによる順序の保証だけで割
+	り込み禁止は不要である。
+	同じキューに複数の割り込み処理から書き込む場合は、この前提が崩れるので
+	キューを分けること。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#include	"core.h"
+#include	"Evt_lib.h"
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	EVT_QUE_MASK	= EVT_QUE_SIZE - 1,	/* キューの位置のマスク */
+	EVT_ID_BITS		= 8,				/* イベント番号のビット数 */
+	EVT_ID_MASK		= (0x1 << EVT_ID_BITS) - 1,
+	EVT_LOST_MAX	= 0xFF				/* lostの上限 */
+};
+
+_Static_assert((EVT_QUE_SIZE & EVT_QUE_MASK) == 0 && EVT_QUE_SIZE <= 128,
+	"EVT_QUE_SIZE must be a power of 2 (max 128)");
+_Static_assert(EVT_ID_MAX <= EVT_ID_MASK + 1, "EVT_ID_MAX must fit in 8 bits");
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static Evt_que	*Evt_ques[EVT_QUE_MAX];		/* 登録済みキュー */
+static uint32_t	Evt_queNum;					/* 登録済みキュー数 */
+static Evt_func	Evt_funcs[EVT_ID_MAX];		/* イベント処理関数 */
+
+/***************************************************************************
+	Evt_addQue
+	キューの登録
+	※割り込みを許可する前(setupなど)に呼び出すこと
+
+	[引数]	que	キュー(静的に確保しておくこと)
+	[戻値]	登録できた(true), 登録数の上限を超えた(false)
+***************************************************************************/
+_Bool Evt_addQue(Evt_que *que)
+{
+	if (Evt_queNum >= EVT_QUE_MAX) {
+		return false;
+	}
+	que->head = 0;
+	que->tail = 0;
+	que->lost = 0;
+	Evt_ques[Evt_queNum++] = que;
+	return true;
+}
+
+/***************************************************************************
+	Evt_setFunc
+	イベント処理関数の登録
+
+	[引数]	id		イベント番号(0～EVT_ID_MAX-1)
+			func	処理関数
+	[戻値]	登録できた(true), 番号が範囲外(false)
+
+	処理関数が登録されていないイベントは、取り出して捨てる。
+***************************************************************************/
+_Bool Evt_setFunc(uint32_t id, Evt_func func)
+{
+	if (id >= EVT_ID_MAX) {
+		return false;
+	}
+	Evt_funcs[id] = func;
+	return true;
+}
+
+/***************************************************************************
+	Evt_post
+	イベントの送信
+
+	[引数]	que	キュー(呼び出し元の割り込み処理専用のもの)
+			id	イベント番号(0～EVT_ID_MAX-1)
+			arg	引数(0～EVT_ARG_MAX)
+	[戻値]	積めた(true), 満杯または範囲外で捨てた(false)
+
+	割り込み禁止にはしない。
+***************************************************************************/
+_Bool Evt_post(Evt_que *que, uint32_t id, uint32_t arg)
+{
+	uint8_t		head = que->head;
+
+	if ((id >= EVT_ID_MAX) || (arg > EVT_ARG_MAX)
+	 || ((uint8_t)(head - que->tail) >= EVT_QUE_SIZE)) {
+		if (que->lost < EVT_LOST_MAX) {
+			que->lost++;
+		}
+		return false;
+	}
+	que->buf[head & EVT_QUE_MASK] = (uint16_t)(id | (arg << EVT_ID_BITS));
+	que->head = head + 1;		/* 書き込み後に公開 */
+	return true;
+}
+
+/***************************************************************************
+	Evt_run
+	溜まったイベントの処理
+
+	[引数]	なし
+	[戻値]	処理したイベント数
+
+	登録順にキューを調べ、呼び出し時点で溜まっていたイベントを古い順に取
+	り出して処理関数を呼び出す。
+	割り込み処理からは呼び出さないこと。
+***************************************************************************/
+uint32_t Evt_run(void)
+{
+	uint32_t	i;
+	uint32_t	num = 0;
+	Evt_que		*que;
+	uint8_t		head, tail;
+	uint16_t	evt;
+	Evt_func	func;
+
+	for (i = 0; i < Evt_queNum; i++) {
+		que = Evt_ques[i];
+		head = que->head;
+		for (tail = que->tail; tail != head; ) {
+			evt = que->buf[tail & EVT_QUE_MASK];
+			que->tail = ++tail;		/* 読み出し後に解放 */
+			func = Evt_funcs[evt & EVT_ID_MASK];
+			if (func != 0) {
+				func(evt >> EVT_ID_BITS);
+			}
+			num++;
+		}
+	}
+	return num;
+}
+
+/***************************************************************************
+	Evt_isEmpty
+	未処理のイベントが無いか否か
+
+	[引数]	なし
+	[戻値]	無い(true), 有る(false)
+***************************************************************************/
+_Bool Evt_isEmpty(void)
+{
+	uint32_t	i;
+
+	for (i = 0; i < Evt_queNum; i++) {
+		if (Evt_ques[i]->head != Evt_ques[i]->tail) {
+			return false;
+		}
+	}
+	return true;
+}
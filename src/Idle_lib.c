@@ -0,0 +1,232 @@
+/***************************************************************************
+	Idle_lib.c
+	私家版アイドル(低消費電力待機)ライブラリ
+
+	使用方法: #include "Idle_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	main()の定常ループで空回りする代わりに、次の起床要因までコアを止めて
+	待機するためのライブラリ。
+
+	・Idle_ini
+		起床用のセルフウェイクアップタイマ(WKT)を初期化する。
+	・Idle_run
+		WDTをクリア(Sup_feed)した後、次の起床時刻を求めてWKTを設定し、ス
+		リープ、またはSys_selPowerModeで選んだ低消費電力モード(ディープス
+		リープ、パワーダウン)で待機する。
+		起床時刻は以下のうち最も早いものとする。
+			・引数で指定した待機時間
+			・WDTクリア期限(警告割り込み発生の少し前)
+			・報告の無い監視タスク(Sup_lib)の期限の少し前
+			・SysTick割り込み(動作中の場合)
+	・WKT_IRQHandler
+		WKTの割り込みハンドラ。タイムアウトフラグをクリアするだけ。
+
+	WKTのクロックには低消費電力オシレータ(10kHz)を使う。
+	本オシレータは精度が±40%と悪いため、最も遅い場合(6kHz)でも起床が
+	期限に間に合うようにカウント値を決めている。つまり、通常は指定時間よ
+	りも早めに起床することになるが、その場合は再度Idle_runを呼び出せば、
+	残り時間で待機し直す。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: WDTクリアをSup_feed経由にした
+	2026.10.16: mits: USART0使用中はディープスリープしないようにした
+	2026.10.16: mits: WDTクリア間隔の学習後も起床がガード時間明けになることを確認
+	2026.10.16: mits: 待機をSys_enterPowerModeで行い、モードを応答時間(IDLE_WAKE_US)で選ぶようにした
+	2026.10.16: mits: WKTへのクロック供給をSys_acqClkで行うようにした
+	2026.10.16: mits: SCT使用中はディープスリープしないようにした
+	2026.10.16: mits: SysTickを使う場合の消費電力の説明追加
+	2026.10.16: mits: 監視タスクの期限までに起床するようにし、期限切れ後は空回りせず待機するよう修正
+***************************************************************************/
+#include	"core.h"
+#include	"Idle_lib.h"
+#include	"Sys_lib.h"		/* for Sys_msToTicks, Sys_enterPowerMode, Sys_selPowerMode, Sys_acqClk */
+#include	"Wdt_lib.h"		/* for Wdt_* */
+#include	"Sup_lib.h"		/* for Sup_feed, Sup_getRestMs */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	IDLE_WDT_MARGIN_MS	= 50,	/* ms; 警告割り込みより前に起床する余裕時間 */
+	IDLE_WDT_LEAD_MS	= WWDT_TIM_WARN + IDLE_WDT_MARGIN_MS,	/* ms; WDT満了の何ms前に起床するか */
+	IDLE_SUP_MARGIN_MS	= 50,	/* ms; 監視タスクの期限より前に起床する余裕時間(起床後の処理の分) */
+	IDLE_DEEP_MIN_MS	= 10,	/* ms; これより短い待機はスリープで行う(復帰時間の方が長くなるため) */
+	LPOSC_MIN_KHZ		= 6		/* kHz; 低消費電力オシレータ(10kHz±40%)の下限 */
+};
+
+/*** 起床がガード時間明けになることの確認 ***/
+_Static_assert(WWDT_TIM_OUT - IDLE_WDT_LEAD_MS >= WWDT_TIM_GUARD,
+	"WWDT_TIM_OUT is too short for idle wake-up (need OUT - WARN - margin >= GUARD)");
+/* Wdt_learnApplyの設定後も同様(クリア可能な期間をWWDT_TIM_WARN＋WDT_LEARN_LEAD_MS残す) */
+_Static_assert((uint32_t)IDLE_WDT_MARGIN_MS <= (uint32_t)WDT_LEARN_LEAD_MS, "IDLE_WDT_MARGIN_MS exceeds WDT_LEARN_LEAD_MS");
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static void Idle_startWkt(uint32_t ms);
+
+/***************************************************************************
+	Idle_ini
+	アイドル処理の初期化
+	※Sys_iniLpc810の後に呼び出すこと
+
+	[引数]	なし
+	[戻値]	なし
+
+	WKTにクロックを供給し、低消費電力オシレータを起動する。
+	WKTとWDT警告割り込みをディープスリープからの起床要因として登録する。
+***************************************************************************/
+void Idle_ini(void)
+{
+	(void)Sys_acqClk(SYS_AHB_CLK_WKT, SYS_WKT_RST_N);	/* WKTへクロック供給(返さない) */
+
+	LPC_PMU->DPDCTRL |= PMU_LPOSCEN;				/* 低消費電力オシレータ起動 */
+	LPC_WKT->CTRL = WKT_CLKSEL | WKT_CLEARCTR | WKT_ALARMFLAG;
+
+	LPC_SYSCON->STARTERP1 |= SYS_START_WKT | SYS_START_WWDT;
+	NVIC_SetPriority(WKT_IRQn, PRI_LOW);
+	NVIC_EnableIRQ(WKT_IRQn);
+}
+
+/***************************************************************************
+	Idle_run
+	次の起床要因まで低消費電力で待機
+	※Idle_iniを呼び出しておくこと
+
+	[引数]	ms	最大待機時間(ms)、IDLE_FOREVERで指定なし
+	[戻値]	なし
+
+	本関数は割り込み禁止(__disable_irq)の状態で呼び出すこと。
+	定常側で処理すべき事象が無いことを割り込み禁止のまま確認し、そのまま
+	本関数を呼び出せば、確認からWFIまでの間に発生した割り込みを取りこぼ
+	して眠り込むことはない(割り込み禁止中でもWFIは割り込み要求で起床す
+	る)。本関数は起床後に割り込みを許可して戻るので、その時点で割り込み
+	処理が実行される。
+
+	WDTはSup_feedでクリアする(ガード時間中や報告の無いタスクがある場合は
+	クリアされない)。次のクリア期限(警告割り込み発生のIDLE_WDT_MARGIN_MS
+	前)までに起床するようにする。
+	さらに、報告の無い監視タスク(Sup_add)の期限のIDLE_SUP_MARGIN_MS前ま
+	でに起床する(Sup_getRestMs)。定常処理(main)は本関数の直前に報告する
+	が、WDTをクリアすると報告はリセットされるので、クリア期限まで眠ると
+	WWDT_TIM_OUTより短い期限の報告が間に合わず、WDTが満了してしまうため。
+	期限を過ぎたタスクの報告は無視されるので、起床時刻には含めない。
+
+	起床時刻の余裕が無い(期限の余裕時間内に入った)場合は、期限そのものを
+	起床時刻とする。WDTのクリア期限を過ぎても本関数に来ているのは、報告
+	の無いタスクがあってクリアできなかった場合で、もうWDT満了は避けられ
+	ない。その場合も、空回りせずに警告割り込み・WDT満了まで待機する。
+	待機せずにすぐ戻る(割り込みを許可する)のは、引数msが0の場合だけで
+	ある。
+
+	SysTick割り込みが動作中の場合は、ディープスリープ中にSysTickが止まっ
+	てしまうためスリープを使う。その場合、SysTick割り込みの方が先に来る
+	ならばWKTは使わない。
+	つまり、周期的なSysTick割り込みを動かしたままでは、待機時間の大半を
+	スリープ(フラッシュ、IRCとも動作したまま)で過ごすことになり、ディー
+	プスリープ・パワーダウンの消費電流には下がらない。周期的な処理は
+	Idle_runの引数(ms)で起床時刻を指定して、起床後にmain側で行うこと
+	(WKTで起床するので、待機はディープスリープ以下で行える)。
+	USART0を使用している(クロック供給中の)場合も、ディープスリープ中は
+	送受信できなくなるためスリープを使う。SCTも同様に、出力(PWM、点滅)が
+	止まってしまうためスリープを使う。
+	それ以外は、起床時間がIDLE_WAKE_US以内に収まる最も深いモードを
+	Sys_selPowerModeで選ぶ。PLLを使用している場合は、ロック待ちの分だけ
+	起床時間が延びる(Sys_enterPowerModeが起床後にPLLへ戻す)。
+***************************************************************************/
+void Idle_run(uint32_t ms)
+{
+	enum {
+		TICK_RUN = SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk
+	};
+	Sys_pmode	mode;
+	uint32_t	rest;
+	_Bool		tick;
+
+	/* WDTクリア(ガード時間中の場合は次の起床時に行う) */
+	(void)Sup_feed();
+
+	/* 起床時刻の決定: WDTクリア期限(過ぎていれば満了の時刻) */
+	rest = Wdt_getRestMs();
+	if (rest != UINT32_MAX) {
+		if (rest > IDLE_WDT_LEAD_MS) {
+			rest -= IDLE_WDT_LEAD_MS;
+		}
+		if ((rest != 0) && (rest < ms)) {
+			ms = rest;
+		}
+	}
+
+	/* 起床時刻の決定: 報告の無い監視タスクの期限 */
+	rest = Sup_getRestMs();
+	if (rest != UINT32_MAX) {
+		if (rest > IDLE_SUP_MARGIN_MS) {
+			rest -= IDLE_SUP_MARGIN_MS;
+		}
+		if ((rest != 0) && (rest < ms)) {
+			ms = rest;
+		}
+	}
+	if (ms == 0) {
+		__enable_irq();
+		return;
+	}
+
+	/* 起床時刻の決定: SysTick割り込み */
+	tick = ((SysTick->CTRL & TICK_RUN) == TICK_RUN)? true: false;
+	if (!tick || SysTick->VAL >= Sys_msToTicks(ms)) {
+		if (ms != IDLE_FOREVER) {
+			Idle_startWkt(ms);
+		}
+	}
+
+	/* 待機 */
+	if (tick || ms < IDLE_DEEP_MIN_MS
+	 || (LPC_SYSCON->SYSAHBCLKCTRL & (SYS_AHB_CLK_UART0 | SYS_AHB_CLK_SCT)) != 0) {
+		mode = SYS_PM_SLEEP;
+	}
+	else {
+		mode = Sys_selPowerMode(IDLE_WAKE_US);
+	}
+	(void)Sys_enterPowerMode(mode);
+
+	/* 他の要因で起床した場合に備えてWKTを停止 */
+	LPC_WKT->CTRL = WKT_CLKSEL | WKT_CLEARCTR;
+	__enable_irq();
+}
+
+/***************************************************************************
+	Idle_startWkt
+	WKTの起動
+
+	[引数]	ms	タイムアウトまでの時間(ms)
+	[戻値]	なし
+
+	低消費電力オシレータが最も遅い(LPOSC_MIN_KHZ)場合でも、指定時間以内
+	にタイムアウトするカウント値を設定する。
+	COUNTレジスタへの書き込みでカウント開始となる。
+***************************************************************************/
+static void Idle_startWkt(uint32_t ms)
+{
+	uint64_t	cnt = (uint64_t)ms * LPOSC_MIN_KHZ;
+
+	LPC_WKT->CTRL = WKT_CLKSEL | WKT_CLEARCTR | WKT_ALARMFLAG;
+	LPC_WKT->COUNT = (cnt > UINT32_MAX)? UINT32_MAX: (uint32_t)cnt;
+}
+
+/***************************************************************************
+	WKT_IRQHandler
+	WKT割り込みハンドラ
+
+	[引数]	なし
+	[戻値]	なし
+
+	起床させるだけなので、タイムアウトフラグをクリアするのみ。
+***************************************************************************/
+void WKT_IRQHandler(void)
+{
+	LPC_WKT->CTRL = WKT_CLKSEL | WKT_ALARMFLAG;
+}
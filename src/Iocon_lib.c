@@ -0,0 +1,207 @@
+/***************************************************************************
+	Iocon_lib.c
+	私家版IOCON(ピン設定)ライブラリ
+
+	使用方法: #include "Iocon_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	ピン毎のプルアップ/ダウン、ヒステリシス、入力反転、疑似オープンドレイ
+	ン、入力フィルタ(グリッチ除去)を設定するためのライブラリ。
+	入力フィルタを使えば、ノイズによる短いパルスはハードウェアで除かれ、
+	GPIOの読み出しやピン割り込みには届かない(ソフトウェアで何度も読み直
+	す必要がない)。
+
+	・Iocon_setPin
+		ピンの設定をIOCON_MODE_*, IOCON_HYS_*, IOCON_INV_*, IOCON_OD_*,
+		IOCON_S_MODE_*, IOCON_CLK_DIV*の論理和で指定する。ピンはPIO0_nのn
+		で指定する(IOCONのレジスタの並びはピン番号順ではないので、本ライブ
+		ラリで変換する)。
+	・Iocon_getPin
+		ピンの設定を取得する。
+	・Iocon_setClkDiv
+		入力フィルタのクロック(メインクロック / IOCONCLKDIVn)の分周値を直
+		接設定する。
+	・Iocon_setSampleUs
+		入力フィルタのクロック周期を時間(us)で指定する。分周値は現在のメイ
+		ンクロックから求め、Sys_setClockでクロックを切り替えた時も同じ周期
+		になるよう設定し直す(Sys_addClkNotifyに登録する)。
+
+	使用例) 3us × 3クロック = 9us未満のパルスを除く
+		Iocon_setSampleUs(0, 3);
+		Iocon_setPin(4, IOCON_MODE_PULL_UP | IOCON_HYS_ON
+			| IOCON_S_MODE_3CLOCK | IOCON_CLK_DIV0);
+
+	注意点:
+	・フィルタのクロックは分周値0(リセット値)で止まり、その間はピンの入
+	　力が変化しなくなる。先にIocon_setSampleUsなどで分周値を決めてから
+	　IOCON_S_MODE_*を設定すること。
+	・分周値は最大IOCON_CLKDIV_MAXなので、除けるパルスの長さは、12MHzで
+	　約64us、30MHzで約25usまでである(IOCON_S_MODE_3CLOCKの場合)。ミリ秒
+	　単位のスイッチのチャタリングまでは除けない。
+	・ディープスリープ・パワーダウン中はメインクロックが止まるので、フィ
+	　ルタも止まる。これらのモードからの起床に使うピンでは、入力フィルタ
+	　を使わないこと(IOCON_S_MODE_BYPASS)。
+	・除算を使うので、割り込み処理からは呼び出さないこと。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: 64ビット除算(__aeabi_uldivmod)を使わないようにした
+***************************************************************************/
+#include	"core.h"
+#include	"Iocon_lib.h"
+#include	"Sys_lib.h"		/* for Sys_getMainClk, Sys_addClkNotify, Sys_acqClk */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+
+/*** ピンnのIOCONレジスタ(PIO0_17から始まる並び) ***/
+#define	IOCON_PIO(pin)		((&LPC_IOCON->PIO0_17)[Iocon_idx[pin]])
+
+/*** IOCONCLKDIVn(CMSISの配列はアドレス順なので逆順) ***/
+#define	IOCON_CLKDIV(sel)	(LPC_SYSCON->IOCONCLKDIV[IOCON_CLKDIV_NUM - 1 - (sel)])
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+
+/*** ピン番号→IOCONレジスタの位置(PIO0_17からのワード数) ***/
+static const uint8_t	Iocon_idx[GPIO_PIN_NUM] = {
+	17, 11, 6, 5, 4, 3, 16, 15, 14, 13, 8, 7, 2, 1, 18, 10, 9, 0
+};
+
+static uint32_t	Iocon_sampleUs[IOCON_CLKDIV_NUM];	/* Iocon_setSampleUsの指定(0:未指定) */
+static _Bool	Iocon_notified;						/* Sys_addClkNotifyに登録済み */
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static _Bool	Iocon_updDiv(uint32_t sel);
+static void		Iocon_procClk(void);
+
+/***************************************************************************
+	Iocon_setPin
+	ピンの設定
+
+	[引数]	pin	ピン番号(0～GPIO_PIN_NUM-1)
+			cfg	IOCON_MODE_*, IOCON_HYS_*, IOCON_INV_*, IOCON_OD_*,
+				IOCON_S_MODE_*, IOCON_CLK_DIV*の論理和
+	[戻値]	なし
+
+	IOCON_CFG_MASKのビットだけを書き換え、予約ビットは読んだ値のまま書く。
+	範囲外のピン番号は何もしない。
+***************************************************************************/
+void Iocon_setPin(uint32_t pin, uint32_t cfg)
+{
+	if (pin >= GPIO_PIN_NUM) {
+		return;
+	}
+	(void)Sys_acqClk(SYS_AHB_CLK_IOCON, 0);
+	IOCON_PIO(pin) = (IOCON_PIO(pin) & ~IOCON_CFG_MASK) | (cfg & IOCON_CFG_MASK);
+	Sys_relClk(SYS_AHB_CLK_IOCON);
+}
+
+/***************************************************************************
+	Iocon_getPin
+	ピンの設定の取得
+
+	[引数]	pin	ピン番号(0～GPIO_PIN_NUM-1)
+	[戻値]	設定(IOCON_CFG_MASKのビット)、範囲外のピン番号は0
+***************************************************************************/
+uint32_t Iocon_getPin(uint32_t pin)
+{
+	uint32_t	cfg;
+
+	if (pin >= GPIO_PIN_NUM) {
+		return 0;
+	}
+	(void)Sys_acqClk(SYS_AHB_CLK_IOCON, 0);
+	cfg = IOCON_PIO(pin) & IOCON_CFG_MASK;
+	Sys_relClk(SYS_AHB_CLK_IOCON);
+	return cfg;
+}
+
+/***************************************************************************
+	Iocon_setClkDiv
+	フィルタのクロック分周値の設定
+
+	[引数]	sel	IOCONCLKDIVの番号(0～6、IOCON_CLK_DIVnのn)
+			div	分周値(0:停止、1～IOCON_CLKDIV_MAX)
+	[戻値]	なし
+
+	Iocon_setSampleUsの指定は取り消す(クロック変更時も分周値はそのまま)。
+***************************************************************************/
+void Iocon_setClkDiv(uint32_t sel, uint32_t div)
+{
+	if (sel >= IOCON_CLKDIV_NUM) {
+		return;
+	}
+	Iocon_sampleUs[sel] = 0;
+	IOCON_CLKDIV(sel) = (div > IOCON_CLKDIV_MAX)? IOCON_CLKDIV_MAX: div;
+}
+
+/***************************************************************************
+	Iocon_setSampleUs
+	フィルタのクロック周期の設定
+
+	[引数]	sel	IOCONCLKDIVの番号(0～6、IOCON_CLK_DIVnのn)
+			us	クロック周期(us、1以上)
+	[戻値]	指定通り(true), 分周値が範囲外で最大値にした(false)
+
+	分周値 = us × メインクロック / 1000000(切り上げ)とするので、周期は指
+	定以上になる。クロック変更時は登録したIocon_procClkで求め直す。
+***************************************************************************/
+_Bool Iocon_setSampleUs(uint32_t sel, uint32_t us)
+{
+	if ((sel >= IOCON_CLKDIV_NUM) || (us == 0)) {
+		return false;
+	}
+	Iocon_sampleUs[sel] = us;
+	if (!Iocon_notified) {
+		Iocon_notified = Sys_addClkNotify(Iocon_procClk);
+	}
+	return Iocon_updDiv(sel);
+}
+
+/***************************************************************************
+	Iocon_updDiv
+	指定の周期からの分周値の設定
+
+	[引数]	sel	IOCONCLKDIVの番号
+	[戻値]	範囲内(true), 最大値にした(false)
+***************************************************************************/
+static _Bool Iocon_updDiv(uint32_t sel)
+{
+	uint32_t	khz = Sys_getMainClk() / 1000;
+	uint32_t	us = Iocon_sampleUs[sel];
+	uint32_t	div;
+
+	/* 分周値 = 周期 * メインクロック(切り上げ)、32ビットの除算で求める */
+	/* ※kHz未満の端数は捨てる(メインクロックは最低でも9.375kHzなので誤差1%未満) */
+	div = (us > (UINT32_MAX - 999) / khz)? UINT32_MAX: (us * khz + 999) / 1000;
+	if (div > IOCON_CLKDIV_MAX) {
+		IOCON_CLKDIV(sel) = IOCON_CLKDIV_MAX;
+		return false;
+	}
+	IOCON_CLKDIV(sel) = (div == 0)? 1: div;
+	return true;
+}
+
+/***************************************************************************
+	Iocon_procClk
+	クロック変更時の処理(Sys_addClkNotifyで登録)
+
+	[引数]	なし
+	[戻値]	なし
+***************************************************************************/
+static void Iocon_procClk(void)
+{
+	uint32_t	sel;
+
+	for (sel = 0; sel < IOCON_CLKDIV_NUM; sel++) {
+		if (Iocon_sampleUs[sel] != 0) {
+			(void)Iocon_updDiv(sel);
+		}
+	}
+}
@@ -0,0 +1,110 @@
+/***************************************************************************
+	Mrt_lib.c
+	私家版マルチレートタイマ(MRT)ライブラリ
+
+	使用方法: #include "Mrt_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	MRTの1チャネル(MRT_CH_STAMP)を、システムクロックで数えるフリーランの
+	タイムスタンプとして使うためのライブラリ。
+	SysTickは割り込みの周期に使っているので、処理時間の計測などにはこちら
+	を使う。
+
+	・Mrt_ini
+		MRTを初期化し、MRT_CH_STAMPを最大の時間間隔(MRT_IVALUE_MAX)のリピー
+		トモードで開始する。割り込みは使わない。
+		開始済みなら何もしないので、複数のライブラリ(Prof_lib, Wdt_lib)から
+		呼び出してよい。
+	・Mrt_end
+		タイムスタンプを使い終わったことを知らせる。Mrt_iniを呼び出した全
+		員がMrt_endを呼び出すと、MRTへのクロック供給を止める。
+	・Mrt_getStamp
+		現在のタイムスタンプを取得する。値はシステムクロック数で、2^31で一
+		周する(0～MRT_STAMP_MASK)。
+	・Mrt_getElapsed
+		タイムスタンプからの経過クロック数を取得する。一周を挟んでいても
+		正しく求まるが、2^31クロック(30MHzで約71秒)以上の経過は区別できない。
+
+	注意点:
+	・数えるのはシステムクロックなので、Sys_setClockでクロックを切り替える
+	　と、1クロック当たりの時間が変わる。クロック数は命令の実行サイクル数
+	　としてはそのまま比較できる。
+	・ディープスリープ中はシステムクロックが止まるのでカウントも止まる。
+	　Idle_runをまたいだ経過時間には使えない。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: Mrt_iniを開始済みなら何もしないようにした
+	2026.10.16: mits: クロック供給をSys_acqClkで行うようにし、Mrt_end追加
+***************************************************************************/
+#include	"core.h"
+#include	"Mrt_lib.h"
+#include	"Sys_lib.h"		/* for Sys_acqClk, Sys_relClk */
+
+/***************************************************************************
+	Mrt_ini
+	タイムスタンプの開始
+
+	[引数]	なし
+	[戻値]	なし
+
+	MRTへのクロック供給を要求し、供給を開始した場合はMRTをリセットして
+	から、MRT_CH_STAMPをリピートモードで開始する。
+	既に供給中なら開始済みとして参照数を増やすだけにする(リセットでタイ
+	ムスタンプや他のチャネルを止めないため)。
+***************************************************************************/
+void Mrt_ini(void)
+{
+	if (!Sys_acqClk(SYS_AHB_CLK_MRT, SYS_MRT_RST_N)) {
+		return;		/* 開始済み */
+	}
+	LPC_MRT->Channel[MRT_CH_STAMP].CTRL = MRT_MODE_REPEAT;	/* 割り込みなし */
+	LPC_MRT->Channel[MRT_CH_STAMP].INTVAL = MRT_IVALUE_MAX | MRT_LOAD;
+}
+
+/***************************************************************************
+	Mrt_end
+	タイムスタンプの使用終了
+
+	[引数]	なし
+	[戻値]	なし
+
+	Mrt_iniで要求したMRTへのクロック供給を返す。他に使っているものがな
+	ければクロックが止まり、タイムスタンプも止まる。
+***************************************************************************/
+void Mrt_end(void)
+{
+	Sys_relClk(SYS_AHB_CLK_MRT);
+}
+
+/***************************************************************************
+	Mrt_getStamp
+	タイムスタンプの取得
+	※あらかじめMrt_iniを呼び出しておくこと
+
+	[引数]	なし
+	[戻値]	タイムスタンプ(0～MRT_STAMP_MASK、システムクロック毎に1増える)
+
+	ダウンカウンタ(TIMER)を反転して、増えていく値にしている。
+	レジスタを1回読むだけなので、割り込み処理からも呼び出せる。
+***************************************************************************/
+uint32_t Mrt_getStamp(void)
+{
+	return MRT_IVALUE_MAX - LPC_MRT->Channel[MRT_CH_STAMP].TIMER;
+}
+
+/***************************************************************************
+	Mrt_getElapsed
+	タイムスタンプからの経過クロック数の取得
+	※あらかじめMrt_iniを呼び出しておくこと
+
+	[引数]	stamp	Mrt_getStampで取得したタイムスタンプ
+	[戻値]	経過クロック数(0～MRT_STAMP_MASK)
+
+	周期が2^31なので、差をマスクするだけで一周を挟んだ場合も求まる。
+***************************************************************************/
+uint32_t Mrt_getElapsed(uint32_t stamp)
+{
+	return (Mrt_getStamp() - stamp) & MRT_STAMP_MASK;
+}
@@ -0,0 +1,225 @@
+/***************************************************************************
+	Pint_lib.c
+	私家版ピン割り込みライブラリ
+
+	使用方法: #include "Pint_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	GPIO入力をmain()でポーリングする代わりに、ピン割り込み(PINT)で入力の
+	変化を検出するためのライブラリ。
+	ピン割り込みはディープスリープからの起床要因にもなるので、main()は
+	Idle_runで待機したまま入力に応答できる。ただし、IOCONの入力フィルタ
+	はディープスリープ中に止まるので、起床に使うピンではバイパスしておく
+	こと(IOCON_S_MODE_BYPASS、Iocon_lib参照)。
+
+	・Pint_add
+		ピン番号と検出条件(エッジ/レベル)、検出時に呼び出す関数を登録し、
+		検出を開始する。チャネルは登録順に0から割り当てる。
+	・Pint_start
+		検出を開始(再開)する。
+	・Pint_stop
+		検出を停止する。
+	・PININT0_IRQHandler～PININT7_IRQHandler
+		ピン割り込みハンドラ。登録された関数を呼び出す。
+
+	エッジ検出の場合は、検出したエッジ毎に登録関数を呼び出す。
+	レベル検出の場合は、指定レベルの間は割り込みが発生し続けてしまうため、
+	1回呼び出したら検出を停止する。入力が戻ったことを確認してからPint_start
+	で再開すること。これにより、起動時から既に指定レベルになっている場合
+	も検出できる(エッジ検出では検出できない)。
+
+	ピン割り込みのレジスタはGPIOと同じクロック(SYS_AHB_CLK_GPIO)で動く。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: クロック供給をSys_acqClkで行うようにした
+	2026.10.16: mits: 起床に使うピンの入力フィルタの注意を追加
+***************************************************************************/
+#include	"core.h"
+#include	"Pint_lib.h"
+#include	"Sys_lib.h"		/* for Sys_acqClk */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	PINT_PRI	= PRI_MEDIUM	/* ピン割り込みの優先度 */
+};
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static Pint_func	Pint_funcs[PINT_CH_NUM];	/* 検出時に呼び出す関数 */
+static Pint_mode	Pint_modes[PINT_CH_NUM];	/* 検出条件 */
+static uint32_t		Pint_num;					/* 登録済みチャネル数 */
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static void Pint_procIrq(uint32_t ch);
+
+/***************************************************************************
+	Pint_add
+	ピン割り込みの登録
+
+	[引数]	pin		ピン番号(0:PIO0_0～)
+			mode	検出条件
+			func	検出時に呼び出す関数(割り込み内から呼ばれる)
+	[戻値]	チャネル番号(Pint_start, Pint_stopに渡す)
+			登録できなかった場合はPINT_CH_NONE
+
+	ピンはGPIO入力(DIR0が0)としておくこと。プルアップなどはIOCONの設定
+	のままである。
+	本関数で検出を開始し、ディープスリープからの起床要因(STARTERP0)とし
+	ても登録する。
+***************************************************************************/
+uint32_t Pint_add(uint32_t pin, Pint_mode mode, Pint_func func)
+{
+	uint32_t	ch;
+	uint32_t	bit;
+
+	if ((Pint_num >= PINT_CH_NUM) || (pin > PINT_PIN_MAX) || (func == 0)
+	 || (mode > PINT_LEVEL_LOW)) {
+		return PINT_CH_NONE;
+	}
+	ch = Pint_num++;
+	bit = 0x1UL << ch;
+	Pint_funcs[ch] = func;
+	Pint_modes[ch] = mode;
+
+	(void)Sys_acqClk(SYS_AHB_CLK_GPIO, 0);			/* ピン割り込みへクロック供給(チャネル毎) */
+	LPC_SYSCON->PINTSEL[ch] = pin;					/* チャネルにピンを割り当て */
+
+	LPC_PIN_INT->CIENR = bit;		/* 設定中は検出停止 */
+	LPC_PIN_INT->CIENF = bit;
+	if (mode >= PINT_LEVEL_HIGH) {
+		LPC_PIN_INT->ISEL |= bit;	/* レベル検出 */
+	}
+	else {
+		LPC_PIN_INT->ISEL &= ~bit;	/* エッジ検出 */
+	}
+
+	LPC_SYSCON->STARTERP0 |= SYS_START_PINT0 << ch;	/* ディープスリープからの起床要因 */
+	NVIC_SetPriority((IRQn_Type)(PININT0_IRQn + ch), PINT_PRI);
+	NVIC_EnableIRQ((IRQn_Type)(PININT0_IRQn + ch));
+
+	Pint_start(ch);
+	return ch;
+}
+
+/***************************************************************************
+	Pint_start
+	検出の開始(再開)
+
+	[引数]	ch	Pint_addで得たチャネル番号
+	[戻値]	なし
+
+	エッジ検出の場合は、停止中に検出したエッジを捨ててから開始する。
+	レベル検出の場合は、既に指定レベルであれば直ちに割り込みが発生する。
+***************************************************************************/
+void Pint_start(uint32_t ch)
+{
+	uint32_t	bit = 0x1UL << ch;
+
+	if (ch >= Pint_num) {
+		return;
+	}
+	switch (Pint_modes[ch]) {
+	case PINT_EDGE_RISE:
+	case PINT_EDGE_FALL:
+	case PINT_EDGE_BOTH:
+		LPC_PIN_INT->IST = bit;		/* 停止中のエッジを捨てる */
+		if (Pint_modes[ch] != PINT_EDGE_FALL) {
+			LPC_PIN_INT->SIENR = bit;
+		}
+		if (Pint_modes[ch] != PINT_EDGE_RISE) {
+			LPC_PIN_INT->SIENF = bit;
+		}
+		break;
+	case PINT_LEVEL_HIGH:
+		LPC_PIN_INT->SIENF = bit;	/* Hレベルで検出 */
+		LPC_PIN_INT->SIENR = bit;
+		break;
+	case PINT_LEVEL_LOW:
+		LPC_PIN_INT->CIENF = bit;	/* Lレベルで検出 */
+		LPC_PIN_INT->SIENR = bit;
+		break;
+	default:
+		break;
+	}
+}
+
+/***************************************************************************
+	Pint_stop
+	検出の停止
+
+	[引数]	ch	Pint_addで得たチャネル番号
+	[戻値]	なし
+
+	レベル検出の場合、IENFは検出レベルの指定なのでそのままとする。
+***************************************************************************/
+void Pint_stop(uint32_t ch)
+{
+	uint32_t	bit = 0x1UL << ch;
+
+	if (ch >= Pint_num) {
+		return;
+	}
+	LPC_PIN_INT->CIENR = bit;
+	if (Pint_modes[ch] < PINT_LEVEL_HIGH) {
+		LPC_PIN_INT->CIENF = bit;
+	}
+}
+
+/***************************************************************************
+	Pint_procIrq
+	ピン割り込み時の処理
+
+	[引数]	ch	チャネル番号
+	[戻値]	なし
+
+	エッジ検出では、検出フラグをクリアしてから検出したエッジ毎に登録関数
+	を呼び出す(呼び出し中の次のエッジも取りこぼさない)。
+	レベル検出では、検出を停止してから登録関数を呼び出す。ISTへの1書きは
+	検出レベルの反転になってしまうので行わない。
+***************************************************************************/
+static void Pint_procIrq(uint32_t ch)
+{
+	uint32_t	bit = 0x1UL << ch;
+	uint32_t	rise, fall;
+
+	if (ch >= Pint_num) {
+		return;
+	}
+	if (Pint_modes[ch] >= PINT_LEVEL_HIGH) {
+		LPC_PIN_INT->CIENR = bit;
+		Pint_funcs[ch](ch, (Pint_modes[ch] == PINT_LEVEL_HIGH)? true: false);
+		return;
+	}
+	rise = LPC_PIN_INT->RISE & bit;
+	fall = LPC_PIN_INT->FALL & bit;
+	LPC_PIN_INT->IST = bit;			/* RISE, FALLもクリアされる */
+	if (rise != 0) {
+		Pint_funcs[ch](ch, true);
+	}
+	if (fall != 0) {
+		Pint_funcs[ch](ch, false);
+	}
+}
+
+/***************************************************************************
+	PININT0_IRQHandler～PININT7_IRQHandler
+	ピン割り込みハンドラ
+
+	[引数]	なし
+	[戻値]	なし
+***************************************************************************/
+void PININT0_IRQHandler(void) { Pint_procIrq(0); }
+void PININT1_IRQHandler(void) { Pint_procIrq(1); }
+void PININT2_IRQHandler(void) { Pint_procIrq(2); }
+void PININT3_IRQHandler(void) { Pint_procIrq(3); }
+void PININT4_IRQHandler(void) { Pint_procIrq(4); }
+void PININT5_IRQHandler(void) { Pint_procIrq(5); }
+void PININT6_IRQHandler(void) { Pint_procIrq(6); }
+void PININT7_IRQHandler(void) { Pint_procIrq(7); }
@@ -0,0 +1,254 @@
+/***************************************************************************
+	Prof_lib.c
+	私家版処理時間計測ライブラリ
+
+	使用方法: #include "Prof_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	ソース中の区間をPROF_BEGIN/PROF_ENDで囲み、実行される度にその処理時間
+	(システムクロック数)を計測して、最小・最大・平均を求めるためのライブ
+	ラリ。時間はMrt_libのタイムスタンプで数える。
+
+	・Prof_ini
+		MRTを開始し、PROF_BEGIN/PROF_ENDそのものにかかるクロック数を計測し
+		ておく(以降の計測値から差し引く)。
+	・Prof_add
+		計測区間を名前付きで登録する。
+	・PROF_BEGIN(sec), PROF_END(sec)
+		区間の開始と終了。secはProf_sec型の変数(ポインタではない)。
+		core.hのPROF_ENABLEが0の場合は何もしない(コードも生成されない)。
+	・Prof_getStat
+		登録順の番号で区間の計測結果を取得する。平均を求めるのに除算を使
+		うので、main側やデバッガから呼び出すこと。
+	・Prof_clr
+		全区間の計測結果をクリアする。
+
+	使用例)
+		static Prof_sec	ProfEvt;
+
+		Prof_ini();
+		Prof_add(&ProfEvt, "Evt_run");
+		...
+		PROF_BEGIN(ProfEvt);
+		Evt_run();
+		PROF_END(ProfEvt);
+
+	排他について:
+	PROF_ENDは区間の記録を割り込み禁止にせずに更新するので、1つの区間は
+	main側か、1つの割り込み処理のどちらかだけで使うこと。異なる区間であれ
+	ば、main側と割り込み処理で同時に使ってもよい(入れ子にもできる)。
+	Prof_getStat, Prof_clrは割り込み禁止にして読み書きする。
+	main側の区間の途中で割り込みが入ると、その処理時間も含まれる(最大値
+	が割り込み処理の分だけ大きくなる)。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: 64ビット除算(__aeabi_uldivmod)を使わないようにした
+***************************************************************************/
+#include	"core.h"
+#include	"Prof_lib.h"
+#include	"Mrt_lib.h"		/* for Mrt_* */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	PROF_CAL_NUM	= 4		/* PROF_BEGIN/PROF_ENDのクロック数を計測する回数 */
+};
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static Prof_sec	*Prof_secs[PROF_SEC_MAX];	/* 登録済み区間 */
+static uint32_t	Prof_num;					/* 登録済み区間数 */
+static uint32_t	Prof_ovh;					/* PROF_BEGIN/PROF_ENDのクロック数 */
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static void Prof_clrSec(Prof_sec *sec);
+
+/***************************************************************************
+	Prof_ini
+	計測の準備
+	※Sys_iniLpc810の後に呼び出すこと
+
+	[引数]	なし
+	[戻値]	なし
+
+	MRTを開始し、空の区間を割り込み禁止でPROF_CAL_NUM回計測して、最小値
+	を計測そのもののクロック数(Prof_ovh)とする。
+	PROF_ENABLEが0の場合は何もしない(MRTも動かさない)。
+***************************************************************************/
+void Prof_ini(void)
+{
+	Prof_sec	cal;
+	uint32_t	primask;
+	uint32_t	i;
+
+	if (!PROF_ENABLE) {
+		return;
+	}
+	Mrt_ini();
+
+	Prof_ovh = 0;
+	Prof_clrSec(&cal);
+	primask = __get_PRIMASK();
+	__disable_irq();
+	for (i = 0; i < PROF_CAL_NUM; i++) {
+		PROF_BEGIN(cal);
+		PROF_END(cal);
+	}
+	__set_PRIMASK(primask);
+	Prof_ovh = cal.min;
+}
+
+/***************************************************************************
+	Prof_add
+	区間の登録
+
+	[引数]	sec		区間(静的に確保しておくこと)
+			name	区間名(Prof_getStatで返す、文字列は保持しない)
+	[戻値]	登録できた(true), 登録数の上限を超えた(false)
+
+	登録しなくてもPROF_BEGIN/PROF_ENDで計測はできるが、Prof_getStat,
+	Prof_clrの対象にならない。
+***************************************************************************/
+_Bool Prof_add(Prof_sec *sec, const char *name)
+{
+	if (Prof_num >= PROF_SEC_MAX) {
+		return false;
+	}
+	Prof_clrSec(sec);
+	sec->name = name;
+	Prof_secs[Prof_num++] = sec;
+	return true;
+}
+
+/***************************************************************************
+	Prof_begin
+	区間の開始
+
+	[引数]	sec	区間
+	[戻値]	なし
+
+	直接呼ばずにPROF_BEGINを使うこと。
+***************************************************************************/
+void Prof_begin(Prof_sec *sec)
+{
+	sec->start = Mrt_getStamp();
+}
+
+/***************************************************************************
+	Prof_end
+	区間の終了
+
+	[引数]	sec	区間
+	[戻値]	なし
+
+	直接呼ばずにPROF_ENDを使うこと。
+	開始からの経過クロック数から計測そのもののクロック数を差し引き、最小・
+	最大・合計に加える。除算は使わない。
+***************************************************************************/
+void Prof_end(Prof_sec *sec)
+{
+	uint32_t	cyc = Mrt_getElapsed(sec->start);
+
+	cyc = (cyc > Prof_ovh)? cyc - Prof_ovh: 0;
+	if ((sec->cnt == 0) || (cyc < sec->min)) {
+		sec->min = cyc;
+	}
+	if (cyc > sec->max) {
+		sec->max = cyc;
+	}
+	sec->sum += cyc;
+	sec->cnt++;
+}
+
+/***************************************************************************
+	Prof_getNum
+	登録済みの区間数の取得
+
+	[引数]	なし
+	[戻値]	区間数(Prof_getStatに渡す番号は0～区間数-1)
+***************************************************************************/
+uint32_t Prof_getNum(void)
+{
+	return Prof_num;
+}
+
+/***************************************************************************
+	Prof_getStat
+	計測結果の取得
+
+	[引数]	idx		区間の番号(登録順に0から)
+			stat	計測結果の格納先
+	[戻値]	取得できた(true), 番号が範囲外(false)
+
+	まだ計測していない区間は、回数・最小・最大・平均とも0を返す。
+	平均は除算で求めるので、割り込み処理からは呼び出さないこと。
+	合計が32ビットを超えた場合は、合計と回数を同じビット数だけ右シフトし
+	てから割る(64ビット除算の__aeabi_uldivmodは使わない)。捨てた下位ビ
+	ットの分だけ平均に誤差が出る。
+***************************************************************************/
+_Bool Prof_getStat(uint32_t idx, Prof_stat *stat)
+{
+	const Prof_sec	*sec;
+	uint32_t		primask;
+	uint64_t		sum;
+	uint32_t		cnt;
+
+	if (idx >= Prof_num) {
+		return false;
+	}
+	sec = Prof_secs[idx];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	stat->name = sec->name;
+	stat->cnt = sec->cnt;
+	stat->min = sec->min;
+	stat->max = sec->max;
+	sum = sec->sum;
+	__set_PRIMASK(primask);
+
+	/* 合計が32ビットに収まるまで合計と回数を同じだけ減らし、32ビットで割る */
+	for (cnt = stat->cnt; (sum > UINT32_MAX) && (cnt > 1); cnt >>= 1) {
+		sum >>= 1;
+	}
+	stat->avg = (cnt == 0)? 0: ((sum > UINT32_MAX)? UINT32_MAX: (uint32_t)sum) / cnt;
+	return true;
+}
+
+/***************************************************************************
+	Prof_clr
+	計測結果のクリア
+
+	[引数]	なし
+	[戻値]	なし
+
+	登録済みの全区間の回数・最小・最大・合計をクリアする。
+***************************************************************************/
+void Prof_clr(void)
+{
+	uint32_t	primask;
+	uint32_t	i;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	for (i = 0; i < Prof_num; i++) {
+		Prof_clrSec(Prof_secs[i]);
+	}
+	__set_PRIMASK(primask);
+}
+
+/* 区間の計測結果のクリア(区間名はそのまま) */
+static void Prof_clrSec(Prof_sec *sec)
+{
+	sec->start = 0;
+	sec->cnt = 0;
+	sec->min = 0;
+	sec->max = 0;
+	sec->sum = 0;
+}
@@ -0,0 +1,408 @@
+/***************************************************************************
+	Sct_lib.c
+	私家版SCT(PWM・点滅出力)ライブラリ
+
+	使用方法: #include "Sct_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	ステートコンフィギュラブルタイマ(SCT)で、LEDなどの出力をPWM、または
+	点滅パターンで動かすためのライブラリ。
+	波形はSCTのイベントだけで作るので、設定後はCPUも割り込みも使わない。
+	時間はusで指定し、システムクロックからSCTのクロック数を求める。
+
+	・Sct_ini
+		SCTを32ビットカウンタ1本(システムクロック)で開始し、周期を設定す
+		る。全チャネルはL出力から始める。
+		Sys_addClkNotifyに登録するので、Sys_setClockでクロックを切り替え
+		た時も同じ時間になるよう設定し直す。
+	・Sct_setPeriod
+		周期を変更する。周期は全チャネルで共通である(カウンタが1本のため)。
+	・Sct_setPwm
+		周期の先頭からhighUsの間だけH、残りをLにする。0なら常にL、周期以
+		上なら常にHとする。
+	・Sct_setBlink
+		周期の先頭でHにし、変化点(周期の先頭からの時間、昇順)毎にL/Hを
+		反転する。例えば周期1秒で{ 100000, 200000, 300000 }とすれば、1秒
+		毎に2回点滅する。
+	・Sct_stop
+		SCTを止めて全チャネルをLにし、クロック供給を返す。
+
+	使用例) CTOUT_0(PIO0_0)を250msずつ点滅
+		Swm_assign(SWM_CTOUT_0, 0);		// core.hのSWM_PIN_MAPに書いてもよい
+		Sct_ini(500000);
+		Sct_setPwm(0, 250000);
+
+	資源の割り当て:
+	MATCH0とイベント0を周期(リミット)に使い、全出力をHにする。変化点毎に
+	MATCH1～4とイベント1～4を1組ずつ使うので、変化点は全チャネルの合計で
+	SCT_EDGE_MAXまでである。チャネルnはCTOUT_nに出力する。
+	変化点の時間だけを変える場合(PWMのデューティの変更など)は、MATCHREL
+	に書いて次の周期の先頭で切り替えるので、波形は乱れない。変化点の数が
+	変わる場合や周期・クロックの変更時は、カウンタを止めて設定し直す(そ
+	の周期は途中で打ち切られる)。
+
+	注意点:
+	・ピンの割り当て(スイッチマトリクスのSWM_CTOUT_0～3)は本ライブラリで
+	　は行わないので、core.hのSWM_PIN_MAPに書くか、Swm_assignで割り当てて
+	　おくこと。
+	・遅いクロックに切り替えて、変化点どうしや周期の終わりとがSCTのクロッ
+	　クで区別できなくなったチャネルは、L出力にする。
+	・ディープスリープ・パワーダウン中はシステムクロックが止まるので、出
+	　力も止まる。Idle_runはSCTの使用中(クロック供給中)はスリープで待機
+	　する。
+	・除算を使うので、割り込み処理からは呼び出さないこと。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: 64ビット除算(__aeabi_uldivmod)を使わないようにした
+***************************************************************************/
+#include	"core.h"
+#include	"Sct_lib.h"
+#include	"Sys_lib.h"		/* for Sys_usToTicks, Sys_addClkNotify, Sys_acqClk */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	SCT_CONFIG		= SCT_UNIFY | SCT_CLKMODE_BUS | SCT_AUTOLIMIT_L,	/* 32ビット、MATCH0でリミット */
+	SCT_EV_LIMIT	= 0x1<<0,	/* 周期のイベント(イベント0、MATCH0) */
+	SCT_PERIOD_MIN	= 2,		/* 周期の最小(SCTのクロック数) */
+	SCT_LAYOUT_BITS	= 4,		/* Sct_img.layoutのチャネル当たりのビット数 */
+	SCT_LAYOUT_HIGH	= 0x8		/* Sct_img.layout: 変化点なしでH */
+};
+
+_Static_assert(SCT_EDGE_MAX + 1 <= SCT_EV_NUM && SCT_EDGE_MAX + 1 <= SCT_LAYOUT_HIGH,
+	"SCT_EDGE_MAX exceeds SCT events");
+
+/*** 出力チャネルの設定 ***/
+typedef struct Sct_ch {
+	uint32_t	edgeUs[SCT_EDGE_MAX];	/* 変化点(周期の先頭からの時間、昇順) */
+	uint8_t		num;		/* 変化点の数 */
+	_Bool		high;		/* 変化点が無い場合のレベル */
+} Sct_ch;
+
+/*** レジスタの設定値 ***/
+typedef struct Sct_img {
+	uint32_t	match[SCT_MATCH_NUM];	/* MATCH0(周期-1)、MATCH1～4(変化点-1) */
+	uint32_t	set[SCT_OUT_NUM];		/* OUT[n].SET */
+	uint32_t	clr[SCT_OUT_NUM];		/* OUT[n].CLR */
+	uint32_t	evNum;		/* 使うイベントの数(イベント0～evNum-1) */
+	uint32_t	out;		/* カウンタ0での出力(OUTPUT) */
+	uint32_t	layout;		/* チャネル毎の変化点の数とレベル(SCT_LAYOUT_BITSずつ) */
+} Sct_img;
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static Sct_ch	Sct_chs[SCT_OUT_NUM];	/* 出力チャネルの設定 */
+static Sct_img	Sct_cur;			/* 反映済みのレジスタの設定値 */
+static uint32_t	Sct_periodUs;		/* 周期(us) */
+static _Bool	Sct_running;		/* 動作中(クロック供給中) */
+static _Bool	Sct_notified;		/* クロック変更通知を登録済み */
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static _Bool	Sct_setCh(uint32_t ch, const Sct_ch *c);
+static _Bool	Sct_apply(_Bool full);
+static _Bool	Sct_plan(Sct_img *img);
+static void		Sct_procClk(void);
+
+/***************************************************************************
+	Sct_ini
+	SCTの開始
+
+	[引数]	periodUs	周期(us)
+	[戻値]	開始した(true), 周期が範囲外(false)
+
+	SCTへのクロック供給をSys_acqClkで要求し(Sct_stopまで返さない)、SCTを
+	リセットしてから設定する。既に動作中なら全チャネルをLにして設定し直す。
+	周期は現在のシステムクロックで2クロック以上、2^32クロック以下であるこ
+	と。範囲外の場合はSCTを止める。
+***************************************************************************/
+_Bool Sct_ini(uint32_t periodUs)
+{
+	uint32_t	ch;
+
+	if (!Sct_running) {
+		(void)Sys_acqClk(SYS_AHB_CLK_SCT, SYS_SCT_RST_N);
+		Sct_running = true;
+	}
+	if (!Sct_notified) {
+		Sct_notified = Sys_addClkNotify(Sct_procClk);
+	}
+	LPC_SCT->CONFIG = SCT_CONFIG;
+	for (ch = 0; ch < SCT_OUT_NUM; ch++) {
+		Sct_chs[ch].num = 0;
+		Sct_chs[ch].high = false;
+	}
+	if (!Sct_setPeriod(periodUs)) {
+		Sct_stop();
+		return false;
+	}
+	return true;
+}
+
+/***************************************************************************
+	Sct_setPeriod
+	周期の変更
+
+	[引数]	periodUs	周期(us)
+	[戻値]	変更した(true), 周期が範囲外または停止中(false)
+
+	カウンタを止めて設定し直す。変化点が新しい周期に収まらないチャネルは
+	L出力になる。
+***************************************************************************/
+_Bool Sct_setPeriod(uint32_t periodUs)
+{
+	uint32_t	old = Sct_periodUs;
+
+	if (!Sct_running) {
+		return false;
+	}
+	Sct_periodUs = periodUs;
+	if (!Sct_apply(true)) {
+		Sct_periodUs = old;
+		return false;
+	}
+	return true;
+}
+
+/***************************************************************************
+	Sct_setPwm
+	PWM出力
+
+	[引数]	ch		チャネル番号(0～SCT_OUT_NUM-1、CTOUT_ch)
+			highUs	周期の先頭からHにする時間(us)
+	[戻値]	設定した(true), できなかった(false)
+
+	0なら常にL、周期以上なら常にHとし、変化点は使わない。
+	それ以外は変化点を1つ使う。変化点が足りない場合はfalseを返す。
+***************************************************************************/
+_Bool Sct_setPwm(uint32_t ch, uint32_t highUs)
+{
+	Sct_ch	c;
+
+	c.num = ((highUs == 0) || (highUs >= Sct_periodUs))? 0: 1;
+	c.high = (highUs != 0)? true: false;
+	c.edgeUs[0] = highUs;
+	return Sct_setCh(ch, &c);
+}
+
+/***************************************************************************
+	Sct_setBlink
+	点滅パターンの出力
+
+	[引数]	ch		チャネル番号(0～SCT_OUT_NUM-1、CTOUT_ch)
+			edgeUs	変化点(周期の先頭からの時間(us)、昇順で周期未満)
+			num		変化点の数(0なら常にH)
+	[戻値]	設定した(true), できなかった(false)
+
+	周期の先頭でHにし、変化点毎に反転する。変化点の数が奇数なら、最後の
+	変化点から周期の終わりまではLになる。
+	変化点が昇順でない、周期以上、他のチャネルと合わせてSCT_EDGE_MAXを超
+	える場合はfalseを返す。
+***************************************************************************/
+_Bool Sct_setBlink(uint32_t ch, const uint32_t *edgeUs, uint32_t num)
+{
+	Sct_ch		c;
+	uint32_t	i;
+
+	if (num > SCT_EDGE_MAX) {
+		return false;
+	}
+	for (i = 0; i < num; i++) {
+		if (((i != 0) && (edgeUs[i] <= edgeUs[i - 1])) || (edgeUs[i] >= Sct_periodUs)) {
+			return false;
+		}
+		c.edgeUs[i] = edgeUs[i];
+	}
+	c.num = (uint8_t)num;
+	c.high = true;
+	return Sct_setCh(ch, &c);
+}
+
+/***************************************************************************
+	Sct_stop
+	SCTの停止
+
+	[引数]	なし
+	[戻値]	なし
+
+	カウンタを止めて全出力をLにし、クロック供給を返す。
+***************************************************************************/
+void Sct_stop(void)
+{
+	if (!Sct_running) {
+		return;
+	}
+	LPC_SCT->CTRL_U = SCT_HALT_L;
+	LPC_SCT->OUTPUT = 0;
+	Sys_relClk(SYS_AHB_CLK_SCT);
+	Sct_running = false;
+}
+
+/***************************************************************************
+	Sct_setCh
+	出力チャネルの設定の反映
+
+	[引数]	ch	チャネル番号
+			c	設定
+	[戻値]	反映した(true), できなかった(false)
+***************************************************************************/
+static _Bool Sct_setCh(uint32_t ch, const Sct_ch *c)
+{
+	Sct_ch		old;
+	uint32_t	i, used = c->num;
+
+	if (!Sct_running || (ch >= SCT_OUT_NUM)) {
+		return false;
+	}
+	for (i = 0; i < SCT_OUT_NUM; i++) {
+		used += (i != ch)? Sct_chs[i].num: 0;
+	}
+	if (used > SCT_EDGE_MAX) {
+		return false;
+	}
+	old = Sct_chs[ch];
+	Sct_chs[ch] = *c;
+	if (!Sct_apply(false)) {
+		Sct_chs[ch] = old;
+		return false;
+	}
+	return true;
+}
+
+/***************************************************************************
+	Sct_apply
+	レジスタへの反映
+
+	[引数]	full	カウンタを止めて全レジスタを設定し直す(true)
+	[戻値]	反映した(true), 周期が範囲外(false)
+
+	fullでなくても、周期や変化点の数・レベルが変わった場合は全レジスタを
+	設定し直す。変化点の時間だけが変わった場合は、変わったMATCHRELだけを
+	書く(次の周期の先頭でMATCHに再ロードされる)。
+***************************************************************************/
+static _Bool Sct_apply(_Bool full)
+{
+	Sct_img		img;
+	uint32_t	i;
+
+	if (!Sct_plan(&img)) {
+		return false;
+	}
+	if (full || (img.layout != Sct_cur.layout) || (img.match[0] != Sct_cur.match[0])) {
+		LPC_SCT->CTRL_U = SCT_HALT_L | SCT_CLRCTR_L;	/* 中断してカウンタを0に */
+		for (i = 0; i < SCT_MATCH_NUM; i++) {
+			LPC_SCT->MATCH[i].U = img.match[i];
+			LPC_SCT->MATCHREL[i].U = img.match[i];
+		}
+		for (i = 0; i < SCT_EV_NUM; i++) {
+			LPC_SCT->EVENT[i].STATE = (i < img.evNum)? SCT_EV_STATE0: 0;
+			LPC_SCT->EVENT[i].CTRL = i | SCT_EV_COMB_MATCH;
+		}
+		for (i = 0; i < SCT_OUT_NUM; i++) {
+			LPC_SCT->OUT[i].SET = img.set[i];
+			LPC_SCT->OUT[i].CLR = img.clr[i];
+		}
+		LPC_SCT->OUTPUT = img.out;		/* 中断中のみ書ける */
+		LPC_SCT->CTRL_U = 0;			/* 開始(プリスケーラなし) */
+	}
+	else {
+		for (i = 1; i < img.evNum; i++) {
+			if (img.match[i] != Sct_cur.match[i]) {
+				LPC_SCT->MATCHREL[i].U = img.match[i];
+			}
+		}
+	}
+	Sct_cur = img;
+	return true;
+}
+
+/***************************************************************************
+	Sct_plan
+	レジスタの設定値の作成
+
+	[引数]	img	設定値の格納先
+	[戻値]	作成した(true), 周期が範囲外(false)
+
+	周期の終わり(MATCH0)のイベント0でHにし、変化点のイベントで順にL/Hに
+	する。変化点tクロックはMATCHにt-1を設定する(周期の終わりの1クロック
+	を含めてtクロックの間Hになる)。
+	時間(us)からクロック数への換算はSys_usToTicks(切り捨て)で行い、64ビッ
+	ト除算は使わない。
+***************************************************************************/
+static _Bool Sct_plan(Sct_img *img)
+{
+	uint32_t	period = Sys_usToTicks(Sct_periodUs);
+	uint32_t	tick[SCT_EDGE_MAX];
+	const Sct_ch	*c;
+	uint32_t	ch, i, ev = 1;
+	_Bool		ok;
+
+	if ((period < SCT_PERIOD_MIN) || (period == UINT32_MAX)) {
+		return false;
+	}
+	img->match[0] = period - 1;
+	for (i = 1; i < SCT_MATCH_NUM; i++) {
+		img->match[i] = 0;
+	}
+	img->out = 0;
+	img->layout = 0;
+	for (ch = 0; ch < SCT_OUT_NUM; ch++) {
+		c = &Sct_chs[ch];
+		ok = true;
+		for (i = 0; i < c->num; i++) {
+			tick[i] = Sys_usToTicks(c->edgeUs[i]);
+			ok = ok && (tick[i] > ((i != 0)? tick[i - 1]: 0)) && (tick[i] < period);
+		}
+		if ((c->num == 0) || !ok) {
+			/* 変化点なし(区別できない場合もLにする) */
+			if ((c->num == 0) && c->high) {
+				img->set[ch] = SCT_EV_LIMIT;
+				img->clr[ch] = 0;
+				img->out |= 0x1UL << ch;
+				img->layout |= (uint32_t)SCT_LAYOUT_HIGH << (ch * SCT_LAYOUT_BITS);
+			}
+			else {
+				img->set[ch] = 0;
+				img->clr[ch] = SCT_EV_LIMIT;
+			}
+			continue;
+		}
+		img->set[ch] = SCT_EV_LIMIT;
+		img->clr[ch] = 0;
+		img->out |= 0x1UL << ch;
+		img->layout |= (uint32_t)c->num << (ch * SCT_LAYOUT_BITS);
+		for (i = 0; i < c->num; i++, ev++) {
+			img->match[ev] = tick[i] - 1;
+			if ((i & 0x1) == 0) {
+				img->clr[ch] |= 0x1UL << ev;	/* 奇数番目の変化点でL */
+			}
+			else {
+				img->set[ch] |= 0x1UL << ev;	/* 偶数番目の変化点でH */
+			}
+		}
+	}
+	img->evNum = ev;
+	return true;
+}
+
+/***************************************************************************
+	Sct_procClk
+	クロック変更時の処理(Sys_addClkNotifyで登録)
+
+	[引数]	なし
+	[戻値]	なし
+
+	新しいシステムクロックで設定し直す。周期が範囲外になる場合は、前の設
+	定のまま動かし続ける(時間はクロックの比でずれる)。
+***************************************************************************/
+static void Sct_procClk(void)
+{
+	if (Sct_running) {
+		(void)Sct_apply(true);
+	}
+}
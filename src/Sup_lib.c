@@ -0,0 +1,200 @@
+/***************************************************************************
+	Sup_lib.c
+	私家版WDT監視(スーパーバイザ)ライブラリ
+
+	使用方法: #include "Sup_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	Wdt_clrはどこからでも呼び出せるため、ある処理がハングしてもmain()さえ
+	回っていればWDTはクリアされ続けてしまう。
+	本ライブラリは、Wdt_libの上に監視層を設け、登録された全てのタスク(定常
+	処理や割り込み処理)が、それぞれの期限内に生存報告をした場合に限りWDT
+	をクリアする。
+
+	・Sup_add
+		監視するタスクを期限(ms)付きで登録し、タスク番号を得る。
+	・Sup_setMs
+		登録済みタスクの期限(ms)を変更する。報告の周期が変わった時に使う。
+	・Sup_chk
+		タスクの生存報告を行う。
+		前回のWDTクリアから期限内であれば報告済みとする。期限を過ぎた報告
+		は無視するので、そのタスクは報告無しの扱いとなる。
+	・Sup_feed
+		全タスクが報告済みであればWDTをクリアし、報告状態をリセットする。
+		ガード時間中の場合は何もしない。
+		判定は報告済みビットパターンとの比較1回で済ませている。
+	・Sup_getMissed
+		最後にSup_feedでWDTクリアできなかったときに、報告の無かったタスク
+		をビットパターン(b0:タスク番号0～)で返す。
+		WDT警告割り込み(Wdt_procWarn)内で読めば、WDT満了の原因となった
+		タスクが分かる。
+	・Sup_getRestMs
+		まだ報告の無いタスクのうち、期限が最も近いものまでの残り時間を返
+		す。Idle_runは、この時間までに起床して定常処理に報告させる(WDTク
+		リア期限まで眠ると、期限の短いタスクの報告が間に合わないため)。
+
+	タスクが一つも登録されていない場合、Sup_feedはガード時間外であれば常に
+	WDTをクリアする(従来のWdt_clrと同じ)。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: Sup_getRestMs追加
+	2026.10.16: mits: Sup_setMs追加
+***************************************************************************/
+#include	"core.h"
+#include	"Sup_lib.h"
+#include	"Wdt_lib.h"		/* for Wdt_* */
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static uint32_t	Sup_budget[SUP_TASK_MAX];	/* 各タスクの期限(WDTカウンタ値) */
+static uint32_t	Sup_num;					/* 登録済みタスク数 */
+static uint32_t	Sup_all;					/* 登録済みタスクのビットパターン */
+static volatile uint32_t	Sup_done;		/* 報告済みタスクのビットパターン */
+static volatile uint32_t	Sup_missed;		/* 報告の無かったタスクのビットパターン */
+
+/***************************************************************************
+	Sup_add
+	監視タスクの登録
+	※Wdt_iniの後、監視を始める前(setupなど)に呼び出すこと
+
+	[引数]	ms	期限(ms)、前回のWDTクリアからこの時間内に報告すること
+	[戻値]	タスク番号(Sup_chkに渡す)、登録できなかった場合はSUP_ID_NONE
+
+	期限はWDTカウンタ値に換算して保持する。
+	WWDT_TIM_OUTを超える期限は、WWDT_TIM_OUTとしても意味は同じである。
+***************************************************************************/
+uint32_t Sup_add(uint32_t ms)
+{
+	uint32_t	id;
+
+	if (Sup_num >= SUP_TASK_MAX) {
+		return SUP_ID_NONE;
+	}
+	id = Sup_num++;
+	Sup_budget[id] = Wdt_msToCnt(ms);
+	Sup_all |= 0x1UL << id;
+	return id;
+}
+
+/***************************************************************************
+	Sup_setMs
+	監視タスクの期限の変更
+
+	[引数]	id	Sup_addで得たタスク番号
+			ms	新しい期限(ms)
+	[戻値]	なし
+
+	割り込みなどで報告する周期を変えた時に、期限をそれに合わせる。
+	期限は1ワードの書き込みで変わるので、割り込み禁止にしなくてよい。
+***************************************************************************/
+void Sup_setMs(uint32_t id, uint32_t ms)
+{
+	if (id >= Sup_num) {
+		return;
+	}
+	Sup_budget[id] = Wdt_msToCnt(ms);
+}
+
+/***************************************************************************
+	Sup_chk
+	タスクの生存報告
+
+	[引数]	id	Sup_addで得たタスク番号
+	[戻値]	なし
+
+	前回のWDTクリアからの経過時間(TC－TV)が期限内であれば報告済みとする。
+	割り込み処理と定常処理の双方から呼ばれるため、報告済みビットの更新は
+	割り込み禁止で行う(Cortex-M0+には排他ロード/ストアが無いため)。
+***************************************************************************/
+void Sup_chk(uint32_t id)
+{
+	uint32_t	primask;
+
+	if (id >= Sup_num) {
+		return;
+	}
+	if (LPC_WWDT->TC - LPC_WWDT->TV > Sup_budget[id]) {
+		return;		/* 期限切れ */
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	Sup_done |= 0x1UL << id;
+	__set_PRIMASK(primask);
+}
+
+/***************************************************************************
+	Sup_feed
+	全タスク報告済みの場合のWDTクリア
+
+	[引数]	なし
+	[戻値]	WDTクリアした(true), しなかった(false)
+
+	ガード時間中、または報告の無いタスクがある場合はWDTをクリアしない。
+	報告の無いタスクはSup_missedに記録する。
+***************************************************************************/
+_Bool Sup_feed(void)
+{
+	uint32_t	primask;
+	uint32_t	done;
+
+	if (!Wdt_isFeedable()) {
+		return false;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	done = Sup_done;
+	if (done == Sup_all) {
+		Sup_done = 0;
+		Wdt_clr();
+	}
+	__set_PRIMASK(primask);
+
+	if (done != Sup_all) {
+		Sup_missed = Sup_all & ~done;
+		return false;
+	}
+	Sup_missed = 0;
+	return true;
+}
+
+/***************************************************************************
+	Sup_getMissed
+	報告の無かったタスクの取得
+
+	[引数]	なし
+	[戻値]	報告の無かったタスクのビットパターン(b0:タスク番号0～)
+			最後のSup_feedでWDTクリアできていれば0
+***************************************************************************/
+uint32_t Sup_getMissed(void)
+{
+	return Sup_missed;
+}
+
+/***************************************************************************
+	Sup_getRestMs
+	報告の無いタスクの期限までの残り時間の取得
+
+	[引数]	なし
+	[戻値]	残り時間(ms、切り捨て)、該当するタスクが無ければUINT32_MAX
+
+	前回のWDTクリアからの経過時間(TC－TV)と各タスクの期限を比べ、まだ報告
+	の無いタスクのうち最も期限の近いものまでの時間を返す。
+	既に期限を過ぎたタスクは、報告しても無視されるので含めない。
+***************************************************************************/
+uint32_t Sup_getRestMs(void)
+{
+	uint32_t	pend = Sup_all & ~Sup_done;
+	uint32_t	elapsed = LPC_WWDT->TC - LPC_WWDT->TV;
+	uint32_t	rest = UINT32_MAX;
+	uint32_t	id;
+
+	for (id = 0; pend != 0; id++, pend >>= 1) {
+		if (((pend & 0x1) != 0) && (Sup_budget[id] > elapsed) && (Sup_budget[id] - elapsed < rest)) {
+			rest = Sup_budget[id] - elapsed;
+		}
+	}
+	return (rest == UINT32_MAX)? UINT32_MAX: Wdt_cntToMs(rest);
+}
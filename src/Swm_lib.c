@@ -0,0 +1,248 @@
+/***************************************************************************
+	Swm_lib.c
+	私家版スイッチマトリクス(SWM)ライブラリ
+
+	使用方法: #include "Swm_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	ピンへの機能の割り当てを、core.hのピン配置表(SWM_PIN_MAP)で宣言的に
+	決めるためのライブラリ。
+	表はビルド時に、ピンや機能の重複、LPC810に無いピン、固定機能のピン違
+	いを調べる(SWM_MAP_*、Swm_lib.h参照)。
+	8ピンのLPC810では使えるピンが6本しかないので、動作中に機能を付け替え
+	られるようにもしている(USARTとSCTで同じピンを使い分けるなど)。
+
+	・Swm_ini
+		ピン配置表の通りにPINASSIGN0～8, PINENABLE0を設定する。表に無い機
+		能は割り当てなしにする(リセット直後に有効なRESETなども外れる)。
+		表を1回なめて全レジスタの値を作り、今の値と違うレジスタだけを書く。
+	・Swm_assign
+		動作中に機能をピンに割り当てる。移動可能な機能は、既に他のピンに
+		割り当てていれば付け替える。ピンが他の機能に使われていれば何もし
+		ない(失敗)。
+	・Swm_release
+		機能の割り当てを外す。
+	・Swm_getPin, Swm_getFunc
+		機能を割り当てたピン、ピンに割り当てた機能を取得する。
+
+	注意点:
+	・どの関数もSWMへのクロック供給をSys_acqClkで要求し、終わったら返す
+	　(設定は保持される)。Sys_iniLpc810より前に呼び出してもよい。
+	・1つのピンには1つの機能だけを割り当てる前提とする(入力機能どうしの
+	　共有もしない)。
+	・レジスタの読み書きは割り込み禁止にしていないので、main側だけから呼
+	　び出すこと。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+***************************************************************************/
+#include	"core.h"
+#include	"Swm_lib.h"
+#include	"Sys_lib.h"		/* for Sys_acqClk, Sys_relClk */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+
+/*** ピン配置表のビルド時チェック ***/
+_Static_assert(SWM_MAP_PIN_UNIQUE(SWM_PIN_MAP), "SWM_PIN_MAP assigns a pin twice");
+_Static_assert(SWM_MAP_FUNC_UNIQUE(SWM_PIN_MAP), "SWM_PIN_MAP assigns a function twice");
+_Static_assert(SWM_MAP_PIN_VALID(SWM_PIN_MAP), "SWM_PIN_MAP has a pin not on LPC810 or a misplaced fixed function");
+_Static_assert(SWM_MOVABLE_NUM == SWM_PINASSIGN_NUM * SWM_ASSIGN_PER_REG, "Swm_func does not match PINASSIGN0-8");
+
+/*** PINASSIGNnレジスタ(PINASSIGN0～8は連続している) ***/
+#define	SWM_PINASSIGN(n)	((&LPC_SWM->PINASSIGN0)[n])
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+
+/*** ピン配置表(末尾はSWM_FUNC_NONE) ***/
+static const Swm_pin	Swm_map[] = {
+	SWM_PIN_MAP(SWM_X_ENTRY)
+	{ SWM_FUNC_NONE, SWM_ASSIGN_NONE }
+};
+
+/*** 固定機能(PINENABLE0のビット順) ***/
+static const Swm_func	Swm_fixed[SWM_FIXED_NUM] = {
+	SWM_ACMP_I1, SWM_ACMP_I2, SWM_SWCLK, SWM_SWDIO, SWM_XTALIN,
+	SWM_XTALOUT, SWM_RESET, SWM_CLKIN, SWM_VDDCMP
+};
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static uint32_t	Swm_shift(uint32_t func);
+static Swm_func	Swm_findFunc(uint32_t pin);
+
+/***************************************************************************
+	Swm_ini
+	ピン配置表の反映
+
+	[引数]	なし
+	[戻値]	なし
+
+	SWM_PIN_MAPから、PINASSIGN0～8とPINENABLE0(b0～b8)の値を作り、今の値
+	と違うレジスタだけを書く(リセット直後は、固定機能だけの表ならPINENABLE0
+	の1回だけになる)。PINENABLE0の予約ビットは読んだ値のまま書く。
+***************************************************************************/
+void Swm_ini(void)
+{
+	uint32_t		assign[SWM_PINASSIGN_NUM];
+	uint32_t		dis = SWM_FIXED_MASK;
+	const Swm_pin	*map;
+	uint32_t		i, val;
+
+	for (i = 0; i < SWM_PINASSIGN_NUM; i++) {
+		assign[i] = 0xFFFFFFFF;
+	}
+	for (map = Swm_map; map->func != SWM_FUNC_NONE; map++) {
+		if (SWM_IS_FIXED(map->func)) {
+			dis &= ~(0x1UL << SWM_FIXED_BIT(map->func));
+		}
+		else {
+			assign[map->func / SWM_ASSIGN_PER_REG] &=
+				~((uint32_t)(SWM_ASSIGN_NONE ^ map->pin) << Swm_shift(map->func));
+		}
+	}
+
+	(void)Sys_acqClk(SYS_AHB_CLK_SWM, 0);
+	for (i = 0; i < SWM_PINASSIGN_NUM; i++) {
+		if (SWM_PINASSIGN(i) != assign[i]) {
+			SWM_PINASSIGN(i) = assign[i];
+		}
+	}
+	val = LPC_SWM->PINENABLE0;
+	if ((val & SWM_FIXED_MASK) != dis) {
+		LPC_SWM->PINENABLE0 = (val & ~SWM_FIXED_MASK) | dis;
+	}
+	Sys_relClk(SYS_AHB_CLK_SWM);
+}
+
+/***************************************************************************
+	Swm_assign
+	機能のピンへの割り当て
+
+	[引数]	func	機能
+			pin		ピン番号(0～SWM_PIN_NUM-1)
+	[戻値]	割り当てた(true), できなかった(false)
+
+	ピンがLPC810に無い場合、固定機能を決められたピン以外に指定した場合、
+	ピンが他の機能に使われている場合は何もせずにfalseを返す。
+	移動可能な機能は該当するPINASSIGNの8ビットだけを書き換えるので、他の
+	ピンに割り当て済みなら付け替えになる。
+***************************************************************************/
+_Bool Swm_assign(Swm_func func, uint32_t pin)
+{
+	Swm_func	owner;
+	uint32_t	val;
+
+	if ((pin >= SWM_PIN_NUM) || (SWM_IS_FIXED(func) && (SWM_FIXED_PIN(func) != pin))) {
+		return false;
+	}
+	(void)Sys_acqClk(SYS_AHB_CLK_SWM, 0);
+	owner = Swm_findFunc(pin);
+	if ((owner != SWM_FUNC_NONE) && (owner != func)) {
+		Sys_relClk(SYS_AHB_CLK_SWM);
+		return false;
+	}
+	if (SWM_IS_FIXED(func)) {
+		LPC_SWM->PINENABLE0 &= ~(0x1UL << SWM_FIXED_BIT(func));
+	}
+	else {
+		val = SWM_PINASSIGN(func / SWM_ASSIGN_PER_REG) & ~((uint32_t)SWM_ASSIGN_NONE << Swm_shift(func));
+		SWM_PINASSIGN(func / SWM_ASSIGN_PER_REG) = val | (pin << Swm_shift(func));
+	}
+	Sys_relClk(SYS_AHB_CLK_SWM);
+	return true;
+}
+
+/***************************************************************************
+	Swm_release
+	機能の割り当て解除
+
+	[引数]	func	機能
+	[戻値]	なし
+
+	割り当てていない機能を指定しても何も起きない。
+***************************************************************************/
+void Swm_release(Swm_func func)
+{
+	(void)Sys_acqClk(SYS_AHB_CLK_SWM, 0);
+	if (SWM_IS_FIXED(func)) {
+		LPC_SWM->PINENABLE0 |= 0x1UL << SWM_FIXED_BIT(func);
+	}
+	else {
+		SWM_PINASSIGN(func / SWM_ASSIGN_PER_REG) |= (uint32_t)SWM_ASSIGN_NONE << Swm_shift(func);
+	}
+	Sys_relClk(SYS_AHB_CLK_SWM);
+}
+
+/***************************************************************************
+	Swm_getPin
+	機能を割り当てたピン番号の取得
+
+	[引数]	func	機能
+	[戻値]	ピン番号、割り当てていなければSWM_ASSIGN_NONE
+***************************************************************************/
+uint32_t Swm_getPin(Swm_func func)
+{
+	uint32_t	pin;
+
+	(void)Sys_acqClk(SYS_AHB_CLK_SWM, 0);
+	if (SWM_IS_FIXED(func)) {
+		pin = ((LPC_SWM->PINENABLE0 & (0x1UL << SWM_FIXED_BIT(func))) == 0)?
+			SWM_FIXED_PIN(func): SWM_ASSIGN_NONE;
+	}
+	else {
+		pin = (SWM_PINASSIGN(func / SWM_ASSIGN_PER_REG) >> Swm_shift(func)) & SWM_ASSIGN_NONE;
+	}
+	Sys_relClk(SYS_AHB_CLK_SWM);
+	return pin;
+}
+
+/***************************************************************************
+	Swm_getFunc
+	ピンに割り当てた機能の取得
+
+	[引数]	pin	ピン番号
+	[戻値]	機能、割り当てていなければSWM_FUNC_NONE
+***************************************************************************/
+Swm_func Swm_getFunc(uint32_t pin)
+{
+	Swm_func	func;
+
+	(void)Sys_acqClk(SYS_AHB_CLK_SWM, 0);
+	func = Swm_findFunc(pin);
+	Sys_relClk(SYS_AHB_CLK_SWM);
+	return func;
+}
+
+/* 移動可能な機能のPINASSIGN内のシフト数 */
+static uint32_t Swm_shift(uint32_t func)
+{
+	return (func % SWM_ASSIGN_PER_REG) * SWM_ASSIGN_BITS;
+}
+
+/* ピンに割り当てた機能の検索(SWMにクロック供給中に呼ぶ) */
+static Swm_func Swm_findFunc(uint32_t pin)
+{
+	uint32_t	val, i, n;
+
+	val = LPC_SWM->PINENABLE0;
+	for (i = 0; i < SWM_FIXED_NUM; i++) {
+		if (((val & (0x1UL << i)) == 0) && (SWM_FIXED_PIN(Swm_fixed[i]) == pin)) {
+			return Swm_fixed[i];
+		}
+	}
+	for (i = 0; i < SWM_PINASSIGN_NUM; i++) {
+		val = SWM_PINASSIGN(i);
+		for (n = 0; n < SWM_ASSIGN_PER_REG; n++) {
+			if (((val >> (n * SWM_ASSIGN_BITS)) & SWM_ASSIGN_NONE) == pin) {
+				return (Swm_func)(i * SWM_ASSIGN_PER_REG + n);
+			}
+		}
+	}
+	return SWM_FUNC_NONE;
+}
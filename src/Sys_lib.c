@@ -21,21 +21,199 @@
 		従来はSystemCoreClockを直接見ていたが、情報の隠蔽化を図るため
 		関数化した。
 		なお、従来通りSystemCoreClockを直接見ることも可能である。
+	・Sys_setClock
+		動作中にクロック構成を切り替える。
+		切り替え後、Sys_addClkNotifyで登録された関数を呼び出す。
+	・Sys_getClock
+		現在のクロック構成を取得する。
+	・Sys_addClkNotify
+		クロック変更時に呼び出す関数(SysTickの再設定など)を登録する。
+	・Sys_msToTicks
+		時間(ms)をシステムクロック数(SysTickのtick数)に換算する。
+	・Sys_usToTicks
+		時間(us)をシステムクロック数に換算する。
+	・Sys_delayUs
+		指定時間(us)待つ。現在のシステムクロックで較正される。
+	・Sys_waitReg
+		レジスタが指定値になるのを、指定時間(us)を上限に待つ。
+	・Sys_getBootTim
+		Sys_iniLpc810内の各段階の所要時間の記録を取得する。
+	・Sys_getRstInfo
+		リセット要因と、要因毎のリセット回数を取得する。
+	・(フラッシュのアクセス時間)
+		Sys_iniLpc810, Sys_setClockは、システムクロックに合わせてフラッ
+		シュのアクセス時間(FLASHCFG)を最小にする。クロックを上げる時は切
+		り替え前に長くし、下げる時は切り替え後に短くする。
+	・Sys_acqClk
+		ペリフェラルへのクロック供給(SYSAHBCLKCTRL)を参照数付きで要求す
+		る。最初の要求でクロックを供給し、指定があればリセット(PRESETCTRL)
+		を解除し直す。参照数が上限に達していれば返却漏れとして停止する。
+	・Sys_relClk
+		Sys_acqClkで要求したクロックを返す。参照数が0になったクロックは
+		止める(ダイナミック電流の削減)。
+	・Sys_enterPowerMode
+		スリープ、ディープスリープ、パワーダウン、ディープパワーダウンの
+		いずれかで待機する。停止中・起床時の電源(PDSLEEPCFG, PDAWAKECFG)
+		を設定し、PLLを使っている場合は起床後にクロックを元に戻す。
+	・Sys_getWakeUs
+		各モードからの起床にかかる時間(見積もり)を取得する。
+	・Sys_selPowerMode
+		起床時間が指定時間以内に収まる最も深いモードを選ぶ。
 	・SystemCoreClockUpdate
 		互換性のため残してある。ただし、Sys_iniLpc810内でSystemCoreClock
 		の初期設定も行っているので、本関数は、もはや何もしてない。
 
 	変更履歴
 	2014.06.07: mits: 新規作成
+	2026.10.16: mits: Sys_setClock, Sys_getClock, Sys_addClkNotify追加
+	2026.10.16: mits: 起動時の設定値をビルド時に求めるようにした
+	2026.10.16: mits: Sys_msToTicks追加
+	2026.10.16: mits: Sys_usToTicks, Sys_delayUs, Sys_waitReg追加
+	2026.10.16: mits: 起動時間の記録(Sys_getBootTim)追加
+	2026.10.16: mits: リセット要因の記録(Sys_getRstInfo)追加
+	2026.10.16: mits: 低消費電力モード(Sys_enterPowerMode, Sys_getWakeUs, Sys_selPowerMode)追加
+	2026.10.16: mits: 参照数付きのクロック供給(Sys_acqClk, Sys_relClk)追加
+	2026.10.16: mits: フラッシュのアクセス時間をシステムクロックに合わせるようにした
+	2026.10.16: mits: CLKIN端子の有効化をSwm_assignで行うようにした
+	2026.10.16: mits: Sys_setClockでPLLがロックしない場合にSys_getClockが内蔵オシレータを返すよう修正
+	2026.10.16: mits: Sys_setClockでメインクロックだけが変わった場合も通知関数を呼ぶよう修正
+	2026.10.16: mits: 起床後にPLLがロックしない場合は直ちに内蔵オシレータに切り替えるよう修正
+	2026.10.16: mits: 起動時間の記録をusにした(メインクロックの切り替えをまたいで数えていたため)
+	2026.10.16: mits: Sys_delayUsの割り込みによる延びの説明を修正
+	2026.10.16: mits: Sys_enterPowerModeで除算を使わないようにした(Sys_ircSysHz)
+	2026.10.16: mits: CLKIN端子はメインクロックに使う場合だけ割り当て、使わなくなったら外すよう修正
+	2026.10.16: mits: Sys_acqClkで参照数が上限に達したら止めるようにした(数えずに続けると早く止まっていた)
 ***************************************************************************/
 #include	"core.h"
 #include	"Sys_lib.h"
 #include	"Wdt_lib.h"	/* for Wdt_* */
+#include	"Swm_lib.h"	/* for Swm_assign, Swm_release, Swm_getPin */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	SYS_NOTIFY_MAX	= 4,	/* 登録可能なクロック変更通知関数の数 */
+	PLL_OFFSET		= 1,	/* SYSPLLCTRLでMSEL=0の時の逓倍数 */
+							/* ※UM10601 - 4.6.3 System PLL control register */
+	PLL_RATE_MAX	= 32,	/* PLL逓倍数の上限 */
+	CLK_DIV_MAX		= 255,	/* システムクロック分周値の上限 */
+	CLKIN_WAIT_US	= 20,	/* us; CLKIN端子有効化後の安定待ち時間 */
+							/* ※マニュアルに記載なし(SystemInitの12MHz時200カウント相当) */
+	PLL_LOCK_US		= 1000,	/* us; PLLのフェーズロック待ちの上限時間 */
+	DELAY_LOOP_SFT	= 2,	/* Sys_delayUsの1ループのクロック数(2^n) */
+	POLL_LOOP_SFT	= 3		/* Sys_waitRegの1ループのクロック数(2^n) */
+};
+
+/*** 各低消費電力モードからの起床時間の見積もり(us、Sys_pmodeの順) ***/
+/* ※データシートのwake-up timeを目安に余裕を見た値。PLLのロック待ちは含まない */
+enum {
+	WAKE_SLEEP_US		= 5,	/* スリープ */
+	WAKE_DEEPSLEEP_US	= 15,	/* ディープスリープ(IRCの再起動を含む) */
+	WAKE_POWERDOWN_US	= 100,	/* パワーダウン(フラッシュの電源投入を含む) */
+	WAKE_DPD_US			= 500	/* ディープパワーダウン(リセットからmain()まで) */
+};
+
+/*** クロック供給の参照数(Sys_acqClk, Sys_relClk) ***/
+enum {
+	CLK_REF_NUM	= 20,	/* 参照数を数えるSYSAHBCLKCTRLのビット数(b0～b19) */
+	CLK_REF_MAX	= UINT8_MAX,	/* 参照数の上限(達したらSys_acqClkで停止する) */
+	CLK_FIXED	=		/* 常に供給するクロック(参照数を数えず、止めない) */
+		SYS_AHB_CLK_SYS | SYS_AHB_CLK_ROM | SYS_AHB_CLK_RAM | SYS_AHB_CLK_FLASHREG | SYS_AHB_CLK_FLASH
+};
+
+/*** リセット要因の記録が有効であることを示す値 ***/
+enum {
+	RST_MAGIC	= 0x52535443	/* 'RSTC' */
+};
+
+/*** core.hの指定から求めた起動時のクロック構成 ***/
+enum {
+	BOOT_PLL_HZ		= ((SYS_PLL_CLK & SYS_PLL_CLK_SEL) == SYS_PLL_CLK_CLKIN)? CLKIN_HZ: IRC_HZ,
+	BOOT_MAIN_HZ	=	/* Hz; メインクロック */
+		((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_IRC)?		IRC_HZ:
+		((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLIN)?	BOOT_PLL_HZ:
+		((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLOUT)?	BOOT_PLL_HZ * SYS_PLL_RATE:
+		WDTOSC_FREQ_HZ(WWDT_FREQ) / WWDT_DIV,
+	BOOT_SYS_HZ		= BOOT_MAIN_HZ / SYS_CLK_DIV,	/* Hz; システムクロック */
+	BOOT_PEAK_HZ	=	/* Hz; 切り替え中(分周前)のシステムクロックの最高値 */
+		((uint32_t)BOOT_MAIN_HZ > (uint32_t)IRC_HZ)? BOOT_MAIN_HZ: IRC_HZ,
+	BOOT_TICK_PER_MS	=	/* 1ms当たりのシステムクロック数(RATE_Q固定小数点) */
+		(int)(((uint64_t)BOOT_SYS_HZ << RATE_Q) / 1000),
+	BOOT_TICK_PER_US	=	/* 1us当たりのシステムクロック数(RATE_Q固定小数点) */
+		(int)(((uint64_t)BOOT_SYS_HZ << RATE_Q) / 1000000),
+	IRC_TICK_PER_US		=	/* リセット直後(内蔵オシレータ、分周なし)の同上 */
+		(int)(((uint64_t)IRC_HZ << RATE_Q) / 1000000),
+	US_PER_TICK_SFT		= 24,	/* 起動時間の換算(1クロック当たりのus)の固定小数点のシフト数 */
+	IRC_US_PER_TICK		=	/* 内蔵オシレータの1クロック当たりのus(US_PER_TICK_SFT固定小数点) */
+		(int)((((uint64_t)1000000 << US_PER_TICK_SFT) + IRC_HZ / 2) / IRC_HZ),
+	BOOT_US_PER_TICK	=	/* 起動時のメインクロックの同上 */
+		(int)((((uint64_t)1000000 << US_PER_TICK_SFT) + BOOT_MAIN_HZ / 2) / BOOT_MAIN_HZ),
+	BOOT_USE_IRC	=	/* 内蔵オシレータを使うか否か */
+		((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_IRC)
+	 || (((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) != SYS_MAIN_CLK_WDTOSC)
+	  && ((SYS_PLL_CLK & SYS_PLL_CLK_SEL) == SYS_PLL_CLK_IRC)),
+	BOOT_USE_CLKIN	=	/* CLKIN端子を使うか否か(メインクロックがPLL入力・出力で、PLL入力がCLKIN) */
+		(((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLIN)
+	  || ((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLOUT))
+	 && ((SYS_PLL_CLK & SYS_PLL_CLK_SEL) == SYS_PLL_CLK_CLKIN)
+};
+
+/*** 起動時に書き込むレジスタ値 ***/
+enum {
+	BOOT_SYSPLLCTRL		= SYS_PLL_RATE - PLL_OFFSET,	/* LPC_SYSCON->SYSPLLCTRL */
+	BOOT_SYSPLLCLKSEL	= SYS_PLL_CLK,					/* LPC_SYSCON->SYSPLLCLKSEL */
+	BOOT_MAINCLKSEL		= MAIN_CLK_SEL,					/* LPC_SYSCON->MAINCLKSEL */
+	BOOT_SYSAHBCLKDIV	= SYS_CLK_DIV					/* LPC_SYSCON->SYSAHBCLKDIV */
+};
+
+/*** core.hの指定のチェック(仕様外ならビルドエラー) ***/
+_Static_assert((MAIN_CLK_SEL & ~SYS_MAIN_CLK_SEL) == 0, "MAIN_CLK_SEL is invalid");
+_Static_assert(((SYS_PLL_CLK & ~SYS_PLL_CLK_SEL) == 0)
+	&& (((SYS_PLL_CLK & SYS_PLL_CLK_SEL) == SYS_PLL_CLK_IRC) || ((SYS_PLL_CLK & SYS_PLL_CLK_SEL) == SYS_PLL_CLK_CLKIN)),
+	"SYS_PLL_CLK must be SYS_PLL_CLK_IRC or SYS_PLL_CLK_CLKIN");
+_Static_assert(((uint32_t)SYS_PLL_RATE >= 1) && ((uint32_t)SYS_PLL_RATE <= PLL_RATE_MAX), "SYS_PLL_RATE must be 1-32");
+_Static_assert(((uint32_t)SYS_CLK_DIV >= 1) && ((uint32_t)SYS_CLK_DIV <= CLK_DIV_MAX), "SYS_CLK_DIV must be 1-255");
+_Static_assert(BOOT_MAIN_HZ > 0, "main clock is 0Hz (check WWDT_FREQ)");
+_Static_assert((uint32_t)BOOT_MAIN_HZ <= SYS_CLK_MAX, "main clock exceeds SYS_CLK_MAX");
 
 /***************************************************************************
 	ローカル変数
 ***************************************************************************/
-static uint32_t	Sys_mainClk;	/* メインクロック(Sys_iniLpc810で初期化) */
+static uint32_t			Sys_mainClk;	/* メインクロック(Sys_iniLpc810で初期化) */
+static Sys_clk			Sys_curClk;		/* 現在のクロック構成 */
+static uint32_t			Sys_ircSysHz;	/* 内蔵オシレータに戻した場合のシステムクロック(IRC_HZ / 今の分周値) */
+static Sys_clkNotify	Sys_notify[SYS_NOTIFY_MAX];	/* クロック変更通知関数 */
+static uint32_t			Sys_notifyNum;	/* 登録済みの通知関数の数 */
+static uint32_t			Sys_tickPerMs;	/* 1ms当たりのシステムクロック数(RATE_Q固定小数点) */
+static uint32_t			Sys_tickPerUs;	/* 1us当たりのシステムクロック数(RATE_Q固定小数点) */
+static Sys_bootTim		Sys_boot NOINIT;	/* 起動時間の記録(リセットをまたいで残す) */
+static uint32_t			Sys_stampTick;	/* 起動時間の計測: 前回のSys_stampのSysTick経過クロック数 */
+static uint64_t			Sys_stampUs;	/* 起動時間の計測: 前回までの経過時間(us、US_PER_TICK_SFT固定小数点) */
+static Sys_rstInfo		Sys_rst NOINIT;		/* リセット要因の記録(同上) */
+static uint8_t			Sys_clkRef[CLK_REF_NUM];	/* SYSAHBCLKCTRLのビット毎の参照数 */
+static uint32_t			Sys_rstMagic NOINIT;	/* Sys_rstが有効ならRST_MAGIC */
+static const uint32_t	Sys_wakeUs[SYS_PM_NUM] = {	/* 起床時間の見積もり(Sys_pmodeの順) */
+	WAKE_SLEEP_US, WAKE_DEEPSLEEP_US, WAKE_POWERDOWN_US, WAKE_DPD_US
+};
+static const uint32_t	Sys_pcon[SYS_PM_NUM] = {	/* LPC_PMU->PCONの設定値(Sys_pmodeの順) */
+	PMU_PM_SLEEP, PMU_PM_DEEPSLEEP, PMU_PM_POWERDOWN, PMU_PM_DPD
+};
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static _Bool	Sys_applyClk(const Sys_clk *clk);
+static void		Sys_fallIrc(uint32_t div, uint32_t hz);
+static void		Sys_callNotify(void);
+static void		Sys_updPllClk(uint32_t sel);
+static void		Sys_updMainClk(uint32_t sel);
+static void		Sys_setClkin(_Bool use);
+static void		Sys_setRate(uint32_t hz);
+static void		Sys_setFlashTim(uint32_t hz);
+static uint32_t	Sys_stamp(uint32_t usPerTick);
+static void		Sys_chkRst(void);
+static void		Sys_gateClk(void);
 
 /***************************************************************************
 	コアライブラリオリジナルスタブ
@@ -84,6 +262,31 @@ void SystemCoreClockUpdate(void)
 	　SYS_CLK_DIVに2以上の分周値を設定すると、システムクロックと異なる値に
 	　なる。
 
+	・レジスタへの設定値はすべてビルド時に求め、不正な指定はビルドエラーと
+	　するようにした。
+	　本関数は定数の書き込みと安定待ちのみを行う。
+
+	・CLKINの安定待ちは固定回数のループではなく、時間(CLKIN_WAIT_US)で
+	　指定するようにした。
+	　PLLのロック待ちには上限時間(PLL_LOCK_US)を設け、ロックしない場合は
+	　内蔵オシレータ(分周値はSYS_CLK_DIV)のまま動作を続ける。
+
+	・各段階(Wdt_ini、CLKIN安定待ち、PLL入力切り替え、PLLロック待ち、メイ
+	　ンクロック切り替え)の終了時刻をSysTickで計測し、.noinitセクションの
+	　Sys_bootに記録するようにした。
+	　Sys_getBootTim()、またはデバッガから読める。
+	　計測中のSysTickは割り込み無しで1周(SYSTICK_MAX)フリーランさせ、本関
+	　数の終了時に停止する。
+	　SysTickはメインクロックで数えるので、記録は区間毎にその間のクロック
+	　でusに換算して積み上げる(Sys_stamp)。
+
+	・リセット要因(SYSRSTSTAT)を読んで記録し、要因毎の回数を数えるように
+	　した。記録は.noinitセクションにあり、Sys_getRstInfo()で読める。
+
+	・フラッシュのアクセス時間(FLASHCFG)を、最初に切り替え中の最高速(分周
+	　前のメインクロックとIRCの速い方)に合わせ、分周値の設定後にシステム
+	　クロックに合わせて短くするようにした。20MHz以下なら1クロックになる。
+
 	なお、PLL設定のPost divider(SYSPLLCTRL[PSEL])は設定しても動作しないため、
 	本関数内では処理を行ってない。
 	この件に関しては以下のページで詳しく述べている。
@@ -91,83 +294,85 @@ void SystemCoreClockUpdate(void)
 ***************************************************************************/
 void Sys_iniLpc810(void)
 {
-	enum {
-		PLL_OFFSET	= 1,	/* SYSPLLCTRLでMSEL=0の時の逓倍数 */
-							/* ※UM10601 - 4.6.3 System PLL control register */
-		SYSCON_WAIT	= 200	/* レジスタ設定が安定するまでのWaitカウント値 */
-							/* ※マニュアルに記載なし(SystemInitを参考) */
-	};
-	volatile uint32_t	i;
-	_Bool				pllirc = true;		/* PLLの入力は内蔵オシレータ */
-	uint32_t			pllsrc = IRC_HZ;	/* PLL入力クロック数 */
-	_Bool				irc = true;			/* 内蔵オシレータを使う */
+	/* リセット要因の記録 */
+	Sys_chkRst();
+
+	/* フラッシュのアクセス時間を切り替え中の最高速に合わせる */
+	Sys_setFlashTim(BOOT_PEAK_HZ);
+
+	/* 起動時間の計測用にSysTickをフリーランさせる(割り込み無し) */
+	SysTick->LOAD = SYSTICK_MAX - 1;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+	Sys_stampTick = 0;
+	Sys_stampUs = 0;
 
 	/* 最初にウォッチドッグタイマを初期化し開始する */
 	Wdt_ini();
+	Sys_boot.wdtIni = Sys_stamp(IRC_US_PER_TICK);
 
-	/* 基本ユニット(SWM, IOCON)にクロック供給 */
-	LPC_SYSCON->SYSAHBCLKCTRL |= SYS_AHB_CLK_SWM | SYS_AHB_CLK_IOCON;
+	/* 切り替えまではリセット直後のクロックで時間を測る */
+	Sys_tickPerUs = IRC_TICK_PER_US;
 
-	/* CLKINが選択されていた場合 */
-	if ((SYS_PLL_CLK & SYS_PLL_CLK_SEL) == SYS_PLL_CLK_CLKIN) {
-		LPC_IOCON->PIO0_1 &= ~IOCON_MODE;		/* プルアップ/ダウン抵抗を外す */
-		LPC_SWM->PINENABLE0 &= ~SWM_CLKIN_DIS;	/* CLKIN端子を有効化 */
-		for (i = 0; i < SYSCON_WAIT; i++) {
-			__NOP();
-		}
-		pllsrc = CLKIN_HZ;
-		pllirc = false;		/* PLLの入力は内蔵オシレータでない */
+	/* メインクロックにCLKINを使う場合 */
+	if (BOOT_USE_CLKIN) {
+		Sys_setClkin(true);
 	}
+	Sys_gateClk();		/* リセット直後から供給されていて、参照のないクロックを止める */
+	Sys_boot.clkin = Sys_stamp(IRC_US_PER_TICK);
 
-	LPC_SYSCON->SYSPLLCLKSEL = SYS_PLL_CLK;			/* PLL入力クロックの選択 */
-	LPC_SYSCON->SYSPLLCLKUEN = SYS_PLL_CLK_UPDATE;	/* PLL動作開始 */
-	while ((LPC_SYSCON->SYSPLLCLKUEN & SYS_PLL_CLK_UPDATE) != SYS_PLL_CLK_UPDATE) {
-		;	/* 安定するまで待機 */
+	Sys_updPllClk(BOOT_SYSPLLCLKSEL);	/* PLL入力クロックの選択 */
+	Sys_boot.pllSel = Sys_stamp(IRC_US_PER_TICK);
+
+	Sys_boot.pllOk = true;
+	if ((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLOUT) {
+		LPC_SYSCON->SYSPLLCTRL = BOOT_SYSPLLCTRL;	/* 逓倍数の設定 */
+		LPC_SYSCON->PDRUNCFG &= ~SYS_SYSPLL_PD;		/* PLLに電源供給 */
+		Sys_boot.pllOk = Sys_waitReg(&LPC_SYSCON->SYSPLLSTAT, SYS_PLL_STAT, SYS_PLL_LOCKED, PLL_LOCK_US);
 	}
+	Sys_boot.pllLock = Sys_stamp(IRC_US_PER_TICK);
 
-	switch (MAIN_CLK_SEL & SYS_MAIN_CLK_SEL)
-	{
-	case SYS_MAIN_CLK_IRC:		/* メインクロックに内蔵オシレータを選択 */
+	if (!Sys_boot.pllOk) {
+		/* ロックしない場合は内蔵オシレータのまま動かす */
+		Sys_boot.mainSel = 0;
+		Sys_boot.mainHz = IRC_HZ;
+		SysTick->CTRL = 0;
+		LPC_SYSCON->PDRUNCFG |= SYS_SYSPLL_PD;
+		LPC_SYSCON->SYSAHBCLKDIV = BOOT_SYSAHBCLKDIV;
 		Sys_mainClk = IRC_HZ;
-		break;
-	case SYS_MAIN_CLK_PLLIN:	/* メインクロックにPLL入力クロックを選択 */
-		Sys_mainClk = pllsrc;
-		if (!pllirc) {
-			irc = false;
-		}
-		break;
-	case SYS_MAIN_CLK_PLLOUT:	/* メインクロックにPLL出力クロックを選択 */
-		LPC_SYSCON->SYSPLLCTRL = SYS_PLL_RATE - PLL_OFFSET;	/* 逓倍数の設定 */
-		LPC_SYSCON->PDRUNCFG &= ~SYS_SYSPLL_PD;				/* PLLに電源供給 */
-		while ((LPC_SYSCON->SYSPLLSTAT & SYS_PLL_STAT) != SYS_PLL_LOCKED) {
-			;	/* 安定するまで待機 */
-		}
-		Sys_mainClk = pllsrc * SYS_PLL_RATE;
-		if (!pllirc) {
-			irc = false;
-		}
-		break;
-	case SYS_MAIN_CLK_WDTOSC:	/* メインクロックにWDT用オシレータを選択 */
-		Sys_mainClk = Wdt_getOscClk();
-		irc = false;
-		break;
-	default:
-		break;
+		SystemCoreClock = IRC_HZ / SYS_CLK_DIV;
+		Sys_ircSysHz = IRC_HZ / SYS_CLK_DIV;
+		Sys_setFlashTim(SystemCoreClock);
+		Sys_setRate(SystemCoreClock);
+		Sys_curClk.mainSel = SYS_MAIN_CLK_IRC;
+		Sys_curClk.pllSel = SYS_PLL_CLK;
+		Sys_curClk.pllRate = SYS_PLL_RATE;
+		Sys_curClk.div = SYS_CLK_DIV;
+		return;
 	}
 
-	LPC_SYSCON->MAINCLKSEL = MAIN_CLK_SEL;			/* メインクロックの選択 */
-	LPC_SYSCON->MAINCLKUEN = SYS_MAIN_CLK_UPDATE;	/* メインクロック更新開始 */
-	while ((LPC_SYSCON->MAINCLKUEN & SYS_MAIN_CLK_UPDATE) != SYS_MAIN_CLK_UPDATE) {
-		;	/* 安定するまで待機 */
-	}
+	Sys_updMainClk(BOOT_MAINCLKSEL);	/* メインクロックの選択 */
+	Sys_boot.mainSel = Sys_stamp(BOOT_US_PER_TICK);	/* 切り替え前後の数クロックだけなので切り替え後で換算 */
+	Sys_boot.mainHz = BOOT_MAIN_HZ;
+	SysTick->CTRL = 0;					/* 計測終了 */
 
-	if (IRC_PDWON && !irc) {	/* 内蔵オシレータを使わない場合は電源オフ */
+	if (IRC_PDWON && !BOOT_USE_IRC) {	/* 内蔵オシレータを使わない場合は電源オフ */
 		LPC_SYSCON->PDRUNCFG |= SYS_IRCOUT_PD | SYS_IRC_PD;
 	}
 
 	/* システムクロック分周値の設定 */
-	LPC_SYSCON->SYSAHBCLKDIV = SYS_CLK_DIV;
-	SystemCoreClock = Sys_mainClk / SYS_CLK_DIV;
+	LPC_SYSCON->SYSAHBCLKDIV = BOOT_SYSAHBCLKDIV;
+	Sys_setFlashTim(BOOT_SYS_HZ);		/* 分周後のクロックに合わせて短くする */
+	Sys_mainClk = BOOT_MAIN_HZ;
+	SystemCoreClock = BOOT_SYS_HZ;
+	Sys_ircSysHz = IRC_HZ / SYS_CLK_DIV;
+	Sys_tickPerMs = BOOT_TICK_PER_MS;
+	Sys_tickPerUs = BOOT_TICK_PER_US;
+
+	Sys_curClk.mainSel = MAIN_CLK_SEL;
+	Sys_curClk.pllSel = SYS_PLL_CLK;
+	Sys_curClk.pllRate = SYS_PLL_RATE;
+	Sys_curClk.div = SYS_CLK_DIV;
 }
 
 /***************************************************************************
@@ -195,3 +400,811 @@ uint32_t Sys_getSysClk(void)
 {
 	return SystemCoreClock;
 }
+
+/***************************************************************************
+	Sys_setClock
+	動作中のクロック構成の切り替え
+	※あらかじめSys_iniLpc810を呼び出しておくこと。
+
+	[引数]	clk	切り替え先のクロック構成
+	[戻値]	切り替えた(true), 切り替えられなかった(false)
+
+	内蔵オシレータ、PLL出力、WDT用オシレータなどの間でメインクロックを切り
+	替え、システムクロック分周値(SYSAHBCLKDIV)も変更する。
+	各メンバの意味はcore.h内のMAIN_CLK_SEL, SYS_PLL_CLK, SYS_PLL_RATE,
+	SYS_CLK_DIVと同じである。
+
+	切り替え後はSys_getMainClk(), Sys_getSysClk(), SystemCoreClockが新しい
+	値を示し、Sys_addClkNotifyで登録された関数を登録順に呼び出す。
+	SysTickの周期やUSARTの伝送速度など、クロックに依存する設定は通知関数内で
+	やり直すこと。
+	なお、WDTはWDT用オシレータで動作しているため、メインクロックを切り替え
+	てもタイムアウト時間は変わらない。
+
+	フラッシュのアクセス時間は、切り替え前に切り替え中の最高速に合わせて
+	長くし、切り替え後のシステムクロックに合わせて短くする。
+
+	不正な構成の場合は何もせずにfalseを返す。
+	PLLがPLL_LOCK_US以内にロックしなかった場合は、内蔵オシレータ(分周値は
+	指定通り)に切り替えてfalseを返す。この場合もクロックは変わるので、通知
+	関数は呼び出される(システムクロックが同じでも、メインクロックが変われ
+	ば呼び出す)。現在の構成はSys_getClockで確認できる。
+
+	割り込み禁止にはしてないので、割り込み処理中から呼び出さないこと。
+***************************************************************************/
+_Bool Sys_setClock(const Sys_clk *clk)
+{
+	uint32_t	old = SystemCoreClock;
+	uint32_t	oldMain = Sys_mainClk;
+	_Bool		ret;
+
+	ret = Sys_applyClk(clk);
+	if (ret || (SystemCoreClock != old) || (Sys_mainClk != oldMain)) {
+		Sys_callNotify();
+	}
+	return ret;
+}
+
+/***************************************************************************
+	Sys_getClock
+	現在のクロック構成の取得
+	※あらかじめSys_iniLpc810を呼び出しておくこと。
+
+	[引数]	clk	クロック構成の格納先
+	[戻値]	なし
+
+	Sys_setClockで一時的に切り替えた後、元に戻す場合などに使用する。
+***************************************************************************/
+void Sys_getClock(Sys_clk *clk)
+{
+	*clk = Sys_curClk;
+}
+
+/***************************************************************************
+	Sys_addClkNotify
+	クロック変更通知関数の登録
+
+	[引数]	func	クロック変更時に呼び出す関数
+	[戻値]	登録できた(true), 登録数の上限を超えた(false)
+
+	登録した関数はSys_setClockでクロックを切り替えた直後に呼び出される。
+	関数内ではSys_getSysClk()などで新しいクロック値を取得できる。
+	登録できる数はSYS_NOTIFY_MAXまでである。
+***************************************************************************/
+_Bool Sys_addClkNotify(Sys_clkNotify func)
+{
+	if (Sys_notifyNum >= SYS_NOTIFY_MAX) {
+		return false;
+	}
+	Sys_notify[Sys_notifyNum++] = func;
+	return true;
+}
+
+/***************************************************************************
+	Sys_msToTicks
+	時間(ms)からシステムクロック数への換算
+
+	[引数]	ms	時間(ms)
+	[戻値]	システムクロック数(32ビットを超える場合は0xFFFFFFFF)
+
+	SysTickのtick数などを求めるのに使う。
+	クロック変更時にあらかじめ求めておいた1ms当たりのクロック数を掛けるだけ
+	なので、64ビット除算(__aeabi_uldivmod)は使わない。
+	64ビットの乗算(__aeabi_lmul)とシフトのみで済む。
+***************************************************************************/
+uint32_t Sys_msToTicks(uint32_t ms)
+{
+	uint64_t ticks = ((uint64_t)ms * Sys_tickPerMs) >> RATE_Q;
+
+	return (ticks > UINT32_MAX)? UINT32_MAX: (uint32_t)ticks;
+}
+
+/***************************************************************************
+	Sys_usToTicks
+	時間(us)からシステムクロック数への換算
+
+	[引数]	us	時間(us)
+	[戻値]	システムクロック数(32ビットを超える場合は0xFFFFFFFF)
+
+	Sys_msToTicksのus版である。
+***************************************************************************/
+uint32_t Sys_usToTicks(uint32_t us)
+{
+	uint64_t ticks = ((uint64_t)us * Sys_tickPerUs) >> RATE_Q;
+
+	return (ticks > UINT32_MAX)? UINT32_MAX: (uint32_t)ticks;
+}
+
+/***************************************************************************
+	Sys_delayUs
+	指定時間の待機
+
+	[引数]	us	待機時間(us)
+	[戻値]	なし
+
+	現在のシステムクロックから求めたクロック数だけ待つ。
+	クロックを切り替えても待ち時間は変わらない。
+
+	SysTickが動作中の場合は、そのカウンタ(VAL)の進みで時間を測る。
+	割り込みが入っても、その処理時間がカウンタ1周(LOAD＋1クロック)未満な
+	ら待ち時間は延びない。1周以上かかると、VALを読む間隔が1周を超えて周
+	回を数え損ねるので、その分だけ延びる(短くなることはない)。COUNTFLAG
+	でも周回は1回分しか分からないので、これは防げない。
+	SysTickの周期はmsの単位なので、通常の割り込み処理では問題にならない。
+	停止中の場合は、1ループ2^DELAY_LOOP_SFTクロックとしてループ回数で待つ。
+	割り込みやフラッシュのウェイトが入るとその分だけ延びるので、指定時間は
+	最短の待ち時間となる。
+***************************************************************************/
+void Sys_delayUs(uint32_t us)
+{
+	uint32_t	ticks = Sys_usToTicks(us);
+	uint32_t	prev, now, load, elapsed;
+
+	if ((SysTick->CTRL & SysTick_CTRL_ENABLE_Msk) != 0) {
+		load = SysTick->LOAD + 1;	/* カウンタ1周のクロック数 */
+		prev = SysTick->VAL;
+		while (ticks > 0) {
+			now = SysTick->VAL;
+			elapsed = (prev >= now)? (prev - now): (prev + load - now);	/* ダウンカウンタ */
+			if (elapsed >= ticks) {
+				break;
+			}
+			ticks -= elapsed;
+			prev = now;
+		}
+	}
+	else {
+		for (ticks >>= DELAY_LOOP_SFT; ticks > 0; ticks--) {
+			__NOP();
+		}
+	}
+}
+
+/***************************************************************************
+	Sys_waitReg
+	レジスタが指定値になるまでの待機(タイムアウト付き)
+
+	[引数]	reg		待機するレジスタ
+			mask	比較するビット
+			val		待機する値(maskしたもの)
+			us		待機する上限時間(us)
+	[戻値]	指定値になった(true), タイムアウトした(false)
+
+	(*reg & mask) == valとなるまで待つ。
+	PLLのロック待ちなど、ハードウェアの状態変化をビジーウェイトで待つ場合に
+	使う。上限時間を超えたらfalseを返すので、呼び出し側で対処すること。
+	上限時間は1ループ2^POLL_LOOP_SFTクロックとしたループ回数で測る。
+***************************************************************************/
+_Bool Sys_waitReg(const volatile uint32_t *reg, uint32_t mask, uint32_t val, uint32_t us)
+{
+	uint32_t	cnt = (Sys_usToTicks(us) >> POLL_LOOP_SFT) + 1;
+
+	for (; cnt > 0; cnt--) {
+		if ((*reg & mask) == val) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/***************************************************************************
+	Sys_getBootTim
+	起動時間の記録の取得
+	※あらかじめSys_iniLpc810を呼び出しておくこと。
+
+	[引数]	なし
+	[戻値]	起動時間の記録
+
+	Sys_iniLpc810内の各段階の終了時刻(開始からの時間(us))を返す。
+	記録は.noinitセクションにあるので、デバッガからはSys_bootで読める。
+	差を取れば各段階の所要時間となる。PLLのロックが遅い基板の検出や、起動
+	時間の目標設定に使う。
+***************************************************************************/
+const Sys_bootTim *Sys_getBootTim(void)
+{
+	return &Sys_boot;
+}
+
+/***************************************************************************
+	Sys_getRstInfo
+	リセット要因の記録の取得
+	※あらかじめSys_iniLpc810を呼び出しておくこと。
+
+	[引数]	なし
+	[戻値]	リセット要因の記録
+
+	causeは今回のリセット要因(SYS_RST_*の組み合わせ)である。
+	cntは要因毎の累計回数で、RAMの内容が失われるまで(通常は電源を切るまで)
+	数え続ける。WDTによるリセットが繰り返されていないかの確認に使う。
+	WDTによるリセットの場合は、Wdt_getCrashで止まっていた箇所が分かる。
+***************************************************************************/
+const Sys_rstInfo *Sys_getRstInfo(void)
+{
+	return &Sys_rst;
+}
+
+/***************************************************************************
+	Sys_acqClk
+	ペリフェラルへのクロック供給の要求
+
+	[引数]	clk		供給するクロック(SYS_AHB_CLK_*の組み合わせ)
+			rst		供給を開始した時にリセットし直すペリフェラル
+					(SYS_*_RST_Nの組み合わせ、不要なら0)
+	[戻値]	供給を開始した(true), 既に供給中だった(false)
+
+	clkのビット毎に参照数を1増やし、0から増えたビットがあれば、クロック
+	を供給してrstのリセットを解除し直す。管理外の操作で止められていたビ
+	ットも供給を開始したものとして扱う。
+	SYS_AHB_CLK_SYS～SYS_AHB_CLK_FLASHは常に供給するので数えない。
+	割り込み禁止で更新するので、割り込み処理からも呼び出せる。
+	参照数がCLK_REF_MAXに達していたら、Sys_relClkの呼び忘れなので、BKPT
+	命令で停止する(数えずに続けると、返却した時に他の利用者の分までクロッ
+	クを止めてしまう)。デバッガが無ければHardFaultとなり、WDTでリセット
+	される。
+***************************************************************************/
+_Bool Sys_acqClk(uint32_t clk, uint32_t rst)
+{
+	uint32_t	primask;
+	uint32_t	ctrl;
+	uint32_t	bit;
+	uint32_t	i;
+	_Bool		start = false;
+
+	clk &= ~CLK_FIXED;
+	primask = __get_PRIMASK();
+	__disable_irq();
+	ctrl = LPC_SYSCON->SYSAHBCLKCTRL;
+	for (i = 0, bit = 0x1; i < CLK_REF_NUM; i++, bit <<= 1) {
+		if ((clk & bit) == 0) {
+			continue;
+		}
+		if (Sys_clkRef[i] >= CLK_REF_MAX) {
+			__BKPT(0);		/* 参照数の上限(Sys_relClkの呼び忘れ) */
+			continue;
+		}
+		if ((Sys_clkRef[i] == 0) || ((ctrl & bit) == 0)) {
+			start = true;
+		}
+		Sys_clkRef[i]++;
+	}
+	if (start) {
+		LPC_SYSCON->SYSAHBCLKCTRL = ctrl | clk;		/* クロック供給 */
+		if (rst != 0) {
+			LPC_SYSCON->PRESETCTRL &= ~rst;			/* リセット～ */
+			LPC_SYSCON->PRESETCTRL |= rst;			/* リセット解除 */
+		}
+	}
+	__set_PRIMASK(primask);
+	return start;
+}
+
+/***************************************************************************
+	Sys_relClk
+	ペリフェラルへのクロック供給の返却
+
+	[引数]	clk		返すクロック(Sys_acqClkで要求したもの)
+	[戻値]	なし
+
+	clkのビット毎に参照数を1減らし、0になったビットのクロックを止める。
+	参照数が既に0のビットは何もしない(要求していないクロックは止めない)。
+	ペリフェラルのレジスタの内容は、クロックを止めても保持される。
+***************************************************************************/
+void Sys_relClk(uint32_t clk)
+{
+	uint32_t	primask;
+	uint32_t	gate = 0;
+	uint32_t	bit;
+	uint32_t	i;
+
+	clk &= ~CLK_FIXED;
+	primask = __get_PRIMASK();
+	__disable_irq();
+	for (i = 0, bit = 0x1; i < CLK_REF_NUM; i++, bit <<= 1) {
+		if (((clk & bit) != 0) && (Sys_clkRef[i] != 0) && (--Sys_clkRef[i] == 0)) {
+			gate |= bit;
+		}
+	}
+	if (gate != 0) {
+		LPC_SYSCON->SYSAHBCLKCTRL &= ~gate;		/* クロック停止 */
+	}
+	__set_PRIMASK(primask);
+}
+
+/***************************************************************************
+	Sys_enterPowerMode
+	低消費電力モードでの待機
+	※あらかじめSys_iniLpc810を呼び出しておくこと。
+
+	[引数]	mode	低消費電力モード(SYS_PM_*)
+	[戻値]	待機して起床した(true), 不正なモード、ディープパワーダウンに
+			入れなかった、または起床後にPLLがロックしなかった(false)
+
+	WFIで待機し、起床要因(割り込み)が来たら戻る。
+	ディープスリープ以上では、起床要因はSTARTERP0/1で許可したものに限ら
+	れる(WKT, ピン割り込み, WDTなど)。SysTickは止まる。
+
+	ディープスリープ・パワーダウンでは以下を行う。
+	・停止中の電源(PDSLEEPCFG): BODは動作中ならそのまま動かす。WDT用オシ
+	　レータは、WDTが動作中(WWDT_WDEN)かメインクロックに使っている場合は
+	　動かし続け、それ以外は止める。その他(IRC, フラッシュ, PLLなど)は止
+	　める。
+	・起床時の電源(PDAWAKECFG): 待機前の電源状態(PDRUNCFG)に戻す。
+	・PLL出力をメインクロックにしている場合は、待機前にPLL入力クロックに
+	　切り替え、起床後にPLLのロック(PLL_LOCK_USまで)を待って戻す。
+	　ロックしなかった場合はSys_setClockと同様に内蔵オシレータ(分周値は
+	　そのまま)に切り替え(PLLは止め、待ち直さない。通知関数も呼ばれる)、
+	　falseを返す。
+
+	ディープパワーダウンでは、起床はリセット(WAKEUP端子、またはWKT)となる
+	ので本関数からは戻らない。WDTも止まる。WKTで起床できるよう、低消費電
+	力オシレータを使っていればディープパワーダウン中も動かす。
+	割り込みが保留中などで入れなかった場合は、falseを返す。
+
+	待機前の確認と本関数の呼び出しは割り込み禁止で行うこと(Idle_run参照)。
+	各モードからの起床時間はSys_getWakeUsで確認できる。
+	※UM10601 - 5.7 Power management
+***************************************************************************/
+_Bool Sys_enterPowerMode(Sys_pmode mode)
+{
+	uint32_t	pd = LPC_SYSCON->PDRUNCFG;
+	_Bool		pll = (Sys_curClk.mainSel == SYS_MAIN_CLK_PLLOUT)? true: false;
+	uint32_t	hz;
+
+	if ((uint32_t)mode >= SYS_PM_NUM) {
+		return false;
+	}
+	if (mode == SYS_PM_SLEEP) {
+		LPC_PMU->PCON = PMU_PM_SLEEP;
+		SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+		__WFI();
+		return true;
+	}
+
+	/* 停止中・起床時の電源 */
+	if (((LPC_WWDT->MOD & WWDT_WDEN) == 0) && (Sys_curClk.mainSel != SYS_MAIN_CLK_WDTOSC)) {
+		pd |= SYS_WDTOSC_PD;
+	}
+	LPC_SYSCON->PDSLEEPCFG = SYS_PDSLEEP_RSV | (pd & (SYS_BOD_PD | SYS_WDTOSC_PD));
+	LPC_SYSCON->PDAWAKECFG = LPC_SYSCON->PDRUNCFG;
+
+	if (pll) {
+		Sys_updMainClk(SYS_MAIN_CLK_PLLIN);		/* 停止中はPLLの電源が落ちる */
+	}
+	if ((mode == SYS_PM_DPD) && ((LPC_PMU->DPDCTRL & PMU_LPOSCEN) != 0)) {
+		LPC_PMU->DPDCTRL |= PMU_LPOSCDPDEN;		/* WKTで起床できるように */
+	}
+
+	LPC_PMU->PCON = Sys_pcon[mode];
+	SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+	__WFI();
+	SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+	LPC_PMU->PCON = PMU_PM_SLEEP | PMU_SLEEPFLAG;	/* スリープフラグをクリア */
+
+	/* PDAWAKECFGでPLLの電源は戻っているので、ロックを待って切り替える */
+	if (pll) {
+		if (!Sys_waitReg(&LPC_SYSCON->SYSPLLSTAT, SYS_PLL_STAT, SYS_PLL_LOCKED, PLL_LOCK_US)) {
+			/* ロックしなければ内蔵オシレータ(フラッシュは今のシステムクロック用) */
+			hz = Sys_ircSysHz;		/* 起床待ちで除算を使わないよう、切り替え時に求めたもの */
+			if (hz > SystemCoreClock) {
+				Sys_setFlashTim(hz);
+			}
+			Sys_fallIrc(Sys_curClk.div, hz);
+			Sys_callNotify();
+			return false;
+		}
+		Sys_updMainClk(SYS_MAIN_CLK_PLLOUT);
+	}
+	return (mode != SYS_PM_DPD)? true: false;
+}
+
+/***************************************************************************
+	Sys_getWakeUs
+	低消費電力モードからの起床時間の取得
+	※あらかじめSys_iniLpc810を呼び出しておくこと。
+
+	[引数]	mode	低消費電力モード(SYS_PM_*)
+	[戻値]	起床要因の発生から処理を再開するまでの時間(us)の見積もり
+			不正なモードはUINT32_MAX
+
+	モード毎の見積もり(WAKE_*_US)に、現在のクロック構成での追加分を加える。
+	・ディープスリープ・パワーダウン: PLL出力をメインクロックにしていれば
+	　PLLのロック待ちの上限(PLL_LOCK_US)
+	・ディープパワーダウン: 起動時のクロック構成(MAIN_CLK_SEL)がPLL出力
+	　ならPLL_LOCK_US(Sys_iniLpc810でロックを待つため)
+	応答時間の要求から待機するモードを選ぶのに使う(Sys_selPowerMode)。
+***************************************************************************/
+uint32_t Sys_getWakeUs(Sys_pmode mode)
+{
+	_Bool	pll;
+
+	if ((uint32_t)mode >= SYS_PM_NUM) {
+		return UINT32_MAX;
+	}
+	switch (mode) {
+	case SYS_PM_DEEPSLEEP:
+	case SYS_PM_POWERDOWN:
+		pll = (Sys_curClk.mainSel == SYS_MAIN_CLK_PLLOUT)? true: false;
+		break;
+	case SYS_PM_DPD:
+		pll = ((MAIN_CLK_SEL & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_PLLOUT)? true: false;
+		break;
+	default:
+		pll = false;
+		break;
+	}
+	return Sys_wakeUs[mode] + (pll? PLL_LOCK_US: 0);
+}
+
+/***************************************************************************
+	Sys_selPowerMode
+	応答時間に収まる低消費電力モードの選択
+	※あらかじめSys_iniLpc810を呼び出しておくこと。
+
+	[引数]	us	起床要因から処理を再開するまでに許される時間(us)
+	[戻値]	起床時間(Sys_getWakeUs)がus以内で最も深いモード
+			どれも収まらない場合はSYS_PM_SLEEP
+
+	本関数から戻らないディープパワーダウンは選ばない。
+	SysTickやUSARTを使っている(ディープスリープで止まると困る)かどうかは
+	判断しないので、呼び出し側で確認すること。
+***************************************************************************/
+Sys_pmode Sys_selPowerMode(uint32_t us)
+{
+	Sys_pmode	mode;
+
+	for (mode = SYS_PM_POWERDOWN; mode > SYS_PM_SLEEP; mode--) {
+		if (Sys_getWakeUs(mode) <= us) {
+			break;
+		}
+	}
+	return mode;
+}
+
+/***************************************************************************
+	Sys_chkRst
+	リセット要因の記録
+
+	[引数]	なし
+	[戻値]	なし
+
+	SYSRSTSTATを読んで記録し、該当要因の回数を数えてからクリアする。
+	.noinitセクションの内容は電源投入直後は不定なので、RST_MAGICが無ければ
+	回数をクリアしてから数える。
+	※UM10601 - 4.6.10 System reset status register
+***************************************************************************/
+static void Sys_chkRst(void)
+{
+	uint32_t	cause = LPC_SYSCON->SYSRSTSTAT;
+	uint32_t	i;
+
+	if (Sys_rstMagic != RST_MAGIC) {
+		for (i = 0; i < SYS_RST_NUM; i++) {
+			Sys_rst.cnt[i] = 0;
+		}
+		Sys_rstMagic = RST_MAGIC;
+	}
+	Sys_rst.cause = cause;
+	for (i = 0; i < SYS_RST_NUM; i++) {
+		if ((cause & (0x1UL << i)) != 0) {
+			Sys_rst.cnt[i]++;
+		}
+	}
+	LPC_SYSCON->SYSRSTSTAT = cause;		/* 1書きでクリア */
+}
+
+/***************************************************************************
+	Sys_gateClk
+	参照のないクロックの停止
+
+	[引数]	なし
+	[戻値]	なし
+
+	リセット直後はGPIO, SWMにもクロックが供給されているので、Sys_acqClk
+	で要求されていないものを止める。
+***************************************************************************/
+static void Sys_gateClk(void)
+{
+	uint32_t	primask;
+	uint32_t	keep = CLK_FIXED;
+	uint32_t	i;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	for (i = 0; i < CLK_REF_NUM; i++) {
+		if (Sys_clkRef[i] != 0) {
+			keep |= 0x1UL << i;
+		}
+	}
+	LPC_SYSCON->SYSAHBCLKCTRL &= keep;
+	__set_PRIMASK(primask);
+}
+
+/***************************************************************************
+	Sys_stamp
+	起動時間計測用の時刻取得
+
+	[引数]	usPerTick	前回の呼び出しからのSysTickのクロックの1クロック
+						当たりのus(US_PER_TICK_SFT固定小数点)
+	[戻値]	Sys_iniLpc810開始からの時間(us)
+
+	SysTickはダウンカウンタなので、初期値からの減少分を経過クロック数とす
+	る。SysTickはメインクロックで数え、メインクロックは途中で切り替わるの
+	で、前回からの増分だけをその間のクロックでusに換算して積み上げる。
+	端数は固定小数点のまま残すので、換算の切り捨ては積み重ならない。
+	定数の乗算とシフトだけで換算する(除算を使わない)。
+	64ビットの積算は5か所で展開されると大きいので、インライン展開しない。
+***************************************************************************/
+__attribute__ ((noinline)) static uint32_t Sys_stamp(uint32_t usPerTick)
+{
+	uint32_t	tick = (SYSTICK_MAX - 1) - SysTick->VAL;
+
+	Sys_stampUs += (uint64_t)(tick - Sys_stampTick) * usPerTick;
+	Sys_stampTick = tick;
+	return (uint32_t)(Sys_stampUs >> US_PER_TICK_SFT);
+}
+
+/***************************************************************************
+	Sys_applyClk
+	クロック構成の適用
+
+	[引数]	clk	適用するクロック構成
+	[戻値]	適用した(true), 不正な構成またはPLLがロックしなかった(false)
+
+	切り替え途中でメインクロックが不安定にならないよう、PLLを設定し直す場合
+	は一旦内蔵オシレータに逃がしてから切り替える。
+	使わなくなったPLLは電源を落とし、内蔵オシレータもIRC_PDWONの指定に従い
+	電源を落とす。
+***************************************************************************/
+static _Bool Sys_applyClk(const Sys_clk *clk)
+{
+	_Bool				pllirc = true;		/* PLLの入力は内蔵オシレータ */
+	uint32_t			pllsrc = IRC_HZ;	/* PLL入力クロック数 */
+	_Bool				irc = true;			/* 内蔵オシレータを使う */
+	_Bool				pll = false;		/* PLLを使う */
+	_Bool				clkin = false;		/* CLKIN端子を使う */
+	uint32_t			mainclk;
+	uint32_t			peak;
+
+	/* 引数チェック(PLL入力はIRCかCLKINのみ) */
+	if ((clk->pllSel != SYS_PLL_CLK_IRC) && (clk->pllSel != SYS_PLL_CLK_CLKIN)) {
+		return false;
+	}
+	if ((clk->pllRate < 1) || (clk->pllRate > PLL_RATE_MAX)
+	 || (clk->div < 1) || (clk->div > CLK_DIV_MAX)) {
+		return false;
+	}
+	if (clk->pllSel == SYS_PLL_CLK_CLKIN) {
+		pllsrc = CLKIN_HZ;
+		pllirc = false;		/* PLLの入力は内蔵オシレータでない */
+	}
+
+	switch (clk->mainSel)
+	{
+	case SYS_MAIN_CLK_IRC:		/* メインクロックに内蔵オシレータを選択 */
+		mainclk = IRC_HZ;
+		break;
+	case SYS_MAIN_CLK_PLLIN:	/* メインクロックにPLL入力クロックを選択 */
+		mainclk = pllsrc;
+		irc = pllirc;
+		clkin = !pllirc;
+		break;
+	case SYS_MAIN_CLK_PLLOUT:	/* メインクロックにPLL出力クロックを選択 */
+		mainclk = pllsrc * clk->pllRate;
+		irc = pllirc;
+		clkin = !pllirc;
+		pll = true;
+		break;
+	case SYS_MAIN_CLK_WDTOSC:	/* メインクロックにWDT用オシレータを選択 */
+		mainclk = Wdt_getOscClk();
+		irc = false;
+		break;
+	default:
+		return false;
+	}
+	if ((mainclk == 0) || (mainclk > SYS_CLK_MAX)) {
+		return false;	/* WDT用オシレータ未起動、または仕様上の最高速超え */
+	}
+
+	/* フラッシュのアクセス時間を切り替え中の最高速(現在、IRC、分周前の
+	   切り替え先)に合わせる */
+	peak = (mainclk > IRC_HZ)? mainclk: IRC_HZ;
+	Sys_setFlashTim((SystemCoreClock > peak)? SystemCoreClock: peak);
+
+	/* 切り替え中は内蔵オシレータ(分周なし)で動かす */
+	LPC_SYSCON->PDRUNCFG &= ~(SYS_IRCOUT_PD | SYS_IRC_PD);
+	if (Sys_curClk.mainSel != SYS_MAIN_CLK_IRC) {
+		Sys_updMainClk(SYS_MAIN_CLK_IRC);
+	}
+	LPC_SYSCON->SYSAHBCLKDIV = 1;
+	Sys_tickPerUs = IRC_TICK_PER_US;
+
+	/* CLKIN端子はメインクロックに使う場合だけ有効にし、使わなければ外す
+	   (メインクロックは内蔵オシレータに逃がしてあるので、ここで外せる) */
+	Sys_setClkin(clkin);
+	Sys_updPllClk(clk->pllSel);		/* PLL入力クロックの選択 */
+
+	LPC_SYSCON->PDRUNCFG |= SYS_SYSPLL_PD;	/* 逓倍数の変更はPLL停止中に行う */
+	if (pll) {
+		LPC_SYSCON->SYSPLLCTRL = clk->pllRate - PLL_OFFSET;	/* 逓倍数の設定 */
+		LPC_SYSCON->PDRUNCFG &= ~SYS_SYSPLL_PD;				/* PLLに電源供給 */
+		if (!Sys_waitReg(&LPC_SYSCON->SYSPLLSTAT, SYS_PLL_STAT, SYS_PLL_LOCKED, PLL_LOCK_US)) {
+			/* ロックしない場合は内蔵オシレータのままとする */
+			Sys_curClk.pllSel = clk->pllSel;
+			Sys_curClk.pllRate = clk->pllRate;
+			Sys_fallIrc(clk->div, IRC_HZ / clk->div);
+			return false;
+		}
+	}
+
+	if (clk->mainSel != SYS_MAIN_CLK_IRC) {
+		Sys_updMainClk(clk->mainSel);	/* メインクロックの選択 */
+	}
+
+	if (IRC_PDWON && !irc) {	/* 内蔵オシレータを使わない場合は電源オフ */
+		LPC_SYSCON->PDRUNCFG |= SYS_IRCOUT_PD | SYS_IRC_PD;
+	}
+
+	/* システムクロック分周値の設定 */
+	LPC_SYSCON->SYSAHBCLKDIV = clk->div;
+	Sys_mainClk = mainclk;
+	SystemCoreClock = mainclk / clk->div;
+	Sys_ircSysHz = IRC_HZ / clk->div;
+	Sys_setFlashTim(SystemCoreClock);	/* 分周後のクロックに合わせて短くする */
+	Sys_setRate(SystemCoreClock);
+	Sys_curClk = *clk;
+	return true;
+}
+
+/***************************************************************************
+	Sys_fallIrc
+	PLLがロックしなかった場合の内蔵オシレータへの切り替え
+
+	[引数]	div	システムクロック分周値
+			hz	切り替え後のシステムクロック(IRC_HZ / div)
+	[戻値]	なし
+
+	PLLの電源を落とし、メインクロックを内蔵オシレータにして、分周値divの
+	システムクロックに合わせる(Sys_applyClk, Sys_enterPowerModeで共用)。
+	フラッシュのアクセス時間は、呼び出し前に切り替え中のクロック(今のシス
+	テムクロックと内蔵オシレータ / div)に足りるようにしておくこと。
+	hzは呼び出し側で求める。Sys_enterPowerModeはクロック切り替え時に求め
+	ておいたSys_ircSysHzを渡すので、Sys_setClockを使わなければ除算ルーチ
+	ン(__aeabi_uidiv)はリンクされない。
+***************************************************************************/
+static void Sys_fallIrc(uint32_t div, uint32_t hz)
+{
+	LPC_SYSCON->PDRUNCFG &= ~(SYS_IRCOUT_PD | SYS_IRC_PD);
+	if (Sys_curClk.mainSel != SYS_MAIN_CLK_IRC) {
+		Sys_updMainClk(SYS_MAIN_CLK_IRC);
+	}
+	LPC_SYSCON->PDRUNCFG |= SYS_SYSPLL_PD;
+	LPC_SYSCON->SYSAHBCLKDIV = div;
+	Sys_mainClk = IRC_HZ;
+	SystemCoreClock = hz;
+	Sys_ircSysHz = hz;
+	Sys_setFlashTim(SystemCoreClock);
+	Sys_setRate(SystemCoreClock);
+	Sys_curClk.mainSel = SYS_MAIN_CLK_IRC;
+	Sys_curClk.div = div;
+}
+
+/* クロック変更通知関数の呼び出し(登録順) */
+static void Sys_callNotify(void)
+{
+	uint32_t	i;
+
+	for (i = 0; i < Sys_notifyNum; i++) {
+		Sys_notify[i]();
+	}
+}
+
+/***************************************************************************
+	Sys_setClkin
+	CLKIN端子の有効化・解放
+
+	[引数]	use	CLKIN端子を使う(true), 使わない(false)
+	[戻値]	なし
+
+	使う場合は、PIO0_1のプルアップ/ダウン抵抗を外してSWM_CLKINを割り当
+	て、安定するまで待つ。
+	使わない場合は、SWM_CLKINを外してプルアップ(リセット直後の設定)に戻
+	す。PIO0_1を他の機能に割り当てられるようにするため。
+	既にその状態であれば何もしない。
+	メインクロックがCLKINを使っていない(内蔵オシレータに逃がした)状態で呼
+	び出すこと。
+***************************************************************************/
+static void Sys_setClkin(_Bool use)
+{
+	_Bool	assigned = (Swm_getPin(SWM_CLKIN) != SWM_ASSIGN_NONE)? true: false;
+
+	if (use == assigned) {
+		return;
+	}
+	if (!use) {
+		Swm_release(SWM_CLKIN);
+	}
+	(void)Sys_acqClk(SYS_AHB_CLK_IOCON, 0);
+	LPC_IOCON->PIO0_1 = (LPC_IOCON->PIO0_1 & ~IOCON_MODE) | (use? IOCON_MODE_INACTIVE: IOCON_MODE_PULL_UP);
+	Sys_relClk(SYS_AHB_CLK_IOCON);
+	if (use) {
+		(void)Swm_assign(SWM_CLKIN, SWM_FIXED_PIN(SWM_CLKIN));	/* CLKIN端子を有効化 */
+		Sys_delayUs(CLKIN_WAIT_US);				/* 安定するまで待機 */
+	}
+}
+
+/***************************************************************************
+	Sys_updPllClk
+	PLL入力クロックの更新
+
+	[引数]	sel	PLL入力クロックの選択(SYS_PLL_CLK_*)
+	[戻値]	なし
+
+	UEN(更新許可)ビットを0→1と書くことで選択が反映される。
+	※UM10601 - 4.6.11 System PLL clock source update register
+***************************************************************************/
+static void Sys_updPllClk(uint32_t sel)
+{
+	LPC_SYSCON->SYSPLLCLKSEL = sel;
+	LPC_SYSCON->SYSPLLCLKUEN = 0;
+	LPC_SYSCON->SYSPLLCLKUEN = SYS_PLL_CLK_UPDATE;	/* PLL動作開始 */
+	while ((LPC_SYSCON->SYSPLLCLKUEN & SYS_PLL_CLK_UPDATE) != SYS_PLL_CLK_UPDATE) {
+		;	/* 安定するまで待機 */
+	}
+}
+
+/***************************************************************************
+	Sys_updMainClk
+	メインクロックの更新
+
+	[引数]	sel	メインクロックの選択(SYS_MAIN_CLK_*)
+	[戻値]	なし
+
+	UEN(更新許可)ビットを0→1と書くことで選択が反映される。
+	※UM10601 - 4.6.13 Main clock source update enable register
+***************************************************************************/
+static void Sys_updMainClk(uint32_t sel)
+{
+	LPC_SYSCON->MAINCLKSEL = sel;
+	LPC_SYSCON->MAINCLKUEN = 0;
+	LPC_SYSCON->MAINCLKUEN = SYS_MAIN_CLK_UPDATE;	/* メインクロック更新開始 */
+	while ((LPC_SYSCON->MAINCLKUEN & SYS_MAIN_CLK_UPDATE) != SYS_MAIN_CLK_UPDATE) {
+		;	/* 安定するまで待機 */
+	}
+	Sys_curClk.mainSel = sel;
+}
+
+/***************************************************************************
+	Sys_setRate
+	時間換算用の係数の更新
+
+	[引数]	hz	システムクロック周波数(Hz)
+	[戻値]	なし
+
+	1ms, 1us当たりのシステムクロック数を逆数の乗算で求める(除算は使わない)。
+***************************************************************************/
+static void Sys_setRate(uint32_t hz)
+{
+	Sys_tickPerMs = ((uint64_t)hz * RECIP_1000) >> (RECIP_1000_SFT - RATE_Q);
+	Sys_tickPerUs = ((uint64_t)hz * RECIP_1000000) >> (RECIP_1000000_SFT - RATE_Q);
+}
+
+/***************************************************************************
+	Sys_setFlashTim
+	フラッシュのアクセス時間の設定
+
+	[引数]	hz	想定するシステムクロックの最高値(Hz)
+	[戻値]	なし
+
+	hzでアクセスできる最小のクロック数をFLASHCFGに設定する(予約ビットは
+	変えない)。既にその値なら書き込まない。
+	クロックを上げる場合は切り替え前に、下げる場合は切り替え後に呼ぶこと。
+***************************************************************************/
+static void Sys_setFlashTim(uint32_t hz)
+{
+	uint32_t	cfg = LPC_FLASHCTRL->FLASHCFG;
+	uint32_t	tim = (hz <= FLASH_1CLK_MAX_HZ)? FLASH_TIM_1CLK: FLASH_TIM_2CLK;
+
+	if ((cfg & FLASH_TIM) != tim) {
+		LPC_FLASHCTRL->FLASHCFG = (cfg & ~FLASH_TIM) | tim;
+	}
+}
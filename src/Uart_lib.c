@@ -0,0 +1,438 @@
+/***************************************************************************
+	Uart_lib.c
+	私家版USARTライブラリ
+
+	使用方法: #include "Uart_lib.h"
+
+	マイコン: LPC810(NXP Semiconductors)
+
+	USART0を割り込みで送受信するためのライブラリ。
+	送受信ともリングバッファを介すので、呼び出し側は送信完了や受信を待た
+	ずに済む(main()の定常ループの時間を乱さない)。
+
+	・Uart_ini
+		USART0を8ビット、パリティなし、ストップビット1で初期化する。
+		伝送速度は現在のメインクロックから、誤差が最小となるUARTCLKDIV,
+		UARTFRGMULT, BRGの組み合わせを求めて設定する。
+		Sys_addClkNotifyに登録するので、Sys_setClockでクロックを切り替え
+		た時も同じ伝送速度になるよう設定し直す。
+	・Uart_getBaud
+		実際に設定された伝送速度を取得する。
+	・Uart_send, Uart_puts
+		送信データを送信バッファに積む。バッファが満杯になった分は積まずに
+		戻る(戻値で積めたバイト数を返す)。
+	・Uart_recv
+		受信バッファから受信済みのデータを取り出す。
+	・Uart_isTxIdle
+		送信バッファが空で、最後のストップビットまで送り終えたかを返す。
+		Sys_setClockの前などに確認する。
+	・Uart_getStat
+		受信バッファ溢れやエラーの回数を取得する。
+	・UART0_IRQHandler
+		USART0の割り込みハンドラ。受信データをバッファに移し、送信バッファ
+		のデータをTXDATAに書く。
+
+	ピンの割り当て(スイッチマトリクスのSWM_U0_TXD, SWM_U0_RXD)は本ライブ
+	ラリでは行わないので、core.hのSWM_PIN_MAPに書くか、Swm_assignで割り当
+	てておくこと。LPC810ではピンが足りないので、Swm_assignで他の機能のピン
+	を一時的に借りて、Uart_isTxIdleで送信完了を確かめてから返してもよい。
+
+	バッファの排他について:
+	送信バッファはmain側だけがhead、割り込み側だけがtailを、受信バッファは
+	その逆を更新する(Evt_libと同じく書き込み側1つ、読み出し側1つの前提)。
+	そのため割り込み禁止は不要だが、Uart_send, Uart_recvを割り込み処理か
+	ら呼び出すことはできない。
+
+	変更履歴
+	2026.10.16: mits: 新規作成
+	2026.10.16: mits: クロック供給をSys_acqClkで行うようにした
+	2026.10.16: mits: ピンの割り当ての説明をSwm_libに合わせた
+	2026.10.16: mits: 64ビット除算(__aeabi_uldivmod)を使わないようにした
+	2026.10.16: mits: core.hのUART_ENABLEが0なら何もしないようにした
+***************************************************************************/
+#include	"core.h"
+#include	"Uart_lib.h"
+#include	"Sys_lib.h"		/* for Sys_getMainClk, Sys_addClkNotify, Sys_acqClk */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+enum {
+	UART_PRI		= PRI_MEDIUM,			/* USART0割り込みの優先度 */
+	UART_TX_MASK	= UART_TX_SIZE - 1,		/* 送信バッファの位置のマスク */
+	UART_RX_MASK	= UART_RX_SIZE - 1,		/* 受信バッファの位置のマスク */
+	UART_FRG_ONE	= UART_FRGDIV_VAL + 1,	/* FRGの分母(1 + MULT/256の1) */
+	UART_ERR_BITS	= UART_OVERRUN | UART_FRAMERR | UART_PARITYERR | UART_RXNOISE,
+	UART_INT_RX		= UART_RXRDY | UART_ERR_BITS,	/* 常に許可する割り込み */
+	UART_CFG_8N1	= UART_CFG_DATALEN_8 | UART_CFG_PARITY_NONE	/* ストップビット1 */
+};
+
+_Static_assert((UART_TX_SIZE & UART_TX_MASK) == 0 && UART_TX_SIZE <= 128,
+	"UART_TX_SIZE must be a power of 2 (max 128)");
+_Static_assert((UART_RX_SIZE & UART_RX_MASK) == 0 && UART_RX_SIZE <= 128,
+	"UART_RX_SIZE must be a power of 2 (max 128)");
+
+/*** 伝送速度の設定値 ***/
+typedef struct Uart_brg {
+	uint32_t	clkDiv;		/* UARTCLKDIV */
+	uint32_t	frgMult;	/* UARTFRGMULT */
+	uint32_t	brg;		/* BRG */
+	uint32_t	baud;		/* 実際の伝送速度 */
+} Uart_brg;
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static uint32_t			Uart_baud;			/* 指定された伝送速度 */
+static uint32_t			Uart_actBaud;		/* 実際の伝送速度(設定できなければ0) */
+static _Bool			Uart_notified;		/* クロック変更通知を登録済み */
+static volatile uint8_t	Uart_txBuf[UART_TX_SIZE];	/* 送信バッファ */
+static volatile uint8_t	Uart_txHead;		/* 送信: 次に積む位置(main側が更新) */
+static volatile uint8_t	Uart_txTail;		/* 送信: 次に送る位置(割り込み側が更新) */
+static volatile uint8_t	Uart_rxBuf[UART_RX_SIZE];	/* 受信バッファ */
+static volatile uint8_t	Uart_rxHead;		/* 受信: 次に積む位置(割り込み側が更新) */
+static volatile uint8_t	Uart_rxTail;		/* 受信: 次に取り出す位置(main側が更新) */
+static volatile Uart_stat	Uart_cnt;		/* 通信の統計 */
+
+/***************************************************************************
+	ローカル関数
+***************************************************************************/
+static _Bool Uart_calcBrg(uint32_t mainHz, uint32_t baud, Uart_brg *brg);
+static _Bool Uart_setBrg(void);
+static void Uart_procClk(void);
+
+/***************************************************************************
+	Uart_ini
+	USART0の初期化
+	※Sys_iniLpc810の後に呼び出すこと
+
+	[引数]	baud	伝送速度(bps)
+	[戻値]	設定できた(true)
+			現在のメインクロックでは誤差がUART_ERR_MAX_PPMを超える(false)
+
+	falseの場合はUSART0を停止したままにする(送信データはバッファに溜まる)。
+	その後Sys_setClockで設定可能なクロックに切り替えれば動作を始める。
+	core.hのUART_ENABLEが0の場合は何もせずにfalseを返す。
+***************************************************************************/
+_Bool Uart_ini(uint32_t baud)
+{
+	_Bool	ok;
+
+	if (!UART_ENABLE) {
+		return false;
+	}
+	if (!Sys_acqClk(SYS_AHB_CLK_UART0, SYS_UART0_RST_N | SYS_UARTFRG_RST_N)) {
+		Sys_relClk(SYS_AHB_CLK_UART0);	/* 初期化し直しなら参照数を戻す */
+	}
+
+	Uart_baud = baud;
+	Uart_txHead = Uart_txTail = 0;
+	Uart_rxHead = Uart_rxTail = 0;
+	if (!Uart_notified) {
+		Uart_notified = Sys_addClkNotify(Uart_procClk);
+	}
+	ok = Uart_setBrg();
+
+	LPC_USART0->INTENSET = UART_INT_RX;
+	NVIC_SetPriority(UART0_IRQn, UART_PRI);
+	NVIC_EnableIRQ(UART0_IRQn);
+	return ok;
+}
+
+/***************************************************************************
+	Uart_getBaud
+	実際の伝送速度の取得
+
+	[引数]	なし
+	[戻値]	伝送速度(bps)、設定できていない場合は0
+***************************************************************************/
+uint32_t Uart_getBaud(void)
+{
+	return Uart_actBaud;
+}
+
+/***************************************************************************
+	Uart_send
+	データの送信
+
+	[引数]	data	送信データ
+			len		バイト数
+	[戻値]	送信バッファに積めたバイト数
+
+	送信バッファに積んで送信割り込みを許可するだけで、送信完了は待たない。
+	割り込み処理から呼び出さないこと。
+***************************************************************************/
+uint32_t Uart_send(const void *data, uint32_t len)
+{
+	const uint8_t	*p = data;
+	uint8_t			head = Uart_txHead;
+	uint32_t		num;
+
+	for (num = 0; num < len; num++) {
+		if ((uint8_t)(head - Uart_txTail) >= UART_TX_SIZE) {
+			break;		/* 満杯 */
+		}
+		Uart_txBuf[head & UART_TX_MASK] = p[num];
+		head++;
+	}
+	if (num != 0) {
+		Uart_txHead = head;						/* 書き込み後に公開 */
+		LPC_USART0->INTENSET = UART_TXRDY;		/* 割り込みで送信 */
+	}
+	return num;
+}
+
+/***************************************************************************
+	Uart_puts
+	文字列の送信
+
+	[引数]	str	文字列
+	[戻値]	送信バッファに積めたバイト数
+
+	終端の'\0'は送らない。改行の変換もしない。
+***************************************************************************/
+uint32_t Uart_puts(const char *str)
+{
+	uint32_t	len = 0;
+
+	while (str[len] != '\0') {
+		len++;
+	}
+	return Uart_send(str, len);
+}
+
+/***************************************************************************
+	Uart_recv
+	受信データの取り出し
+
+	[引数]	buf	格納先
+			max	格納先のバイト数
+	[戻値]	取り出したバイト数(受信データが無ければ0)
+
+	割り込み処理から呼び出さないこと。
+***************************************************************************/
+uint32_t Uart_recv(void *buf, uint32_t max)
+{
+	uint8_t		*p = buf;
+	uint8_t		tail = Uart_rxTail;
+	uint8_t		head = Uart_rxHead;
+	uint32_t	num;
+
+	for (num = 0; (num < max) && (tail != head); num++) {
+		p[num] = Uart_rxBuf[tail & UART_RX_MASK];
+		tail++;
+	}
+	Uart_rxTail = tail;		/* 読み出し後に解放 */
+	return num;
+}
+
+/***************************************************************************
+	Uart_isTxIdle
+	送信完了の確認
+
+	[引数]	なし
+	[戻値]	送信バッファが空で送信完了(true), 送信中(false)
+***************************************************************************/
+_Bool Uart_isTxIdle(void)
+{
+	if (Uart_txHead != Uart_txTail) {
+		return false;
+	}
+	return ((LPC_USART0->STAT & UART_TXIDLE) != 0)? true: false;
+}
+
+/***************************************************************************
+	Uart_getStat
+	通信の統計の取得
+
+	[引数]	stat	格納先
+	[戻値]	なし
+
+	回数はUart_ini以降の累計(Uart_iniではクリアしない)。
+***************************************************************************/
+void Uart_getStat(Uart_stat *stat)
+{
+	uint32_t	primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	*stat = Uart_cnt;
+	__set_PRIMASK(primask);
+}
+
+/***************************************************************************
+	Uart_calcBrg
+	伝送速度の設定値の計算
+
+	[引数]	mainHz	メインクロック(Hz)
+			baud	伝送速度(bps)
+			brg		設定値の格納先
+	[戻値]	誤差がUART_ERR_MAX_PPM以内(true), 超える・設定できない(false)
+
+	UARTCLKDIVを1から順に試し、それぞれで以下のように求める。
+	  U_PCLK = mainHz / UARTCLKDIV
+	  n(BRG+1) = U_PCLK / (16 * baud)       ※FRGで割るので切り捨て
+	  UARTFRGMULT = 256 * (U_PCLK / (16 * baud * n) - 1)  ※四捨五入
+	nを切り捨てているので、U_PCLK / (16 * baud * n)は1以上2未満となり、
+	FRGの範囲(1～1+255/256)に収まる。
+	誤差の最も小さい組み合わせを選ぶ(同じならUARTCLKDIVの小さい方)。
+	誤差の比較は割り算を避けて、誤差/分母どうしをたすき掛けで比べる。
+	除算はUART_FRG_ONE/UART_OVERSAMPLE(=16)で約分して32ビットで行う(64ビット
+	除算の__aeabi_uldivmodは使わない)。
+
+	最大UART_CLKDIV_MAX回の除算を伴うループとなるので、Uart_iniとクロッ
+	ク変更時にだけ呼び出す。誤差が0になれば打ち切る。
+***************************************************************************/
+static _Bool Uart_calcBrg(uint32_t mainHz, uint32_t baud, Uart_brg *brg)
+{
+	uint32_t	div, u, n, t, m;
+	uint64_t	num, den, err;
+	uint64_t	bestErr = 0, bestDen = 0;	/* bestDenが0なら候補なし */
+	uint32_t	bestU = 0;
+
+	if ((baud == 0) || (baud > mainHz / UART_OVERSAMPLE)) {
+		return false;
+	}
+	for (div = 1; div <= UART_CLKDIV_MAX; div++) {
+		u = mainHz / div;
+		n = u / (baud * UART_OVERSAMPLE);
+		if (n == 0) {
+			break;		/* これ以上分周しても届かない */
+		}
+		if (n > UART_BRG_MAX + 1) {
+			continue;	/* BRGに収まらないのでもっと分周する */
+		}
+		t = baud * UART_OVERSAMPLE * n;
+		/* 256*(u-t)/tの分子・分母をUART_OVERSAMPLEで約分(u-t < tなので32ビットに収まる) */
+		m = ((u - t) * (UART_FRG_ONE / UART_OVERSAMPLE) + baud * n / 2) / (baud * n);
+		if (m > UART_FRGMULT_MAX) {
+			/* 2倍近くに丸め上がった場合はnを1つ増やしてFRGを使わない */
+			if (n == UART_BRG_MAX + 1) {
+				continue;
+			}
+			n++;
+			t += baud * UART_OVERSAMPLE;
+			m = 0;
+		}
+		/* 実際の伝送速度 = U_PCLK*256 / (16*n*(256+m))、誤差 = |num-den| / den */
+		num = (uint64_t)u * UART_FRG_ONE;
+		den = (uint64_t)t * (UART_FRG_ONE + m);
+		err = (num > den)? num - den: den - num;
+		if ((bestDen == 0) || (err * bestDen < bestErr * den)) {
+			bestErr = err;
+			bestDen = den;
+			bestU = u;
+			brg->clkDiv = div;
+			brg->frgMult = m;
+			brg->brg = n - 1;
+		}
+		if (err == 0) {
+			break;
+		}
+	}
+	if (bestDen == 0) {
+		return false;
+	}
+	t = (brg->brg + 1) * (UART_FRG_ONE + brg->frgMult);	/* 分子・分母をUART_OVERSAMPLEで約分 */
+	brg->baud = (bestU * (UART_FRG_ONE / UART_OVERSAMPLE) + t / 2) / t;
+	return (bestErr * 1000000 <= (uint64_t)UART_ERR_MAX_PPM * bestDen)? true: false;
+}
+
+/***************************************************************************
+	Uart_setBrg
+	伝送速度の設定
+
+	[引数]	なし
+	[戻値]	設定できた(true), 設定できない(false)
+
+	USART0を止めてからUARTCLKDIV, FRG, BRGを書き換え、再度有効にする。
+	設定できない場合はU_PCLKを止めたままにする。
+	送信中のデータがあれば化けるので、必要なら事前にUart_isTxIdleで確認す
+	ること。
+***************************************************************************/
+static _Bool Uart_setBrg(void)
+{
+	Uart_brg	brg;
+
+	LPC_USART0->CFG = UART_CFG_8N1;		/* 停止 */
+	if (!Uart_calcBrg(Sys_getMainClk(), Uart_baud, &brg)) {
+		LPC_SYSCON->UARTCLKDIV = 0;		/* U_PCLK停止 */
+		Uart_actBaud = 0;
+		return false;
+	}
+	LPC_SYSCON->UARTCLKDIV = brg.clkDiv;
+	LPC_SYSCON->UARTFRGDIV = UART_FRGDIV_VAL;
+	LPC_SYSCON->UARTFRGMULT = brg.frgMult;
+	LPC_USART0->BRG = brg.brg;
+	LPC_USART0->CFG = UART_CFG_8N1 | UART_CFG_ENABLE;
+	Uart_actBaud = brg.baud;
+	return true;
+}
+
+/***************************************************************************
+	Uart_procClk
+	クロック変更時の処理(Sys_addClkNotifyで登録)
+
+	[引数]	なし
+	[戻値]	なし
+***************************************************************************/
+static void Uart_procClk(void)
+{
+	(void)Uart_setBrg();
+}
+
+/***************************************************************************
+	UART0_IRQHandler
+	USART0割り込みハンドラ
+
+	[引数]	なし
+	[戻値]	なし
+
+	受信データは1回の割り込みで1バイト(USARTの受信バッファは1バイト)。
+	送信はTXRDYの間だけTXDATAに書く(送信中のシフトレジスタと合わせて2バ
+	イトまで)。送信バッファが空になったら送信割り込みを禁止する。
+	core.hのUART_ENABLEが0の場合は何もしない(ベクタテーブルから参照され
+	るので、処理とバッファがリンクされないようにする)。
+***************************************************************************/
+void UART0_IRQHandler(void)
+{
+	uint32_t	stat;
+	uint8_t		head, tail;
+	uint8_t		data;
+
+	if (!UART_ENABLE) {
+		return;
+	}
+	stat = LPC_USART0->STAT;
+	/* 受信 */
+	if ((stat & UART_RXRDY) != 0) {
+		data = (uint8_t)LPC_USART0->RXDATA;
+		head = Uart_rxHead;
+		if ((uint8_t)(head - Uart_rxTail) < UART_RX_SIZE) {
+			Uart_rxBuf[head & UART_RX_MASK] = data;
+			Uart_rxHead = head + 1;		/* 書き込み後に公開 */
+		}
+		else {
+			Uart_cnt.rxLost++;
+		}
+	}
+	if ((stat & UART_ERR_BITS) != 0) {
+		Uart_cnt.overrun += ((stat & UART_OVERRUN) != 0)? 1: 0;
+		Uart_cnt.frameErr += ((stat & UART_FRAMERR) != 0)? 1: 0;
+		Uart_cnt.parityErr += ((stat & UART_PARITYERR) != 0)? 1: 0;
+		Uart_cnt.noise += ((stat & UART_RXNOISE) != 0)? 1: 0;
+		LPC_USART0->STAT = stat & UART_ERR_BITS;	/* 1書きでクリア */
+	}
+
+	/* 送信 */
+	tail = Uart_txTail;
+	head = Uart_txHead;
+	while ((tail != head) && ((LPC_USART0->STAT & UART_TXRDY) != 0)) {
+		LPC_USART0->TXDATA = Uart_txBuf[tail & UART_TX_MASK];
+		tail++;
+	}
+	Uart_txTail = tail;		/* 読み出し後に解放 */
+	if (tail == head) {
+		LPC_USART0->INTENCLR = UART_TXRDY;
+	}
+}
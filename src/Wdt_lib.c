@@ -9,10 +9,34 @@
 	LPC800シリーズのウォッチドッグタイマ(WDT)を制御するAPI群。
 	・Wdt_ini
 		WDTユニットを初期化するとともに(必要ならば)動作開始させる。
+	・Wdt_calOsc
+		WDT用オシレータの実際の周波数をシステムクロックで計測し、以降の換
+		算とTC, WINDOW, WARNINTをその周波数に合わせる。
 	・Wdt_getOscClk
 		現在のWDT用オシレータの周波数を取得する。
 	・Wdt_clr
 		WDTのクリアを行う。
+	・Wdt_msToCnt
+		時間(ms)をWDTカウンタ値に換算する。
+	・Wdt_cntToMs
+		WDTカウンタ値を時間(ms)に換算する。
+	・Wdt_isFeedable
+		WDTクリア可能(ガード時間外)か否かを判断する。
+	・Wdt_getRestMs
+		WDT満了までの残り時間を取得する。
+	・Wdt_getCrash
+		WDT警告割り込みで記録した、割り込まれた箇所(PC, LR, xPSR)を取得す
+		る。記録はリセットをまたいで残る。
+	・Wdt_clrCrash
+		上記の記録を消去する。
+	・Wdt_learnStart
+		Wdt_clr毎にクリア間隔を記録(最短・最長・ヒストグラム)する学習を
+		開始する。指定回数記録すると、Wdt_learnApplyと同じ設定を自動で行う。
+	・Wdt_learnApply
+		学習したクリア間隔に余裕を加えて、TC(タイムアウト)とWINDOW(ガー
+		ド時間)を設定し直す。
+	・Wdt_getLearn
+		学習中・学習後の記録を取得する。
 	・Wdt_procWarn
 		WDT警告割り込み時の処理関数。
 		本関数は外部で定義しておく必要がある。
@@ -20,21 +44,113 @@
 
 	変更履歴
 	2014.06.07: mits: 新規作成
+	2026.10.16: mits: レジスタ設定値をビルド時に求めるようにした
+	2026.10.16: mits: Wdt_msToCnt追加
+	2026.10.16: mits: Wdt_cntToMs, Wdt_isFeedable, Wdt_getRestMs追加
+	2026.10.16: mits: 警告割り込み時に割り込まれた箇所を記録するようにした
+	2026.10.16: mits: Wdt_calOsc追加
+	2026.10.16: mits: クリア間隔の学習(Wdt_learnStart, Wdt_learnApply, Wdt_getLearn)追加
+	2026.10.16: mits: クロック供給をSys_acqClkで行うようにした
+	2026.10.16: mits: WDT_IRQHandler, Wdt_clrをSRAMに配置(RAMFUNC)
+	2026.10.16: mits: 64ビット除算(__aeabi_uldivmod)を使わないようにした
+	2026.10.16: mits: core.hのWDT_LEARN_ENABLEが0なら学習しないようにした
+	2026.10.16: mits: 学習後のTCに警告割り込みまでの時間を加えた(最長間隔でのクリアが警告割り込みに間に合わなかった)
 ***************************************************************************/
 #include	"core.h"
 #include	"Wdt_lib.h"
+#include	"Sys_lib.h"		/* for Sys_* */
+#include	"Mrt_lib.h"		/* for Mrt_* */
+
+/***************************************************************************
+	ローカル定義
+***************************************************************************/
+
+/* UM10601 - 4.6.6 Watchdog oscillator control register参照 */
+enum {
+	FREQ_POS		= 5,	/* FREQSELのビット位置 */
+	DIVSEL_OFFSET	= 2,	/* DIVSEL=0に相当する分周値 */
+	DIVSEL_RATE		= 2,	/* DIVSELから分周値を求める時の係数 */
+	DIV_MAX			= 64	/* 分周値の上限 */
+};
+
+/* 例外エントリ時にスタックに積まれるレジスタの位置(ワード単位) */
+/* ※ARMv6-M Architecture Reference Manual - B1.5.6 Exception entry behavior */
+enum {
+	FRAME_LR	= 5,	/* 割り込まれた箇所のLR */
+	FRAME_PC	= 6,	/* 割り込まれた箇所のPC */
+	FRAME_XPSR	= 7		/* 割り込まれた箇所のxPSR */
+};
+
+/* クラッシュ記録が有効であることを示す値 */
+enum {
+	CRASH_MAGIC	= 0x57445443	/* 'WDTC' */
+};
+
+/* UM10601 - 12.6.4 Watchdog Timer Constant register参照 */
+enum {
+	PRE_DIV		= 4,	/* プリスケーラの分周値(固定値) */
+	SEC_UINT	= 1000	/* カウンタ係数；1秒単位の場合は1、1ms単位の場合は1000... */
+};
+
+/* Wdt_calOscの計測条件 */
+enum {
+	CAL_MS		= 10,	/* ms; 計測するWDTカウンタ値(公称周波数での時間) */
+	CAL_TMO_MS	= 2 * CAL_MS,	/* ms; 計測の上限時間(公称の-40%でも収まる) */
+	CAL_LIM_SFT	= 1		/* 公称周波数の1/2^n～2^n倍を外れる計測値は捨てる */
+};
+
+/*** 指定時間(ms)に対応するWDTカウンタ値(core.hの指定に基づく定数式) ***/
+/* ※WDTの秒数は概して大きくなりがちなので、桁あふれしないよう64ビットで計算 */
+#define	WDT_MS2CNT(ms)	((uint64_t)WDTOSC_FREQ_HZ(WWDT_FREQ) * (ms)	\
+							/ ((uint64_t)WWDT_DIV * PRE_DIV * SEC_UINT))
+
+/*** core.hの指定のチェック(仕様外ならビルドエラー) ***/
+_Static_assert(WDTOSC_FREQ_HZ(WWDT_FREQ) != 0, "WWDT_FREQ must be WDTOSC_FREQ_600KHZ-WDTOSC_FREQ_4_60MHZ");
+_Static_assert(((uint32_t)WWDT_DIV >= DIVSEL_OFFSET) && ((uint32_t)WWDT_DIV <= DIV_MAX) && ((WWDT_DIV % DIVSEL_RATE) == 0),
+	"WWDT_DIV must be an even number of 2-64");
+_Static_assert(WWDT_TIM_GUARD <= WWDT_TIM_OUT, "WWDT_TIM_GUARD exceeds WWDT_TIM_OUT");
+_Static_assert(WWDT_TIM_WARN <= WWDT_TIM_OUT - WWDT_TIM_GUARD,
+	"WWDT_TIM_WARN cannot be reached (it exceeds WWDT_TIM_OUT - WWDT_TIM_GUARD)");
+_Static_assert(WDT_MS2CNT(WWDT_TIM_OUT) >= WWDT_CNT_MIN, "WWDT_TIM_OUT is too short for WWDT_FREQ/WWDT_DIV");
+_Static_assert(WDT_MS2CNT(WWDT_TIM_OUT) <= WWDT_CNT_MAX, "WWDT_TIM_OUT is too long for WWDT_FREQ/WWDT_DIV");
+_Static_assert(WDT_MS2CNT(WWDT_TIM_WARN) <= WWDT_WARN_MAX, "WWDT_TIM_WARN is too long for WWDT_FREQ/WWDT_DIV");
+
+/*** Wdt_iniで書き込むレジスタ値 ***/
+enum {
+	INI_WDTOSCCTRL	= (WWDT_FREQ << FREQ_POS)					/* LPC_SYSCON->WDTOSCCTRL */
+					| ((WWDT_DIV - DIVSEL_OFFSET) / DIVSEL_RATE),
+	INI_TC			= (int)WDT_MS2CNT(WWDT_TIM_OUT),				/* LPC_WWDT->TC */
+	INI_WINDOW		= (int)WDT_MS2CNT(WWDT_TIM_OUT - WWDT_TIM_GUARD),	/* LPC_WWDT->WINDOW */
+	INI_WARNINT		= (int)WDT_MS2CNT(WWDT_TIM_WARN),				/* LPC_WWDT->WARNINT */
+	INI_CNT_PER_MS	=	/* 1ms当たりのWDTカウンタ値(RATE_Q固定小数点) */
+		(int)(((uint64_t)WDTOSC_FREQ_HZ(WWDT_FREQ) << RATE_Q)
+				/ ((uint64_t)WWDT_DIV * PRE_DIV * SEC_UINT)),
+	INI_MS_PER_CNT	=	/* WDTカウンタ1当たりの時間(ms、RATE_Q固定小数点) */
+		(int)(((uint64_t)WWDT_DIV * PRE_DIV * SEC_UINT << RATE_Q)
+				/ WDTOSC_FREQ_HZ(WWDT_FREQ))
+};
 
 /***************************************************************************
 	ローカル変数
 ***************************************************************************/
 static uint32_t	Wdt_freq;	/* WDTオシレータソースクロック(単位はHz) */
 static uint32_t	Wdt_div;	/* 分周値(2～64の偶数) */
+static uint32_t	Wdt_cntPerMs;	/* 1ms当たりのWDTカウンタ値(RATE_Q固定小数点) */
+static uint32_t	Wdt_msPerCnt;	/* WDTカウンタ1当たりの時間(ms、RATE_Q固定小数点) */
+static uint32_t	Wdt_crashMagic NOINIT;	/* Wdt_crashが有効ならCRASH_MAGIC */
+static Wdt_crash	Wdt_crashRec NOINIT;	/* 警告割り込み時の記録(リセットをまたいで残す) */
+static Wdt_learn	Wdt_lrn;		/* クリア間隔の学習の記録 */
+static uint32_t	Wdt_lrnNum;		/* 自動で設定するまでの記録回数(0なら自動設定しない) */
+static uint32_t	Wdt_lrnTc;		/* 学習で設定するTCの上限(WWDT_TIM_OUT相当) */
+static uint32_t	Wdt_lrnLead;	/* 確保するクリア可能時間(WWDT_TIM_WARN＋WDT_LEARN_LEAD_MS相当) */
 
 /***************************************************************************
 	ローカル関数
 ***************************************************************************/
-static uint32_t	Wdt_calcOscCtrl(uint32_t freq, uint32_t div);
-static uint32_t	Wdt_getMs(uint32_t ms, uint32_t max);
+void Wdt_procIrq(const uint32_t *frame);
+static void		Wdt_feed(void);
+static _Bool	Wdt_record(uint32_t cnt);
+static _Bool	Wdt_apply(void);
 
 /***************************************************************************
 	Wdt_procWarn
@@ -58,9 +174,56 @@ void Wdt_procWarn(void)
 
 	[引数]	なし
 	[戻値]	なし
+
+	割り込まれた箇所のレジスタが積まれたスタック(MSPかPSPかはEXC_RETURNの
+	b2で判断)をr0に入れてWdt_procIrqへ分岐するだけの入口である。
+	C言語の関数ではコンパイラがスタックを積むため、スタックの位置を確定でき
+	るようnakedとしている。
+	LRはEXC_RETURNのまま分岐するので、Wdt_procIrqから戻れば割り込みから戻
+	る。
+	SRAMに配置する(RAMFUNC)。Wdt_procIrqへはリテラルの絶対番地で分岐する
+	ので、フラッシュとの距離は問題にならない。
+***************************************************************************/
+__attribute__ ((naked)) RAMFUNC void WDT_IRQHandler(void)
+{
+	__ASM (
+		"	movs	r0, #4			\n"
+		"	mov		r1, lr			\n"
+		"	tst		r0, r1			\n"
+		"	beq		1f				\n"
+		"	mrs		r0, psp			\n"
+		"	b		2f				\n"
+		"1:	mrs		r0, msp			\n"
+		"2:	ldr		r1, =Wdt_procIrq\n"
+		"	bx		r1				\n"
+		"	.ltorg					\n"
+	);
+}
+
+/***************************************************************************
+	Wdt_procIrq
+	WDT警告割り込みの処理
+
+	[引数]	frame	割り込まれた箇所のレジスタが積まれたスタック
+	[戻値]	なし
+
+	割り込まれた箇所のPC, LR, xPSRを.noinitセクションに記録してから、
+	Wdt_procWarnを呼び出す。
+	警告割り込みの後にWDT満了でリセットされた場合、リセット後に
+	Wdt_getCrashで記録を読み出せば、どこで止まっていたかが分かる。
+	※WDT_IRQHandlerからのみ呼ばれる(アセンブラから参照するため非static)
 ***************************************************************************/
-void WDT_IRQHandler(void)
+void Wdt_procIrq(const uint32_t *frame)
 {
+	if (Wdt_crashMagic != CRASH_MAGIC) {
+		Wdt_crashRec.cnt = 0;
+	}
+	Wdt_crashRec.pc = frame[FRAME_PC];
+	Wdt_crashRec.lr = frame[FRAME_LR];
+	Wdt_crashRec.xpsr = frame[FRAME_XPSR];
+	Wdt_crashRec.cnt++;
+	Wdt_crashMagic = CRASH_MAGIC;
+
 	Wdt_procWarn();
 
 	/***
@@ -92,113 +255,156 @@ void WDT_IRQHandler(void)
 	・WWDT_TIM_GUARD	WDTクリアガード時間
 	・WWDT_TIM_WARN		WDT警告割り込み発生時間
 
+	各レジスタへの設定値はビルド時に求めている(INI_*)。
+	指定が範囲外の場合は、従来のように上限値に丸めるのではなくビルドエラー
+	としている。
+
 ***************************************************************************/
 void Wdt_ini(void)
 {
-	/* WDTOSCCTRL_Valの通りに周波数を設定し、電源・クロック供給開始 */
-	LPC_SYSCON->WDTOSCCTRL = Wdt_calcOscCtrl(WWDT_FREQ, WWDT_DIV);
+	Wdt_freq = WDTOSC_FREQ_HZ(WWDT_FREQ);
+	Wdt_div = WWDT_DIV;
+	Wdt_cntPerMs = INI_CNT_PER_MS;
+	Wdt_msPerCnt = INI_MS_PER_CNT;
+
+	/* INI_WDTOSCCTRLの通りに周波数を設定し、電源・クロック供給開始 */
+	LPC_SYSCON->WDTOSCCTRL = INI_WDTOSCCTRL;
 	LPC_SYSCON->PDRUNCFG &= ~SYS_WDTOSC_PD;			/* 電源オン */
-	LPC_SYSCON->SYSAHBCLKCTRL |= SYS_AHB_CLK_WWDT;	/* クロック供給 */
+	(void)Sys_acqClk(SYS_AHB_CLK_WWDT, 0);			/* クロック供給(返さない) */
 
 	/* WDTカウンタ・ウィンドウカウンタを指定値で初期化 */
-	LPC_WWDT->TC = Wdt_getMs(WWDT_TIM_OUT, WWDT_CNT_MAX);
-	LPC_WWDT->WINDOW = Wdt_getMs(WWDT_TIM_OUT-WWDT_TIM_GUARD, WWDT_WINDOW_MAX);
+	LPC_WWDT->TC = INI_TC;
+	LPC_WWDT->WINDOW = INI_WINDOW;
 	NVIC_EnableIRQ(WDT_IRQn);
 
 	LPC_WWDT->MOD = WWDT_MODE;
 	Wdt_clr();	/* クリア(WDTカウンタ(TV)を設定)することによりWDTが動作開始する */
 
 	/* ※WDTカウンタ(TV)設定後にWARNINTを設定しないと割り込み発生の危険あり */
-	LPC_WWDT->WARNINT = Wdt_getMs(WWDT_TIM_WARN, WWDT_WARN_MAX);
-}
-
-/***************************************************************************
-	Wdt_calcOscCtrl
-	WDTOSCCTRLレジスタへの設定値計算
-
-	[引数]	freq	周波数選択値(WDTOSC_FREQ_*のどれか)
-			div		分周値(2～64、必ず偶数)
-	[戻値]	WDTOSCCTRLレジスタへの設定値
-
-	SYSCON(System configure)中のWDTOSCCTRLレジスタへの設定値を求め、内部エリ
-	アを更新する。
-	内部エリアは、他のWdt関連の関数が使用するので、本関数を一番最初に呼び出し
-	ておく必要がある。
-	引数のエラーチェックは行ってない。これらが定義範囲内であることは呼び出し
-	側の債務である。
-***************************************************************************/
-static uint32_t Wdt_calcOscCtrl(uint32_t freq, uint32_t div)
-{
-	/* UM10601 - 4.6.6 Watchdog oscillator control register参照 */
-	enum {
-		FREQ_POS		= 5,	/* FREQSELのビット位置 */
-		DIVSEL_OFFSET	= 2,	/* DIVSEL=0に相当する分周値 */
-		DIVSEL_RATE		= 2		/* DIVSELから分周値を求める時の係数 */
-	};
-
-	/* LPC810内蔵のWDTオシレータベース周波数(Hz) */
-	/* UM10601 - 4.6.6 Watchdog oscillator control register参照 */
-	const uint32_t freqsel[] = {
-		[WDTOSC_FREQ_DIS]		= 0,
-		[WDTOSC_FREQ_600KHZ]	= 600000,	/* 600kHz */
-		[WDTOSC_FREQ_1_05MHZ]	= 1050000,	/* 1.05MHz */
-		[WDTOSC_FREQ_1_40MHZ]	= 1400000,	/* 1.40MHz */
-		[WDTOSC_FREQ_1_75MHZ]	= 1750000,	/* 1.75MHz */
-		[WDTOSC_FREQ_2_10MHZ]	= 2100000,	/* 2.10MHz */
-		[WDTOSC_FREQ_2_40MHZ]	= 2400000,	/* 2.40MHz */
-		[WDTOSC_FREQ_2_70MHZ]	= 2700000,	/* 2.70MHz */
-		[WDTOSC_FREQ_3_00MHZ]	= 3000000,	/* 3.00MHz */
-		[WDTOSC_FREQ_3_25MHZ]	= 3250000,	/* 3.25MHz */
-		[WDTOSC_FREQ_3_50MHZ]	= 3500000,	/* 3.50MHz */
-		[WDTOSC_FREQ_3_75MHZ]	= 3750000,	/* 3.75MHz */
-		[WDTOSC_FREQ_4_00MHZ]	= 4000000,	/* 4.00MHz */
-		[WDTOSC_FREQ_4_20MHZ]	= 4200000,	/* 4.20MHz */
-		[WDTOSC_FREQ_4_40MHZ]	= 4400000,	/* 4.40MHz */
-		[WDTOSC_FREQ_4_60MHZ]	= 4600000	/* 4.60MHz */
-	};
-
-	Wdt_freq = freqsel[freq];
-	Wdt_div = div;
-	return (freq << FREQ_POS) | ((div - DIVSEL_OFFSET) / DIVSEL_RATE);
-}
-
-/***************************************************************************
-	Wdt_getMs
-	指定時間に対応するWDTカウンタ値の取得
-	※あらかじめWdt_calcOscCtrlを呼び出しておくこと
+	LPC_WWDT->WARNINT = INI_WARNINT;
+}
 
-	[引数]	ms	指定時間(ms)
-			max	カウンタ上限値
-	[戻値]	WDTカウンタ値
+/***************************************************************************
+	Wdt_calOsc
+	WDT用オシレータの周波数の較正
+	※Wdt_ini(Sys_iniLpc810)の後、Sup_addなどでWdt_msToCntを使う前に
+	　呼び出すこと
 
-	WDTオシレータの周波数(Hz)をベースに、指定時間(ms)をWDTカウンタ値に
-	変換する。
-	カウンタ上限値を超えたら上限値に丸める。
-	WDTの秒数は概して大きくなりがちなので、桁あふれしないようuint64_tを使用
-	している。
+	[引数]	なし
+	[戻値]	較正した(true), 較正できなかった(false)
+
+	WDT用オシレータの周波数は公称値(WWDT_FREQ)に対して±40%の誤差が規定
+	されているため、公称値から求めたタイムアウト時間も同じだけずれる。
+	本関数は、WDTカウンタ(TV)がCAL_MSに相当する値だけ減る時間をMRTのタイ
+	ムスタンプ(システムクロック数)で計測して実際の周波数を求め、
+	Wdt_getOscClk, Wdt_msToCnt, Wdt_cntToMs, Wdt_getRestMsが実際の値を返
+	すようにする。
+	さらにTC, WINDOW, WARNINTをWWDT_TIM_OUT, WWDT_TIM_GUARD, WWDT_TIM_WARN
+	の通りの時間になるよう設定し直し、WDTをクリアする。
+	TCはWWDT_CNT_MIN～WWDT_CNT_MAX、WARNINTはWWDT_WARN_MAXに丸める。
+
+	計測の基準はシステムクロックなので、その精度(内蔵オシレータなら±1.5%、
+	CLKINならその発振子の精度)で較正される。
+	計測中(最大CAL_TMO_MS)は割り込み禁止にする。起動時に1回だけ呼び出す
+	想定だが、周波数の計算も32ビットの除算だけで行う(64ビット除算の
+	__aeabi_uldivmodをリンクしないため)。途中で捨てる下位ビットによる誤差
+	は数ppm以下で、64ビットで計算した場合と実質変わらない。
+	MRTは計測の間だけ使う(他で使っていなければ、終了後にクロックを止める)。
+
+	以下の場合は較正せずにfalseを返す(公称値のまま動作を続ける)。
+	・メインクロックがWDT用オシレータ(基準にできない)
+	・WDTが停止している(WWDT_MODEにWWDT_WDENがない)
+	・CAL_TMO_MS以内に計測が終わらない、または計測値が公称値の1/2～2倍
+	　を外れる(オシレータの異常)
 ***************************************************************************/
-static uint32_t Wdt_getMs(uint32_t ms, uint32_t max)
+_Bool Wdt_calOsc(void)
 {
-	/* UM10601 - 12.6.4 Watchdog Timer Constant register参照 */
-	enum {
-		PRE_DIV		= 4,	/* プリスケーラの分周値(固定値) */
-		SEC_UINT	= 1000	/* カウンタ係数；1秒単位の場合は1、1ms単位の場合は1000... */
-	};
-
-	uint64_t cnt = ((uint64_t)Wdt_freq * ms) / (Wdt_div * PRE_DIV * SEC_UINT);
-	return (cnt > max)? max: (uint32_t)cnt;
+	Sys_clk		clk;
+	uint32_t	primask;
+	uint32_t	cnt = Wdt_msToCnt(CAL_MS);
+	uint32_t	tmo = Sys_msToTicks(CAL_TMO_MS);
+	uint32_t	tv, tv0, stamp, cyc;
+	uint32_t	osc, hz, rem, sft, freq;
+	uint32_t	nom = WDTOSC_FREQ_HZ(WWDT_FREQ);
+	uint32_t	pre = Wdt_div * PRE_DIV;
+
+	Sys_getClock(&clk);
+	if (((clk.mainSel & SYS_MAIN_CLK_SEL) == SYS_MAIN_CLK_WDTOSC)
+	 || ((LPC_WWDT->MOD & WWDT_WDEN) == 0)) {
+		return false;
+	}
+	Mrt_ini();
+
+	/* 計測中に満了しないようTVを最大にしておく */
+	/* ※ガード時間中のクリアを避けるため、計測の間はWINDOWを無効(最大)にする */
+	LPC_WWDT->WINDOW = WWDT_CNT_MAX;
+	Wdt_clr();
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	/* TVが変化した直後から数え始める(カウンタのクロックに同期) */
+	tv0 = LPC_WWDT->TV;
+	stamp = Mrt_getStamp();
+	do {
+		tv = LPC_WWDT->TV;
+		cyc = Mrt_getElapsed(stamp);
+	} while ((tv == tv0) && (cyc < tmo));
+	tv0 = tv;
+	stamp = Mrt_getStamp();
+
+	/* TVがcnt以上減るまでのシステムクロック数 */
+	do {
+		tv = LPC_WWDT->TV;
+		cyc = Mrt_getElapsed(stamp);
+	} while ((tv0 - tv < cnt) && (tv <= tv0) && (cyc < tmo));
+	__set_PRIMASK(primask);
+	Mrt_end();
+
+	/* 周波数 = 計測中のオシレータのクロック数 * システムクロック / cyc */
+	/* ※システムクロック / cycを整数部と余りに分け、余りの方は積が32ビット */
+	/* 　に収まるまで余りとcycの下位を捨てる */
+	freq = 0;	/* 時間切れ */
+	if ((tv <= tv0) && (tv0 - tv >= cnt) && (cyc != 0)) {
+		osc = (tv0 - tv) * pre;
+		hz = Sys_getSysClk();
+		rem = hz % cyc;
+		for (sft = 0; (rem >> sft) > UINT32_MAX / osc; sft++) {
+		}
+		freq = osc * (hz / cyc) + osc * (rem >> sft) / (cyc >> sft);
+	}
+	if ((freq < (nom >> CAL_LIM_SFT)) || (freq > (nom << CAL_LIM_SFT))) {
+		LPC_WWDT->WINDOW = INI_WINDOW;	/* 公称値のまま */
+		return false;	/* 計測できないか、仕様を大きく外れている */
+	}
+
+	/* 1ms当たりのカウンタ値はSys_lib.cと同じく逆数の乗算で1/1000を求める */
+	/* ※msPerCntとcntPerMsの積は2^(RATE_Q*2) */
+	Wdt_freq = freq;
+	Wdt_cntPerMs = (uint32_t)(((uint64_t)freq * RECIP_1000) >> (RECIP_1000_SFT - RATE_Q)) / pre;
+	Wdt_msPerCnt = UINT32_MAX / Wdt_cntPerMs;
+
+	/* 較正した周波数でTC, WINDOW, WARNINTを設定し直す */
+	cnt = Wdt_msToCnt(WWDT_TIM_OUT);
+	LPC_WWDT->TC = (cnt < WWDT_CNT_MIN)? WWDT_CNT_MIN: cnt;
+	Wdt_clr();
+	LPC_WWDT->WINDOW = Wdt_msToCnt(WWDT_TIM_OUT - WWDT_TIM_GUARD);
+	cnt = Wdt_msToCnt(WWDT_TIM_WARN);
+	LPC_WWDT->WARNINT = (cnt > WWDT_WARN_MAX)? WWDT_WARN_MAX: cnt;
+	return true;
 }
 
 /***************************************************************************
 	Wdt_getOscClk
 	WDT用オシレータの周波数取得
-	※あらかじめWdt_calcOscCtrlを呼び出しておくこと
+	※あらかじめWdt_iniを呼び出しておくこと
 
 	[引数]	なし
 	[戻値]	WDT用オシレータの周波数(Hz)を返す。
 
-	SYSCONユニットのWDTOSCCTRLレジスタの設定値より、最終的に選択される
+	WDTOSCCTRLレジスタに設定した周波数と分周値より、最終的に選択される
 	オシレータの周波数を求める。
+	Wdt_calOscで較正した後は、計測した周波数を返す。
 ***************************************************************************/
 uint32_t Wdt_getOscClk(void)
 {
@@ -213,10 +419,301 @@ uint32_t Wdt_getOscClk(void)
 	[戻値]	なし
 
 	WDTをクリアするので定期的に呼び出すこと。
+	学習中(Wdt_learnStart)は、クリアの前に前回のクリアからの間隔(TC－TV)
+	を記録する。
+	クリアの時間がクロック設定で変わらないよう、SRAMに配置する(RAMFUNC)。
+	学習中の記録(Wdt_record)はフラッシュに置いたままである。
+	core.hのWDT_LEARN_ENABLEが0の場合は記録しない(Wdt_record以降の学習の
+	処理はリンクされない)。
 ***************************************************************************/
-void Wdt_clr(void)
+RAMFUNC void Wdt_clr(void)
+{
+	if (WDT_LEARN_ENABLE && Wdt_lrn.run && Wdt_record(LPC_WWDT->TC - LPC_WWDT->TV)) {
+		return;		/* 学習結果を設定した(設定時にクリア済み) */
+	}
+	Wdt_feed();
+}
+
+/* WDTのクリア(FEEDシーケンスのみ、Wdt_clrと同じくSRAMに配置) */
+RAMFUNC static void Wdt_feed(void)
 {
 	/* UM10601 - 12.6.3 Watchdog Feed register参照 */
 	LPC_WWDT->FEED = 0xAA;
 	LPC_WWDT->FEED = 0x55;
 }
+
+/***************************************************************************
+	Wdt_msToCnt
+	指定時間に対応するWDTカウンタ値の取得
+	※あらかじめWdt_iniを呼び出しておくこと
+
+	[引数]	ms	指定時間(ms)
+	[戻値]	WDTカウンタ値(WWDT_CNT_MAXを超える場合はWWDT_CNT_MAX)
+
+	WDTオシレータの周波数(Hz)をベースに、指定時間(ms)をWDTカウンタ値に
+	変換する。
+	Wdt_iniで求めておいた1ms当たりのカウンタ値を掛けるだけなので、64ビット
+	除算(__aeabi_uldivmod)は使わない。
+	返す値はTC, WINDOW, WARNINTなどの設定や、TVとの比較にそのまま使える。
+	WARNINTに設定する場合は、WWDT_WARN_MAXを超えないよう呼び出し側で丸める
+	こと。
+***************************************************************************/
+uint32_t Wdt_msToCnt(uint32_t ms)
+{
+	uint64_t cnt = ((uint64_t)ms * Wdt_cntPerMs) >> RATE_Q;
+
+	return (cnt > WWDT_CNT_MAX)? WWDT_CNT_MAX: (uint32_t)cnt;
+}
+
+/***************************************************************************
+	Wdt_cntToMs
+	WDTカウンタ値に対応する時間の取得
+	※あらかじめWdt_iniを呼び出しておくこと
+
+	[引数]	cnt	WDTカウンタ値
+	[戻値]	時間(ms、切り捨て)
+
+	Wdt_msToCntの逆変換である。
+	TVの値を渡せば、WDT満了までの残り時間が得られる。
+***************************************************************************/
+uint32_t Wdt_cntToMs(uint32_t cnt)
+{
+	return ((uint64_t)cnt * Wdt_msPerCnt) >> RATE_Q;
+}
+
+/***************************************************************************
+	Wdt_isFeedable
+	WDTクリア可能か否かの判断
+
+	[引数]	なし
+	[戻値]	クリア可能(true), ガード時間中(false)
+
+	WDTカウンタ(TV)がウィンドウカウンタ(WINDOW)以下になるとクリア可能とな
+	る。ガード時間中にクリアするとWDT満了と同じ扱いになるので、クリアのタイ
+	ミングが定まらない場合は本関数で確認してからクリアすること。
+	※UM10601 - 12.5.3 Watchdog timer window
+***************************************************************************/
+_Bool Wdt_isFeedable(void)
+{
+	return (LPC_WWDT->TV <= LPC_WWDT->WINDOW)? true: false;
+}
+
+/***************************************************************************
+	Wdt_getRestMs
+	WDT満了までの残り時間の取得
+	※あらかじめWdt_iniを呼び出しておくこと
+
+	[引数]	なし
+	[戻値]	残り時間(ms)、WDT停止中の場合はUINT32_MAX
+
+	この時間内にWdt_clrを呼び出さないとWDT満了となる。
+	警告割り込みはこれよりWWDT_TIM_WARNだけ早く発生する。
+***************************************************************************/
+uint32_t Wdt_getRestMs(void)
+{
+	if ((LPC_WWDT->MOD & WWDT_WDEN) == 0) {
+		return UINT32_MAX;
+	}
+	return Wdt_cntToMs(LPC_WWDT->TV);
+}
+
+/***************************************************************************
+	Wdt_getCrash
+	警告割り込み時の記録の取得
+
+	[引数]	crash	記録の格納先
+	[戻値]	記録あり(true), なし(false)
+
+	最後に警告割り込みが発生した時に割り込まれていた箇所を返す。
+	記録はリセットをまたいで残るので、WDT満了でリセットされた後でも読める。
+	Sys_getRstInfoでリセット要因がWDTだったことを確認してから使うとよい。
+	電源投入直後やWdt_clrCrash後は記録なしとなる。
+***************************************************************************/
+_Bool Wdt_getCrash(Wdt_crash *crash)
+{
+	if (Wdt_crashMagic != CRASH_MAGIC) {
+		return false;
+	}
+	*crash = Wdt_crashRec;
+	return true;
+}
+
+/***************************************************************************
+	Wdt_clrCrash
+	警告割り込み時の記録の消去
+
+	[引数]	なし
+	[戻値]	なし
+
+	Wdt_getCrashで読み出した記録を処理済みとする場合に呼び出す。
+***************************************************************************/
+void Wdt_clrCrash(void)
+{
+	Wdt_crashMagic = 0;
+}
+
+/***************************************************************************
+	Wdt_learnStart
+	クリア間隔の学習開始
+	※Wdt_ini(Wdt_calOscで較正するならその後)の後に呼び出すこと
+
+	[引数]	num	自動で設定するまでの記録回数(0なら記録のみ)
+	[戻値]	なし
+
+	記録をクリアして学習を始める。以降のWdt_clr(Sup_feed経由も含む)毎に、
+	前回のクリアからの間隔をWDTカウンタ値で記録する。間隔はTC－TVなので、
+	タイマなどは使わない。
+	ヒストグラムの区間幅は、WWDT_TIM_OUTがWDT_HIST_NUM区間に収まる2の
+	べき乗とする(除算を使わないため)。
+	num回記録した時点で、そのWdt_clrの中でWdt_learnApplyと同じ設定を行い、
+	学習を終える。
+	既に学習結果を設定していた場合は、TC, WINDOWをWWDT_TIM_OUT,
+	WWDT_TIM_GUARDの通りに戻してWDTをクリアしてから学習し直す(クリアの
+	間隔が変わる場合、例えばSysTickの周期を変えた場合に使う)。
+	WDTが停止している(WWDT_MODEにWWDT_WDENがない)場合、またはcore.hの
+	WDT_LEARN_ENABLEが0の場合は何もしない。
+***************************************************************************/
+void Wdt_learnStart(uint32_t num)
+{
+	uint32_t	primask;
+	uint32_t	i;
+
+	if (!WDT_LEARN_ENABLE || (LPC_WWDT->MOD & WWDT_WDEN) == 0) {
+		return;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	Wdt_lrn.cnt = 0;
+	Wdt_lrn.min = 0;
+	Wdt_lrn.max = 0;
+	for (i = 0; i < WDT_HIST_NUM; i++) {
+		Wdt_lrn.hist[i] = 0;
+	}
+	Wdt_lrnTc = Wdt_msToCnt(WWDT_TIM_OUT);
+	Wdt_lrnTc = (Wdt_lrnTc < WWDT_CNT_MIN)? WWDT_CNT_MIN: Wdt_lrnTc;
+	Wdt_lrnLead = Wdt_msToCnt(WWDT_TIM_WARN + WDT_LEARN_LEAD_MS);
+	for (Wdt_lrn.sft = 0; (Wdt_lrnTc >> Wdt_lrn.sft) >= WDT_HIST_NUM; Wdt_lrn.sft++) {
+		/* 区間幅を広げる */
+	}
+	if (Wdt_lrn.applied) {
+		LPC_WWDT->WINDOW = WWDT_CNT_MAX;
+		LPC_WWDT->TC = Wdt_lrnTc;
+		Wdt_feed();
+		LPC_WWDT->WINDOW = Wdt_msToCnt(WWDT_TIM_OUT - WWDT_TIM_GUARD);
+	}
+	Wdt_lrnNum = num;
+	Wdt_lrn.applied = false;
+	Wdt_lrn.run = true;
+	__set_PRIMASK(primask);
+}
+
+/***************************************************************************
+	Wdt_learnApply
+	学習結果の設定
+
+	[引数]	なし
+	[戻値]	設定した(true), 学習中でないか記録が無い(false)
+
+	学習を終え、記録した間隔から以下を求めてTC, WINDOWに設定し、WDTをク
+	リアする(WARNINTはそのまま)。余裕はWDT_LEARN_MARGIN_SFTで決まる。
+
+	・TC(タイムアウト):		最長間隔＋余裕＋WWDT_TIM_WARN＋WDT_LEARN_LEAD_MS
+	・TC－WINDOW(ガード時間):	最短間隔－余裕
+
+	TCに警告割り込みまでの時間を加えるのは、最長間隔でのクリアも警告割り
+	込みの前に済むようにするため(Idle_runは警告割り込みの前に起床する)。
+	ただし、TCはWWDT_TIM_OUTを超えないようにし、クリア可能な期間(WINDOW)
+	はWWDT_TIM_WARN＋WDT_LEARN_LEAD_MS以上残す。
+	ハングはTC、暴走した高速ループ(ガード時間中のクリア)はWINDOWで、それ
+	ぞれ静的な設定より早く検出できるようになる。
+	学習中の動作(割り込み処理からのクリアなど)がすべて記録に含まれるだけ
+	の回数を学習してから呼び出すこと。
+***************************************************************************/
+_Bool Wdt_learnApply(void)
+{
+	uint32_t	primask;
+	_Bool		ret;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	ret = Wdt_apply();
+	__set_PRIMASK(primask);
+	return ret;
+}
+
+/***************************************************************************
+	Wdt_getLearn
+	クリア間隔の学習結果の取得
+
+	[引数]	learn	記録の格納先
+	[戻値]	なし
+
+	学習中でも読める(割り込み禁止にして写す)。
+	間隔はWDTカウンタ値なので、msにはWdt_cntToMsで換算する。
+	ヒストグラムのi番目の区間は、間隔が(i << sft)～((i + 1) << sft) - 1
+	のものである。
+***************************************************************************/
+void Wdt_getLearn(Wdt_learn *learn)
+{
+	uint32_t	primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	*learn = Wdt_lrn;
+	__set_PRIMASK(primask);
+}
+
+/* クリア間隔の記録(Wdt_clrから呼ぶ、学習結果を設定したらtrue、SRAMに展開されないようnoinline) */
+__attribute__ ((noinline)) static _Bool Wdt_record(uint32_t cnt)
+{
+	uint32_t	primask;
+	uint32_t	bin = cnt >> Wdt_lrn.sft;
+	_Bool		ret = false;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if ((Wdt_lrn.cnt == 0) || (cnt < Wdt_lrn.min)) {
+		Wdt_lrn.min = cnt;
+	}
+	if (cnt > Wdt_lrn.max) {
+		Wdt_lrn.max = cnt;
+	}
+	Wdt_lrn.hist[(bin < WDT_HIST_NUM)? bin: WDT_HIST_NUM - 1]++;
+	Wdt_lrn.cnt++;
+	if ((Wdt_lrnNum != 0) && (Wdt_lrn.cnt >= Wdt_lrnNum)) {
+		ret = Wdt_apply();
+	}
+	__set_PRIMASK(primask);
+	return ret;
+}
+
+/* 学習結果の設定(割り込み禁止で呼ぶこと) */
+static _Bool Wdt_apply(void)
+{
+	uint32_t	tc, guard;
+
+	if (!Wdt_lrn.run || (Wdt_lrn.cnt == 0)) {
+		return false;
+	}
+	Wdt_lrn.run = false;
+
+	tc = Wdt_lrn.max + (Wdt_lrn.max >> WDT_LEARN_MARGIN_SFT) + Wdt_lrnLead;
+	guard = Wdt_lrn.min - (Wdt_lrn.min >> WDT_LEARN_MARGIN_SFT);
+	if (tc > Wdt_lrnTc) {
+		tc = Wdt_lrnTc;
+	}
+	if (tc < WWDT_CNT_MIN) {
+		tc = WWDT_CNT_MIN;
+	}
+	if (tc < guard + Wdt_lrnLead) {
+		guard = (tc > Wdt_lrnLead)? tc - Wdt_lrnLead: 0;
+	}
+
+	/* ガード時間中のクリアを避けるため、クリアの間はWINDOWを無効(最大)にする */
+	LPC_WWDT->WINDOW = WWDT_CNT_MAX;
+	LPC_WWDT->TC = tc;
+	Wdt_feed();
+	LPC_WWDT->WINDOW = tc - guard;
+	Wdt_lrn.applied = true;
+	return true;
+}
@@ -26,7 +26,18 @@
 		WWDT_TIM_GUARD	WDTクリアガード時間
 		WWDT_TIM_WARN	WDT警告割り込み発生時間
 
+	・使用例の選択(LPC810のフラッシュ4KB, SRAM 1KBに収めるため)
+		SAMPLE_SYSTICK		SysTick割り込みと負荷の計測
+		SAMPLE_BLINK		SCTによるLED_BLINKの点滅
+		SAMPLE_WDT_CAL		WDT用オシレータの較正
+		WDT_LEARN_ENABLE	WDTクリアの間隔の学習
+		PROF_ENABLE			Evt_runの処理時間の計測
+		UART_ENABLE			USART0の使用
+
 	これらシンボルについてはcore.h内で詳しく説明している。
+	既定では使用例の選択はSAMPLE_BLINK(1: 最小の点滅)以外は全て0で、
+	make -C host romsizeで4KBに収まることを確認している(残りは数バイト
+	しかない)。
 
 	Sys_lib.cに動作クロックの設定を行う関数を含めている。
 	以下にその一覧を示す。
@@ -42,25 +53,205 @@
 			従来はSystemCoreClockを直接見ていたが、情報の隠蔽化を図るため
 			関数化した。
 			なお、従来通りSystemCoreClockを直接見ることも可能である。
+		・Sys_setClock
+			動作中にクロック構成を切り替える。
+		・Sys_getClock
+			現在のクロック構成を取得する。
+		・Sys_addClkNotify
+			クロック変更時に呼び出す関数を登録する。
+			本サンプルではSysTickの再設定(startSysTick)を登録している
+			(core.hのSAMPLE_SYSTICKが1の場合)。
+		・Sys_msToTicks
+			時間(ms)をシステムクロック数に換算する(除算を使わない)。
+		・Sys_getBootTim
+			Sys_iniLpc810内の各段階の所要時間(.noinitに記録)を取得する。
+		・Sys_getRstInfo
+			リセット要因と要因毎のリセット回数(.noinitに記録)を取得する。
+		・Sys_acqClk, Sys_relClk
+			ペリフェラルへのクロック供給を参照数付きで要求・返却する。
+			本サンプルではSWMをピン配置の設定後に返して止めている。
 		・SystemCoreClockUpdate
 			互換性のため残してある。ただし、Sys_iniLpc810内でSystemCoreClock
 			の初期設定も行っているので、本関数は、もはや何もしてない。
 
+	Swm_lib.cにスイッチマトリクスによるピン配置の関数を含めている。
+	以下にその一覧を示す。
+	ピン配置はcore.hのSWM_PIN_MAPに表として書き、重複などはビルド時に調べ
+	る。
+
+		・Swm_ini
+			ピン配置表の通りにピンを割り当てる。
+			従来のSwitchMatrix_Init(Switch Matrix Toolの出力)を置き換えるもの。
+		・Swm_assign, Swm_release
+			動作中に機能をピンに割り当てる、割り当てを外す。
+			ピンが他の機能に使われていれば割り当てない。
+		・Swm_getPin, Swm_getFunc
+			機能を割り当てたピン、ピンに割り当てた機能を取得する。
+
 	Wdt_lib.cにウォッチドッグタイマ関連の関数を含めている。
 	以下にその一覧を示す。
 
 		・Wdt_ini
 			WDTユニットを初期化するとともに(必要ならば)動作開始させる。
+		・Wdt_calOsc
+			WDT用オシレータの実際の周波数をシステムクロックで計測し、タイム
+			アウト時間などをその周波数に合わせる(公称値は±40%ずれうる)。
 		・Wdt_getOscClk
 			現在のWDT用オシレータの周波数を取得する。
 		・Wdt_clr
 			WDTのクリアを行う。
+		・Wdt_learnStart, Wdt_getLearn
+			WDTクリアの間隔を学習し、学習した間隔に合わせてタイムアウトと
+			ガード時間を狭める。本サンプルではsetupで開始し、SysTickの周期
+			を延ばした時に学習し直す。
+		・Wdt_getCrash
+			警告割り込みで割り込まれた箇所(PC, LR, xPSR)を取得する。
+			WDT満了でリセットされた後でも読める。
 		・Wdt_procWarn
 			WDT警告割り込み時の処理関数。
 			警告割り込みを使用する場合は、本関数の名前で定義しておく必要が
 			ある(サンプルとして本ファイル内で定義している)。
 			使用しない場合は定義の必要はない。
 
+	Idle_lib.cに低消費電力待機の関数を含めている。
+	以下にその一覧を示す。
+
+		・Idle_ini
+			起床用のセルフウェイクアップタイマ(WKT)を初期化する。
+		・Idle_run
+			WDTをクリア(Sup_feed)し、次の起床要因(SysTick割り込み、WDTクリア期限)まで
+			スリープ、またはディープスリープで待機する。
+			main()の定常ループは、本関数で待機するだけで空回りはしない。
+			本サンプルでは既定(core.hのSAMPLE_SYSTICKが0)でSysTickを使わない
+			ので、監視タスク(SUP_MAIN_MS)の期限前のWKTかIN_PORTのピン割り込
+			みまで待機する。既定(SAMPLE_BLINKが1)ではSCTでLED_BLINKを点滅さ
+			せるのでスリープで、SAMPLE_BLINKも0ならディープスリープかパワー
+			ダウンで待機する。
+
+	Sup_lib.cにWDT監視(スーパーバイザ)の関数を含めている。
+	以下にその一覧を示す。
+
+		・Sup_add
+			監視するタスクを期限(ms)付きで登録する。
+			本サンプルでは定常処理(main)と、SAMPLE_SYSTICKが1の場合はSysTick
+			割り込みを登録している。
+		・Sup_setMs
+			監視タスクの期限を変更する。
+			本サンプルではSysTickの周期を延ばした時(startSysTick)に使う。
+		・Sup_chk
+			タスクの生存報告を行う。
+		・Sup_feed
+			全タスクが期限内に報告済みの場合のみWDTをクリアする。
+			Idle_run内から呼び出される。
+		・Sup_getMissed
+			報告の無かったタスクを取得する。
+
+	Pint_lib.cにピン割り込みの関数を含めている。
+	以下にその一覧を示す。
+
+		・Pint_add
+			ピン番号と検出条件(エッジ/レベル)、検出時の関数を登録する。
+			本サンプルではIN_PORTのLレベル検出を登録している。
+		・Pint_start
+			検出を開始(再開)する。
+		・Pint_stop
+			検出を停止する。
+
+	Iocon_lib.cにピン設定(IOCON)の関数を含めている。
+	以下にその一覧を示す。
+
+		・Iocon_setPin, Iocon_getPin
+			ピンのプルアップ/ダウン、ヒステリシス、オープンドレイン、入力フ
+			ィルタを設定、取得する。
+			本サンプルではIN_PORTにヒステリシスだけを設定している(入力フィ
+			ルタはディープスリープ中に止まるので、ピン割り込みの起床要因に
+			は使わない)。
+		・Iocon_setClkDiv, Iocon_setSampleUs
+			入力フィルタのクロック(IOCONCLKDIV0～6)を分周値、または周期(us)
+			で設定する。周期で設定した場合は、クロック変更後も同じ周期に保つ。
+
+	Sct_lib.cにSCTによるPWM・点滅出力の関数を含めている。
+	以下にその一覧を示す。
+	設定後はSCTだけで波形を作るので、CPUも割り込みも使わない。
+
+		・Sct_ini, Sct_stop
+			SCTを開始(周期を設定)、停止する。周期は全チャネルで共通。
+		・Sct_setPeriod
+			周期を変更する。
+		・Sct_setPwm
+			周期の先頭から指定時間だけH出力する(デューティの変更は次の周期
+			から反映し、波形は乱れない)。
+			本サンプルではLED_BLINKの点滅に使っている(SAMPLE_BLINKが2の場合)。
+		・Sct_setBlink
+			変化点の時間を並べた点滅パターンを出力する。
+
+	Evt_lib.cに割り込みからmain側へのイベントキューの関数を含めている。
+	以下にその一覧を示す。
+
+		・Evt_addQue
+			イベントキューを登録する(書き込む割り込み処理毎に1本)。
+		・Evt_setFunc
+			イベント番号毎の処理関数を登録する。
+		・Evt_post
+			割り込み処理からイベントを積む(割り込み禁止にしない)。
+		・Evt_run
+			溜まったイベントをmain側でまとめて処理する。
+		・Evt_isEmpty
+			未処理のイベントが無いかを返す。Idle_runの直前に確認する。
+
+	Uart_lib.cにUSART0を割り込みで送受信する関数を含めている。
+	以下にその一覧を示す。
+	本サンプルのピン配置では空きピンが無いため使用していない。使用する場合
+	はcore.hのSWM_PIN_MAPか、Swm_assignでSWM_U0_TXD, SWM_U0_RXDをピンに割
+	り当ててから、Uart_iniを呼び出す。
+
+		・Uart_ini
+			USART0を初期化する。伝送速度はメインクロックから誤差が最小とな
+			るよう設定し、クロック変更時も設定し直す(Sys_addClkNotify)。
+		・Uart_send, Uart_puts
+			送信バッファに積むだけで、送信完了は待たない。
+		・Uart_recv
+			受信バッファから受信済みのデータを取り出す。
+		・Uart_isTxIdle
+			送信がすべて完了したかを返す。
+
+	Mrt_lib.cにマルチレートタイマ(MRT)によるタイムスタンプの関数を含めて
+	いる。
+	以下にその一覧を示す。
+
+		・Mrt_ini
+			MRTの1チャネルをフリーランで開始する(Wdt_calOsc, Prof_ini内で呼び
+			出される)。
+		・Mrt_getStamp
+			タイムスタンプ(システムクロック数)を取得する。
+		・Mrt_getElapsed
+			タイムスタンプからの経過クロック数を取得する。
+
+	Gpio_lib.hにGPIOの入出力のインライン関数を含めている(.cは無い)。
+	以下にその一覧を示す。
+	どれもレジスタへの1回のロードかストアに展開される。
+
+		・Gpio_set, Gpio_clr, Gpio_tgl
+			ビットパターンで指定したピンをH出力、L出力、反転出力する。
+		・Gpio_wrPin, Gpio_rdPin, Gpio_rdPinW
+			ピン番号で指定した1ピンを出力、入力する。
+		・Gpio_setMask, Gpio_wrMasked, Gpio_rdMasked
+			マスクで指定したピンだけをまとめて出力、入力する。
+
+	Prof_lib.cに区間毎の処理時間計測の関数を含めている。
+	以下にその一覧を示す。
+	本サンプルではmain()のEvt_runを計測しており、デバッガからProf_getStat
+	を呼び出せば最小・最大・平均のクロック数を確認できる。
+
+		・Prof_ini
+			計測を準備する(MRTの開始と、計測そのもののクロック数の計測)。
+		・Prof_add
+			計測区間を名前付きで登録する。
+		・PROF_BEGIN, PROF_END
+			区間の開始と終了。core.hのPROF_ENABLEを0にすると消える。
+		・Prof_getStat, Prof_clr
+			区間の計測結果(回数、最小、最大、平均)を取得、クリアする。
+
 	本サンプルプログラム(main.c)では、これらの関数の使用方法を示している。
 
 	このサンプルプログラムで使用するマイコンはLPC810を想定しており、以下の
@@ -80,21 +271,28 @@
 	1	PIO0_5	GPIO出力ポートとして使用。各種情報を出力(LED_INFO)。
 	2	PIO0_4	GPIO入力ポートとして使用。ロックアップテスト用(IN_PORT)。
 	5	CLKIN	クロック選択でソースクロックをCLKINとした場合に使用する。
-	8	PIO0_0	GPIO出力ポートとして使用。定期的に点滅出力(LED_SYSTICK)。
+	8	PIO0_0	CTOUT_0として使用。SCTで定期的に点滅出力(LED_BLINK)。
 
 	・LED_INFO
-		システムクロックの変化を見るため、一定のカウント毎にL/Hをトグル出力
-		する。
-		また、ウォッチドッグタイマ警告割り込みが発生した時にも、本ポートにH
-		出力する。
-		LEDをつなげば、クロックに応じて点滅の速度が変化するだろう。
-		また、IN_PORTでロックアップ状態にしていた場合は、ウォッチドッグタイ
-		マの満了も目視できる(ロックアップ状態で消灯～リセット時に一瞬点く)。
-
-	・LED_SYSTICK
-		SysTick割り込みを使って、割り込み発生毎にL/Hをトグル出力している。
-		LEDをつなげば、クロック設定に関わらずに一定の周期で点滅表示するだろ
-		う。
+		ウォッチドッグタイマ警告割り込みが発生した時に、本ポートにH出力する。
+		IN_PORTでロックアップ状態にしていた場合は、ウォッチドッグタイマの満
+		了を目視できる(ロックアップ状態で消灯～警告割り込みで点灯～リセット)。
+
+	・LED_BLINK
+		SCTのPWM出力で、LED_BLINK_PERIOD_MSの周期で点滅させている。LEDを
+		つなげば、クロック設定に関わらずに一定の周期で点滅表示するだろう。
+		既定(core.hのSAMPLE_BLINKが1)では、startBlinkがSCTのレジスタを直
+		接設定するだけで、Sct_libはリンクしない(4KBに収めるため)。動作中
+		にクロックを切り替えると周期がずれる。SAMPLE_BLINKを2にすると
+		Sct_libを使い、クロック変更時も設定し直す。
+		点滅はSCTだけで行うので、SysTick割り込みの周期が延びても、IN_PORT
+		でロックアップ状態にしている間も点滅し続ける(ロックアップはLED_INFO
+		とウォッチドッグタイマで確認する)。
+		SCTはシステムクロックで動くので、Idle_runはディープスリープせずに
+		スリープで待機する。待機中の消費電流を下げたい場合は、SAMPLE_BLINK
+		を0にする(点滅しない)。
+		LED_INFOは割り込みやイベントで点灯・消灯するだけなので、GPIOのまま
+		にしている。
 
 	・IN_PORT
 		ウォッチドッグタイマのテスト用として、L入力があった時に擬似的なロッ
@@ -102,6 +300,15 @@
 		本ポートは内部でプルアップされているので、オープンしておけば通常動
 		作となる。
 		ロックアップ状態にしたい場合は、本ポートをGNDにつなぐ。
+		本ポートはピン割り込み(Lレベル検出)で監視しているので、main()が待機
+		中でもL入力で直ちに起床する。
+		ノイズ対策として、ヒステリシス(IOCON)を有効にしている。
+		入力フィルタ(IOCON_S_MODE_nCLOCK)は使わず、バイパスしている。入力
+		フィルタはIOCONCLKDIVのクロック(メインクロック)で動くので、ディー
+		プスリープ中は止まり、ピン割り込みの起床要因には使えないためである
+		(フィルタを通した入力が変化しなくなる)。
+		短いグリッチでピン割り込みが起きても、evtInLowはGPIOを読んでL入力
+		の間だけ止まるので、すぐに検出を再開する(LED_INFOを消すだけ)。
 
 	・CLKIN
 		ソースクロックとして本ポートからの入力を使うことも可能である。
@@ -112,10 +319,43 @@
 
 	変更履歴
 	2014.06.07: mits: 新規作成
+	2026.10.16: mits: クロック変更時にSysTickを再設定するようにした
+	2026.10.16: mits: SysTickのtick数をSys_msToTicksで求めるようにした
+	2026.10.16: mits: main()の空回りをやめ、Idle_runで待機するようにした
+	2026.10.16: mits: 定常処理とSysTick割り込みをSup_libで監視するようにした
+	2026.10.16: mits: IN_PORTをポーリングせず、ピン割り込みで検出するようにした
+	2026.10.16: mits: SysTick割り込みの負荷を計測し、周期を自動調整するようにした
+	2026.10.16: mits: 割り込み内の処理をEvt_libのイベントでmain側へ移した
+	2026.10.16: mits: Evt_runの処理時間をProf_libで計測するようにした
+	2026.10.16: mits: WDT用オシレータの周波数を起動時に較正するようにした
+	2026.10.16: mits: WDTクリアの間隔を学習してタイムアウトとガード時間を狭めるようにした
+	2026.10.16: mits: ペリフェラルのクロック供給をSys_acqClk, Sys_relClkで行い、SWMは設定後に止めるようにした
+	2026.10.16: mits: SysTick_Handler, setPortをSRAMに配置(RAMFUNC)
+	2026.10.16: mits: setPortをGpio_libのインライン関数に置き換えた
+	2026.10.16: mits: SwitchMatrix_InitをSwm_lib(core.hのSWM_PIN_MAP)に置き換えた
+	2026.10.16: mits: IN_PORTにヒステリシスと入力フィルタを設定(Iocon_lib)
+	2026.10.16: mits: LED_SYSTICKのトグルをやめ、SCTでLED_BLINKを点滅させるようにした(Sct_lib)
+	2026.10.16: mits: SysTickの使用例をcore.hのSAMPLE_SYSTICKで選ぶようにした(既定はディープスリープで待機)
+	2026.10.16: mits: LED_BLINKの点滅もcore.hのSAMPLE_BLINKで選ぶようにした
+	2026.10.16: mits: IN_PORTの入力フィルタをバイパスした(ピン割り込みでの起床のため)
+	2026.10.16: mits: WDTの較正・学習、処理時間の計測をcore.hのスイッチで選ぶようにした(4KBに収めるため)
+	2026.10.16: mits: SysTick割り込みの負荷の合計が桁あふれしないようにし、間隔をLOAD＋1で記録するようにした
+	2026.10.16: mits: setupのWDTクリアをガード時間外に限った(WWDT_TIM_GUARDが0以外の構成で満了していた)
+	2026.10.16: mits: SysTickの周期を延ばしたら監視の期限も延ばし、負荷の計測の1クロックのずれを直した
+	2026.10.16: mits: LED_BLINKの点滅を既定に戻した(SCTのレジスタを直接設定するstartBlink、Sct_libはSAMPLE_BLINKが2の場合)
 ***************************************************************************/
 #include	"core.h"
 #include	"Sys_lib.h"		/* for Sys_* */
 #include	"Wdt_lib.h"		/* for Wdt_* */
+#include	"Idle_lib.h"	/* for Idle_* */
+#include	"Sup_lib.h"		/* for Sup_* */
+#include	"Pint_lib.h"	/* for Pint_* */
+#include	"Evt_lib.h"		/* for Evt_* */
+#include	"Prof_lib.h"	/* for Prof_*, PROF_* */
+#include	"Gpio_lib.h"	/* for Gpio_* */
+#include	"Swm_lib.h"		/* for Swm_ini */
+#include	"Iocon_lib.h"	/* for Iocon_* */
+#include	"Sct_lib.h"		/* for Sct_* */
 
 /***************************************************************************
 	ローカル定義
@@ -123,27 +363,92 @@
 
 /*** 各GPIO毎の機能割り当て ***/
 enum {
-	LED_SYSTICK	= 0x1<<0,	/* P0_0をSysTickでの点滅表示で使う */
 	IN_PORT		= 0x1<<4,	/* P0_4を入力ポートとして使う */
 	LED_INFO	= 0x1<<5	/* P0_5を警告表示で使う */
 };
 
-/*** GPIO出力の指示 ***/
-typedef enum Gpio_bit {
-	GPIO_CLR	= 0,	/* ビットクリア */
-	GPIO_SET	= 1,	/* ビットセット */
-	GPIO_TOGGLE	= 2		/* ビットトグル */
-} Gpio_bit;
+/*** ピン割り込みで監視するピン番号 ***/
+enum {
+	IN_PIN		= 4		/* P0_4(IN_PORT) */
+};
+
+/*** IN_PORTの入力設定(IOCON) ***/
+enum {
+	/* ピン割り込みでディープスリープから起床するので、入力フィルタはバイパス */
+	IN_CFG		= IOCON_MODE_PULL_UP | IOCON_HYS_ON | IOCON_S_MODE_BYPASS
+};
+
+/*** LED_BLINKの点滅(SCT、P0_0はcore.hのSWM_PIN_MAPでCTOUT_0に割り当て) ***/
+enum {
+	LED_BLINK_CH		= 0,	/* SCTの出力チャネル(CTOUT_0) */
+	LED_BLINK_PERIOD_MS	= 500,	/* ms; 点滅周期 */
+	LED_BLINK_HIGH_MS	= 250	/* ms; 点灯時間 */
+};
+
+/*** イベント番号(Evt_lib) ***/
+enum {
+	EVT_TICK_SLOW	= 0,	/* SysTick割り込み: 負荷が上限を超えたので周期の再設定 */
+	EVT_IN_LOW				/* ピン割り込み: IN_PORTのL入力(ロックアップ) */
+};
+
+/*** WDT監視タスクの期限 ***/
+enum {
+	SUP_MAIN_MS	= 1000,	/* ms; 定常処理(main) */
+	SUP_TICK_MS	= 1000,	/* ms; SysTick割り込み(SYSTICK_MSの4倍、周期を延ばしたらstartSysTickで延ばす) */
+	SUP_TICK_SFT	= 2		/* SysTick割り込みの期限は周期の2^SUP_TICK_SFT(4)倍以上 */
+};
+
+/*** WDTクリア間隔の学習 ***/
+enum {
+	WDT_LEARN_NUM	= 32	/* 学習するWDTクリアの回数(SYSTICK_MS毎のクリアで約8秒) */
+};
+
+/*** SysTick割り込みの周期 ***/
+enum {
+	SYSTICK_MS			= 250,	/* ms; SysTick割り込みの起動間隔(希望値) */
+	SYSTICK_LOAD_PCT	= 10,	/* %; 割り込み間隔に対する割り込み処理時間の上限 */
+	SYSTICK_LOAD_MUL	= (100 + SYSTICK_LOAD_PCT - 1) / SYSTICK_LOAD_PCT,	/* 割り込み間隔の処理時間に対する最小倍率 */
+	SYSTICK_ISR_CYC		= 100,	/* 割り込み処理時間の見積もり(クロック数)、実測値で更新する */
+	SYSTICK_LOAD_WIN	= 128	/* 負荷の平均を取る割り込み回数(達したら合計と回数を半分にする) */
+};
+
+_Static_assert(((uint32_t)SYSTICK_MS << SUP_TICK_SFT) <= (uint32_t)SUP_TICK_MS, "SUP_TICK_MS is shorter than 4 SysTick periods");
+
+/*** SysTick割り込みの負荷の計測値 ***/
+typedef struct Tick_load {
+	uint32_t	cnt;		/* 割り込み回数(SYSTICK_LOAD_WIN未満) */
+	uint32_t	isrCyc;		/* 割り込み処理時間の合計(クロック数、cnt回分) */
+	uint32_t	isrMax;		/* 割り込み処理時間の最大値(クロック数) */
+	uint32_t	period;		/* 割り込み間隔(クロック数) */
+} Tick_load;
+
+/***************************************************************************
+	ローカル変数
+***************************************************************************/
+static uint32_t	SupMain;	/* WDT監視タスク番号: 定常処理(main) */
+static uint32_t	SupTick;	/* WDT監視タスク番号: SysTick割り込み */
+static uint32_t	InCh;		/* IN_PORTのピン割り込みチャネル */
+static volatile Tick_load	TickLoad = { 0, 0, SYSTICK_ISR_CYC, 0 };	/* SysTick割り込みの負荷 */
+static Evt_que	TickQue;	/* イベントキュー: SysTick割り込み */
+static Evt_que	PintQue;	/* イベントキュー: ピン割り込み */
+static Prof_sec	ProfEvt;	/* 処理時間の計測区間: Evt_run */
 
 /***************************************************************************
 	ローカル関数
 ***************************************************************************/
 static void setup(void);
-static void SwitchMatrix_Init(void);
 static void startSysTick(void);
 static void iniPort(void);
-static void setPort(uint32_t pat, Gpio_bit act);
+static void startBlink(void);
 static _Bool getGpioIsLow(void);
+static void procInLow(uint32_t ch, _Bool rise);
+static void evtTickSlow(uint32_t arg);
+static void evtInLow(uint32_t arg);
+
+/***************************************************************************
+	グローバル関数(デバッガなどから呼び出す)
+***************************************************************************/
+uint32_t getTickLoad(void);
 
 /***************************************************************************
 	main
@@ -153,27 +458,23 @@ static _Bool getGpioIsLow(void);
 ***************************************************************************/
 int main(void)
 {
-	enum {
-		LOAD_CNT = 0xffff	/* システムクロックの処理速度を測るためのカウンタ値 */
-	};
-	uint32_t load_cnt = LOAD_CNT;
-
 	setup();
 
 	for (;;) {
-		/* 適当な回数数えたら点滅表示 */
-		if (++load_cnt >= LOAD_CNT) {
-			load_cnt = 0;
-			setPort(LED_INFO, GPIO_TOGGLE);
+		/* 割り込みから届いたイベントの処理 */
+		PROF_BEGIN(ProfEvt);
+		Evt_run();
+		PROF_END(ProfEvt);
+
+		/* 生存報告して次の起床要因まで待機(WDTクリアもIdle_run内で行う) */
+		Sup_chk(SupMain);
+		__disable_irq();
+		if (!Evt_isEmpty()) {
+			__enable_irq();		/* 確認後に届いていた場合は待機しない */
 		}
-		/* GPIOでLow指定されたらロックアップ */
-		if (getGpioIsLow()) {
-			setPort(LED_INFO, GPIO_CLR);
-			while (getGpioIsLow()) {
-				;
-			}
+		else {
+			Idle_run(IDLE_FOREVER);
 		}
-		Wdt_clr();
 	}
 	return 0 ;
 }
@@ -187,44 +488,43 @@ int main(void)
 ***************************************************************************/
 static void setup(void)
 {
-	SwitchMatrix_Init();	/* 本システムのピン配置を設定 */
+	Swm_ini();				/* 本システムのピン配置を設定(core.hのSWM_PIN_MAP) */
 	iniPort();				/* デバッグ用途もあるので最初にGPIOを初期化 */
 	Sys_iniLpc810();		/* システム初期化(クロック選択とWDTの開始) */
-	startSysTick();			/* SysTickタイマを開始 */
-	Wdt_clr();
-}
-
-/***************************************************************************
-	SwitchMatrix_Init
-	本マイコンのピン配置の初期化
-	※Switch Matrix Tool(以下)の吐き出したものをそのまま使用
-		http://www.lpcware.com/content/nxpfile/nxp-switch-matrix-tool-lpc800
-
-	[引数]	なし
-	[戻値]	なし
-
-	本ファームウェアでは以下のピン配置で使用する。
-
-	           ┌─Ｕ─┐
-	    PIO0_5 □１　８□ PIO0_0
-	    PIO0_4 □２　７□ (Vss)
-	     SWCLK □３　６□ (Vdd)
-	     SWDIO □４　５□ CLKIN
-	           └───┘
-***************************************************************************/
-static void SwitchMatrix_Init(void)
-{
-    /* Enable SWM clock */
-    LPC_SYSCON->SYSAHBCLKCTRL |= (1<<7);
-
-    /* Pin Assign 8 bit Configuration */
-    /* none */
-
-    /* Pin Assign 1 bit Configuration */
-    /* SWCLK */
-    /* SWDIO */
-    /* CLKIN */
-    LPC_SWM->PINENABLE0 = 0xffffff73UL; 
+	if (SAMPLE_WDT_CAL) {
+		Wdt_calOsc();		/* WDT用オシレータの較正(Sup_addの前) */
+	}
+	if (SAMPLE_BLINK == 1) {
+		startBlink();		/* LED_BLINKの点滅(レジスタを直接設定) */
+	}
+	else if (SAMPLE_BLINK == 2) {
+		if (Sct_ini(LED_BLINK_PERIOD_MS * 1000)) {	/* LED_BLINKの点滅(クロック変更にも追従) */
+			(void)Sct_setPwm(LED_BLINK_CH, LED_BLINK_HIGH_MS * 1000);
+		}
+	}
+	Iocon_setPin(IN_PIN, IN_CFG);	/* IN_PORTのヒステリシス */
+	SupMain = Sup_add(SUP_MAIN_MS);	/* WDT監視タスクの登録 */
+	if (PROF_ENABLE) {
+		Prof_ini();			/* 処理時間の計測の準備(MRTの開始) */
+		Prof_add(&ProfEvt, "Evt_run");
+	}
+	Evt_addQue(&PintQue);	/* 割り込みからのイベントの登録(割り込み開始前) */
+	Evt_setFunc(EVT_IN_LOW, evtInLow);
+	if (SAMPLE_SYSTICK) {
+		SupTick = Sup_add(SUP_TICK_MS);
+		Evt_addQue(&TickQue);
+		Evt_setFunc(EVT_TICK_SLOW, evtTickSlow);
+		startSysTick();		/* SysTickタイマを開始 */
+		Sys_addClkNotify(startSysTick);	/* クロック変更時はSysTickを再設定 */
+	}
+	InCh = Pint_add(IN_PIN, PINT_LEVEL_LOW, procInLow);	/* IN_PORTのL入力を割り込みで検出 */
+	Idle_ini();				/* 低消費電力待機の準備 */
+	if (Wdt_isFeedable()) {
+		Wdt_clr();			/* ガード時間中(Sys_iniLpc810でWDTを開始した直後)はクリアしない */
+	}
+	if (WDT_LEARN_ENABLE) {
+		Wdt_learnStart(WDT_LEARN_NUM);	/* 以降のWDTクリア間隔を学習 */
+	}
 }
 
 /***************************************************************************
@@ -240,19 +540,90 @@ static void SwitchMatrix_Init(void)
 
 	指定SYSTICK_MS(ms)毎にSysTickタイマを起動させるよう初期化する。
 	本関数呼び出し後にSysTickタイマは動作開始する。
-
-	計算途中の桁あふれを防ぐためにuint64_tを使用している。
+	Sys_setClockでクロックが切り替わった時にも呼び出され、新しいシステム
+	クロックで周期を設定し直す。
+
+	ただし、割り込み処理時間(実測の最大値)が割り込み間隔のSYSTICK_LOAD_PCT
+	(%)を超えてしまう場合は、それに収まるまで間隔を延ばす。
+	遅いシステムクロックでは、割り込み処理だけで定常側(main)が動かなくなっ
+	てしまうため(SysTick_Handler参照)。
+	割り込み処理時間はクロック数で数えているので、システムクロックが変わっ
+	ても実測値をそのまま使える。
+	ただし、周期の2^SUP_TICK_SFT(4)倍がWWDT_TIM_OUTを超えるところまでは
+	延ばさない(負荷の上限よりWDTの満了を避けることを優先する)。
+	周期を変えたら負荷の計測値(getTickLoad)はクリアする。
+	SysTick割り込みの監視の期限(SUP_TICK_MS)も、周期の2^SUP_TICK_SFT倍
+	以上になるようSUP_TICK_MS単位で延ばす(Sup_setMs)。
+
+	tick数への換算はSys_msToTicks()で行い、除算を使わないようにしている。
 	なお、コアライブラリ(SysTick_Config)内で割り込みレベルは3で初期化されて
 	いる。
+	SysTick_ConfigはLOADにtick数－1を設定するので、割り込み間隔(クロック
+	数)はLOAD＋1として記録する(経過クロック数は間隔－(VAL＋1)になる)。
 ***************************************************************************/
 static void startSysTick(void)
 {
-	enum {
-		SYSTICK_MS = 250	/* ms; SysTick割り込みの起動間隔 */
-	};
-	uint64_t ticks = (uint64_t)Sys_getSysClk() * SYSTICK_MS / 1000;
+	uint32_t	ticks = Sys_msToTicks(SYSTICK_MS);
+	uint32_t	min = TickLoad.isrMax * SYSTICK_LOAD_MUL;
+	uint32_t	max = Sys_msToTicks(WWDT_TIM_OUT >> SUP_TICK_SFT);
+	uint32_t	ms;
 
+	if (min > max) {
+		min = max;				/* 監視の期限(周期の4倍)をWDTタイムアウト以下にする */
+	}
+	if (ticks < min) {
+		ticks = min;			/* 割り込み負荷を上限以下にする */
+	}
+	if (ticks > SYSTICK_MAX) {
+		ticks = SYSTICK_MAX;
+	}
+	TickLoad.cnt = 0;
+	TickLoad.isrCyc = 0;
 	SysTick_Config(ticks);
+	TickLoad.period = SysTick->LOAD + 1;
+
+	for (ms = SUP_TICK_MS; Sys_msToTicks(ms >> SUP_TICK_SFT) < TickLoad.period; ms += SUP_TICK_MS) {
+		/* 周期の4倍以上になるまで延ばす */
+	}
+	Sup_setMs(SupTick, ms);
+}
+
+/***************************************************************************
+	getTickLoad
+	SysTick割り込みの負荷の取得
+
+	[引数]	なし
+	[戻値]	割り込み間隔に対する割り込み処理時間の平均の割合(0.1%単位)
+			まだ割り込みが発生していなければ0
+
+	デバッガなどから確認するためのもので、除算を使っている。
+	そのためstaticにはしていない。
+	合計を回数で割ってから割合にすると切り捨てが大きいので、合計×1000
+	を回数×間隔で割る。回数×間隔はSYSTICK_LOAD_WIN×SYSTICK_MAX(2^31)
+	までなので、合計×1000が32ビットに収まるよう、両方を同じだけ右シフト
+	してから割る(64ビット除算を使わないため)。
+***************************************************************************/
+uint32_t getTickLoad(void)
+{
+	uint32_t	primask;
+	uint32_t	cnt, cyc, period;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	cnt = TickLoad.cnt;
+	cyc = TickLoad.isrCyc;
+	period = TickLoad.period;
+	__set_PRIMASK(primask);
+
+	if ((cnt == 0) || (period == 0)) {
+		return 0;
+	}
+	period *= cnt;
+	while (cyc > UINT32_MAX / 1000) {
+		cyc >>= 1;
+		period >>= 1;
+	}
+	return (period != 0)? cyc * 1000 / period: 0;
 }
 
 /***************************************************************************
@@ -262,15 +633,53 @@ static void startSysTick(void)
 	[引数]	なし
 	[戻値]	なし
 
-	startSysTickで定義したSYSTICK_MS(ms)毎に起動する。
+	startSysTickで決めた間隔(通常はSYSTICK_MS(ms))毎に起動する。
+	LEDの点滅はSCTが行うので、割り込み内ではSysTickの生存報告と負荷の計
+	測だけを行う。
+
+	最後に、リロードからの経過クロック数(割り込み応答時間を含む処理時間)
+	をSysTickのカウンタ値から求めて、負荷の計測値に加える。
+	回数がSYSTICK_LOAD_WINに達したら合計と回数を半分にするので、平均は
+	直近の割り込みほど重く、合計と回数が桁あふれすることはない(1回の処理
+	時間は間隔(SYSTICK_MAX以下)を超えないので、合計は2^31未満)。
+	最大値がSYSTICK_LOAD_PCTを超えたら、main()にstartSysTickでの再設定を
+	依頼する(EVT_TICK_SLOW)。
+
+	SRAMに配置する(RAMFUNC)。core.hのRAMFUNC_ENABLEを0と1で切り替えて
+	TickLoad.isrMax(割り込み応答から計測までのクロック数)を比べれば、フ
+	ラッシュとSRAMでの実行時間の差が分かる。Sup_chk, Evt_postはフラッシュ
+	のままなので、その分は差に含まれない。
+
+	core.hのSAMPLE_SYSTICKが0の場合は呼び出されないが、ベクタテーブルから
+	参照されるので、処理がリンクされないよう何もせずに戻る。
 ***************************************************************************/
-void SysTick_Handler(void)
+RAMFUNC void SysTick_Handler(void)
 {
-	setPort(LED_SYSTICK, GPIO_TOGGLE);
+	uint32_t	cyc;
+
+	if (!SAMPLE_SYSTICK) {
+		return;
+	}
+	Sup_chk(SupTick);
+
+	/* 負荷の計測(LOADから0へのダウンカウンタなので、LOAD－現在値が経過クロック数) */
+	cyc = TickLoad.period - (SysTick->VAL + 1);
+	if (TickLoad.cnt >= SYSTICK_LOAD_WIN) {
+		TickLoad.cnt >>= 1;
+		TickLoad.isrCyc >>= 1;
+	}
+	TickLoad.cnt++;
+	TickLoad.isrCyc += cyc;
+	if (cyc > TickLoad.isrMax) {
+		TickLoad.isrMax = cyc;
+		if (cyc * SYSTICK_LOAD_MUL > TickLoad.period) {
+			Evt_post(&TickQue, EVT_TICK_SLOW, 0);
+		}
+	}
 	/***
 		一応念のためにコメントしておくが、システムクロックを一番遅い9.375kHz
 		にした場合、1クロックが0.1msぐらいにしかならないため、上記のような
-		単純なGPIO出力処理も10ms近くかかってしまう。
+		単純な処理も10ms近くかかってしまう。
 
 		つまり、その場合にSysTick割り込みの間隔(SYSTICK_MS)を10ms以下にして
 		しまうと、割り込み間隔よりも処理時間の方がオーバーしてしまうため、
@@ -282,6 +691,9 @@ void SysTick_Handler(void)
 
 		目安としては、割り込み間隔に対する割り込み処理時間の割合を10%以下に
 		抑えるべきだろう。
+
+		そのため、startSysTickでは実測した処理時間に対して、割り込み間隔が
+		短すぎないように(SYSTICK_LOAD_PCT以下になるように)調整している。
 	***/
 }
 
@@ -298,47 +710,45 @@ void SysTick_Handler(void)
 ***************************************************************************/
 static void iniPort(void)
 {
-	LPC_SYSCON->SYSAHBCLKCTRL |= SYS_AHB_CLK_GPIO;	/* GPIOへクロック供給 */
-	LPC_SYSCON->PRESETCTRL &= ~SYS_GPIO_RST_N;		/* GPIOをリセット～ */
-	LPC_SYSCON->PRESETCTRL |= SYS_GPIO_RST_N;		/* リセット解除 */
+	(void)Sys_acqClk(SYS_AHB_CLK_GPIO, SYS_GPIO_RST_N);	/* GPIOへクロック供給(返さない) */
 
-	setPort(LED_SYSTICK | LED_INFO, GPIO_CLR);		/* ポートクリア */
-	LPC_GPIO_PORT->DIR0 = LED_SYSTICK | LED_INFO;	/* 出力ポート化 */
+	Gpio_clr(LED_INFO);					/* ポートクリア */
+	LPC_GPIO_PORT->DIR0 = LED_INFO;		/* 出力ポート化(LED_BLINKはSCTの出力) */
 }
 
 /***************************************************************************
-	setPort
-	GPIOへの指定出力
-
-	[引数]	pat	変化させたいGPIOのみ1をセット(b0:P0_0～b5:P0_5)
-			act	以下のどれか
-				GPIO_CLR	Low出力
-				GPIO_SET	High出力
-				GPIO_TOGGLE	反転出力
-	[戻値]	なし
+	startBlink
+	LED_BLINKの点滅の開始(SCTのレジスタを直接設定)
 
-	指定のビットパターンでGPIOに対して出力を行う。
-	CLR0, SET0, NOT0レジスタの機能(※)のおかげで、本関数はリエントラント性
-	を保っている。
-	そのため、割り込み側、定常(main)側、同時に本関数を使用できる。
+	[引数]	なし
+	[戻値]	なし
 
-	※UM10601 - Chapter 7:LPC800 GPIO port
+	Sct_ini, Sct_setPwmと同じ波形(MATCH0の周期でH、MATCH1でL)を、レジス
+	タを直接書いて作る(最初の周期だけは消灯のまま)。Sct_libの計画・クロッ
+	ク変更の処理をリンクしないので小さいが、クロックを切り替えると周期が
+	その比でずれる(本サンプルは動作中にクロックを切り替えない)。
+	CTOUT_0のピン(LED_BLINK)はcore.hのSWM_PIN_MAPでSwm_iniが割り当てる。
+	SCTのクロックは返さないので、Idle_runはスリープで待機する。
+	MATCHはリミットの度にMATCHRELから再ロードされるので、両方に書く。
 ***************************************************************************/
-static void setPort(uint32_t pat, Gpio_bit act)
+static void startBlink(void)
 {
-	switch (act) {
-	case GPIO_CLR:
-		LPC_GPIO_PORT->CLR0 = pat;
-		break;
-	case GPIO_SET:
-		LPC_GPIO_PORT->SET0 = pat;
-		break;
-	case GPIO_TOGGLE:
-		LPC_GPIO_PORT->NOT0 = pat;
-		break;
-	default:
-		break;
-	}
+	uint32_t	period = Sys_msToTicks(LED_BLINK_PERIOD_MS) - 1;
+	uint32_t	high = Sys_msToTicks(LED_BLINK_HIGH_MS) - 1;
+
+	(void)Sys_acqClk(SYS_AHB_CLK_SCT, SYS_SCT_RST_N);	/* SCTへクロック供給(返さない) */
+	LPC_SCT->CONFIG = SCT_UNIFY | SCT_CLKMODE_BUS | SCT_AUTOLIMIT_L;
+	LPC_SCT->MATCH[0].U = period;
+	LPC_SCT->MATCHREL[0].U = period;
+	LPC_SCT->MATCH[1].U = high;
+	LPC_SCT->MATCHREL[1].U = high;
+	LPC_SCT->EVENT[0].STATE = SCT_EV_STATE0;
+	LPC_SCT->EVENT[0].CTRL = 0 | SCT_EV_COMB_MATCH;		/* 周期の終わり */
+	LPC_SCT->EVENT[1].STATE = SCT_EV_STATE0;
+	LPC_SCT->EVENT[1].CTRL = 1 | SCT_EV_COMB_MATCH;		/* 点灯時間の終わり */
+	LPC_SCT->OUT[LED_BLINK_CH].SET = 0x1<<0;
+	LPC_SCT->OUT[LED_BLINK_CH].CLR = 0x1<<1;
+	LPC_SCT->CTRL_U = 0;		/* 開始(プリスケーラなし) */
 }
 
 /***************************************************************************
@@ -347,10 +757,70 @@ static void setPort(uint32_t pat, Gpio_bit act)
 
 	[引数]	なし
 	[戻値]	Low(true), High(false)
+
+	IN_PINのバイトレジスタを読むだけで、ポート全体をマスクしない。
 ***************************************************************************/
 static _Bool getGpioIsLow(void)
 {
-	return ((LPC_GPIO_PORT->PIN0 & IN_PORT) == 0)? true: false;
+	return !Gpio_rdPin(IN_PIN);
+}
+
+/***************************************************************************
+	procInLow
+	IN_PORTのL入力検出時の処理
+
+	[引数]	ch		ピン割り込みのチャネル番号
+			rise	検出レベル(Lレベル検出なのでfalse)
+	[戻値]	なし
+
+	本関数はピン割り込み内から呼び出される。
+	Lレベル検出は1回で停止するので、main()(evtInLow)で入力がHに戻って
+	から再開する。
+***************************************************************************/
+static void procInLow(uint32_t ch, _Bool rise)
+{
+	Evt_post(&PintQue, EVT_IN_LOW, ch);
+}
+
+/***************************************************************************
+	イベント処理関数(Evt_runからmain側で呼び出される)
+***************************************************************************/
+
+/***************************************************************************
+	evtTickSlow
+	SysTick割り込みの負荷が上限を超えた時の処理
+
+	[引数]	arg	未使用
+	[戻値]	なし
+
+	計測した最大処理時間を元に、SysTick割り込みの周期を延ばす。
+	WDTクリアの間隔も延びるので、WDTのタイムアウトとガード時間を元に戻し
+	て学習し直す。
+***************************************************************************/
+static void evtTickSlow(uint32_t arg)
+{
+	startSysTick();
+	if (WDT_LEARN_ENABLE) {
+		Wdt_learnStart(WDT_LEARN_NUM);
+	}
+}
+
+/***************************************************************************
+	evtInLow
+	IN_PORTのL入力検出時の処理
+
+	[引数]	arg	ピン割り込みのチャネル番号
+	[戻値]	なし
+
+	入力がHに戻るまでmain()を止めてロックアップさせる(WDTの動作確認用)。
+***************************************************************************/
+static void evtInLow(uint32_t arg)
+{
+	Gpio_clr(LED_INFO);
+	while (getGpioIsLow()) {
+		;
+	}
+	Pint_start(arg);	/* Lレベル検出の再開 */
 }
 
 /***************************************************************************
@@ -365,8 +835,10 @@ static _Bool getGpioIsLow(void)
 	[戻値]	なし
 
 	本関数はウォッチドッグタイマ警告割り込み内から呼び出される。
+	main()が止まっている時にこそ警告が出るので、Evt_libのイベントにはせず
+	割り込み内で直接LEDを点灯する。
 ***************************************************************************/
 void Wdt_procWarn(void)
 {
-	setPort(LED_INFO, GPIO_SET);
+	Gpio_set(LED_INFO);
 }